@@ -0,0 +1,154 @@
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+#include <fmt.hpp>
+#include <utils/adc_quiet.hpp>
+#include <utils/adc_scanner.hpp>
+#include <utils/cycle_counter.hpp>
+#include <utils/uart_tx.hpp>
+
+// ADC acquisition cost on the simulated ATmega328P at 16 MHz: the free-running interrupt path drained by a
+// busy-wait loop (the firmware default) against conversions in ADC Noise Reduction sleep mode
+// (core::adc::quiet_scanner), single channel so neither path pays settling conversions.
+//
+// simavr keeps Timer1 counting while the CPU sleeps, so the cycle counter gives wall time here (on a real
+// board it stops with the I/O clock). Awake cycles of the sleeping path are the wall time minus the time from
+// the start of a conversion to the ADC interrupt, a lower bound by the few cycles of the sleep entry and the
+// ISR prologue. Prints a CSV report and makes simavr exit. Use `make adc-sleep-simavr`.
+
+namespace {
+
+struct result {
+    uint32_t wall; //< Cycles from the first to the last sample
+    uint32_t awake; //< Cycles the CPU executed instructions
+    uint16_t samples;
+    uint16_t early_wakes;
+};
+
+constexpr core::adc::channel_config CHANNELS[] = { { 0, 1 } };
+constexpr uint16_t SAMPLES = 512;
+
+core::adc::scanner<32, 1> busy_scanner(CHANNELS);
+core::adc::quiet_scanner<32, 1> quiet_scanner(CHANNELS);
+core::uart::transmitter<128, 16> uart_tx;
+
+volatile bool quiet; //< Scanner the ADC interrupt is forwarded to
+volatile core::cycles::count woke; //< Cycle count at the last ADC interrupt
+volatile uint16_t sink_u16;
+
+result run_busy_wait()
+{
+    quiet = false;
+    busy_scanner.start();
+    core::adc::tagged_sample sample;
+    while (!busy_scanner.pop(sample)) { } // settling conversion and first sample
+
+    result figures {};
+    core::cycles::count last = core::cycles::now();
+    while (figures.samples < SAMPLES) {
+        const core::cycles::count now = core::cycles::now();
+        figures.wall += static_cast<core::cycles::count>(now - last);
+        last = now;
+        if (busy_scanner.pop(sample)) {
+            sink_u16 = sample.bits;
+            ++figures.samples;
+        }
+    }
+    busy_scanner.stop();
+    figures.awake = figures.wall;
+    return figures;
+}
+
+result run_noise_reduction()
+{
+    quiet = true;
+    quiet_scanner.start();
+    core::adc::tagged_sample sample;
+    quiet_scanner.acquire(1); // settling conversion and first sample
+    quiet_scanner.pop(sample);
+
+    result figures {};
+    core::cycles::count last = core::cycles::now();
+    while (figures.samples < SAMPLES) {
+        const core::cycles::count started = core::cycles::now();
+        quiet_scanner.acquire(1);
+        const core::cycles::count asleep = static_cast<core::cycles::count>(woke - started);
+        if (quiet_scanner.pop(sample)) {
+            sink_u16 = sample.bits;
+            ++figures.samples;
+        }
+        const core::cycles::count now = core::cycles::now();
+        const core::cycles::count elapsed = static_cast<core::cycles::count>(now - last);
+        figures.wall += elapsed;
+        figures.awake += static_cast<core::cycles::count>(elapsed - asleep);
+        last = now;
+    }
+    quiet_scanner.stop();
+    figures.early_wakes = quiet_scanner.early_wakes();
+    return figures;
+}
+
+void print(const char* name, const result& figures)
+{
+    char line[64];
+    core::fmt::writer out(line);
+    const uint32_t per_sample = figures.wall / figures.samples;
+    out.append(name)
+        .append(',')
+        .append_uint(figures.samples)
+        .append(',')
+        .append_uint(figures.wall)
+        .append(',')
+        .append_uint(per_sample != 0 ? F_CPU / per_sample : 0)
+        .append(',')
+        .append_uint(figures.awake / figures.samples)
+        .append(',')
+        .append_uint(figures.early_wakes)
+        .append("\r\n");
+    while (!uart_tx.write(out.written().data(), out.size())) { }
+}
+
+} // namespace
+
+ISR(ADC_vect)
+{
+    woke = core::cycles::now();
+    if (quiet) {
+        quiet_scanner.on_conversion();
+    } else {
+        busy_scanner.on_conversion();
+    }
+}
+
+ISR(USART_UDRE_vect)
+{
+    uart_tx.on_data_register_empty();
+}
+
+void setup()
+{
+    // No millis() tick waking the CPU or skewing the cycle counts
+    TIMSK0 &= ~_BV(TOIE0);
+
+    uart_tx.begin(9600);
+    core::cycles::start();
+
+    const result busy = run_busy_wait();
+    const result sleeping = run_noise_reduction();
+
+    constexpr char header[] = "acquisition,samples,wall_cycles,rate_sps,awake_cycles_per_sample,early_wakes\r\n";
+    uart_tx.write(header, sizeof(header) - 1);
+    print("busy_wait", busy);
+    print("noise_reduction", sleeping);
+    uart_tx.flush();
+
+    // Sleeping with interrupts disabled makes simavr exit
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include <fmt.hpp>
+#include <utils/adc.hpp>
+
+#include <cstdint>
+#include <cstdio>
+
+// Conversion and formatting of one sample, swept over all 10-bit codes
+
+static void BM_RawToMvFloat(benchmark::State& state)
+{
+    uint16_t raw = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::adc::raw_to_mv(raw));
+        raw = (raw + 1) & 0x3FF;
+    }
+}
+BENCHMARK(BM_RawToMvFloat);
+
+static void BM_RawToMvInt(benchmark::State& state)
+{
+    uint16_t raw = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::adc::raw_to_mv_int(raw));
+        raw = (raw + 1) & 0x3FF;
+    }
+}
+BENCHMARK(BM_RawToMvInt);
+
+static void BM_RawToMvDivision(benchmark::State& state)
+{
+    uint16_t raw = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::adc::default_converter::to_mv_exact(raw));
+        raw = (raw + 1) & 0x3FF;
+    }
+}
+BENCHMARK(BM_RawToMvDivision);
+
+static void BM_ToString(benchmark::State& state)
+{
+    char buffer[16];
+    uint16_t raw = 0;
+    for (auto _ : state) {
+        const auto text = core::adc::to_string(raw, buffer);
+        benchmark::DoNotOptimize(text.data());
+        benchmark::ClobberMemory();
+        raw = (raw + 1) & 0x3FF;
+    }
+}
+BENCHMARK(BM_ToString);
+
+/// Baseline: the snprintf formatting to_string() used before core::fmt
+static void BM_SnprintfBaseline(benchmark::State& state)
+{
+    char buffer[16];
+    uint16_t raw = 0;
+    for (auto _ : state) {
+        const auto mv = static_cast<uint16_t>(core::adc::raw_to_mv(raw));
+        benchmark::DoNotOptimize(snprintf(buffer, sizeof(buffer), "%u, %u", raw, mv));
+        benchmark::ClobberMemory();
+        raw = (raw + 1) & 0x3FF;
+    }
+}
+BENCHMARK(BM_SnprintfBaseline);
+
+static void BM_FmtAppendUint(benchmark::State& state)
+{
+    char buffer[16];
+    uint32_t value = static_cast<uint32_t>(state.range(0));
+    for (auto _ : state) {
+        core::fmt::writer out(buffer);
+        out.append_uint(value);
+        benchmark::DoNotOptimize(out.size());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_FmtAppendUint)->Arg(7)->Arg(1023)->Arg(65535)->Arg(4000000000);
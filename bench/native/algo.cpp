@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+
+#include <algo.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// core::algo host kernels against the same scalar loops with auto-vectorization disabled. The ratio of
+// items_per_second is the vectorization gain; inspect with -fopt-info-vec-optimized (GCC) or
+// -Rpass=loop-vectorize (Clang).
+
+#if defined(__clang__)
+#define BENCH_SCALAR_LOOP _Pragma("clang loop vectorize(disable) interleave(disable)")
+#define BENCH_SCALAR
+#elif defined(__GNUC__)
+#define BENCH_SCALAR_LOOP
+#define BENCH_SCALAR __attribute__((optimize("no-tree-vectorize")))
+#else
+#define BENCH_SCALAR_LOOP
+#define BENCH_SCALAR
+#endif
+
+namespace {
+
+std::vector<uint16_t> make_samples(size_t size)
+{
+    std::vector<uint16_t> samples(size);
+    uint32_t state = 12345;
+    for (auto& sample : samples) {
+        state = state * 1103515245U + 12345U;
+        sample = static_cast<uint16_t>((state >> 16) & 0x3FF);
+    }
+    return samples;
+}
+
+BENCH_SCALAR uint32_t scalar_sum(const uint16_t* data, size_t size)
+{
+    uint32_t total = 0;
+    BENCH_SCALAR_LOOP
+    for (size_t i = 0; i < size; ++i) {
+        total += data[i];
+    }
+    return total;
+}
+
+BENCH_SCALAR core::algo::minmax_result<uint16_t> scalar_minmax(const uint16_t* data, size_t size)
+{
+    core::algo::minmax_result<uint16_t> result { data[0], data[0] };
+    BENCH_SCALAR_LOOP
+    for (size_t i = 0; i < size; ++i) {
+        result.min = data[i] < result.min ? data[i] : result.min;
+        result.max = data[i] > result.max ? data[i] : result.max;
+    }
+    return result;
+}
+
+} // namespace
+
+static void BM_AlgoSum(benchmark::State& state)
+{
+    const auto samples = make_samples(state.range(0));
+    const core::span<const uint16_t> view(samples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        benchmark::DoNotOptimize(core::algo::sum(view));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AlgoSum)->Arg(256)->Arg(4096);
+
+static void BM_ScalarSum(benchmark::State& state)
+{
+    const auto samples = make_samples(state.range(0));
+    const uint16_t* data = samples.data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data);
+        benchmark::DoNotOptimize(scalar_sum(data, samples.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarSum)->Arg(256)->Arg(4096);
+
+static void BM_AlgoMinMax(benchmark::State& state)
+{
+    const auto samples = make_samples(state.range(0));
+    const core::span<const uint16_t> view(samples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        benchmark::DoNotOptimize(core::algo::minmax(view));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AlgoMinMax)->Arg(256)->Arg(4096);
+
+static void BM_ScalarMinMax(benchmark::State& state)
+{
+    const auto samples = make_samples(state.range(0));
+    const uint16_t* data = samples.data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data);
+        benchmark::DoNotOptimize(scalar_minmax(data, samples.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarMinMax)->Arg(256)->Arg(4096);
+
+static void BM_AlgoMean(benchmark::State& state)
+{
+    const auto samples = make_samples(state.range(0));
+    const core::span<const uint16_t> view(samples);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        benchmark::DoNotOptimize(core::algo::mean(view));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AlgoMean)->Arg(4096);
+
+static void BM_AlgoCopy(benchmark::State& state)
+{
+    const auto samples = make_samples(state.range(0));
+    std::vector<uint16_t> out(samples.size());
+    for (auto _ : state) {
+        core::algo::copy(core::span<const uint16_t>(samples), core::span<uint16_t>(out));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AlgoCopy)->Arg(4096);
+
+static void BM_AlgoFill(benchmark::State& state)
+{
+    std::vector<uint16_t> out(state.range(0));
+    for (auto _ : state) {
+        core::algo::fill(core::span<uint16_t>(out), 512);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AlgoFill)->Arg(4096);
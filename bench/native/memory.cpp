@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+
+#include <arena.hpp>
+#include <pool.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+
+// Heap-free allocators against malloc/free for the same request pattern
+
+static void BM_MallocFree(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        void* block = std::malloc(size);
+        benchmark::DoNotOptimize(block);
+        std::free(block);
+    }
+}
+BENCHMARK(BM_MallocFree)->Arg(32)->Arg(64);
+
+static void BM_ArenaScopedAllocate(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    core::static_arena<256> arena {};
+    for (auto _ : state) {
+        const auto scope = arena.make_scope();
+        auto block = arena.allocate<uint8_t>(size);
+        benchmark::DoNotOptimize(block.data());
+    }
+}
+BENCHMARK(BM_ArenaScopedAllocate)->Arg(32)->Arg(64);
+
+static void BM_PoolAllocateFree(benchmark::State& state)
+{
+    core::pool<uint16_t[32], 8> pool {};
+    for (auto _ : state) {
+        auto block = pool.allocate();
+        benchmark::DoNotOptimize(block.data());
+        pool.free(block);
+    }
+}
+BENCHMARK(BM_PoolAllocateFree);
+
+// Interleaved lifetimes: four blocks in flight, the oldest one is released on every step
+
+static void BM_MallocInterleaved(benchmark::State& state)
+{
+    void* blocks[4] {};
+    size_t next = 0;
+    for (auto _ : state) {
+        std::free(blocks[next]);
+        blocks[next] = std::malloc(64);
+        benchmark::DoNotOptimize(blocks[next]);
+        next = (next + 1) & 3;
+    }
+    for (auto* block : blocks) {
+        std::free(block);
+    }
+}
+BENCHMARK(BM_MallocInterleaved);
+
+static void BM_PoolInterleaved(benchmark::State& state)
+{
+    core::pool<uint16_t[32], 4> pool {};
+    core::span<uint16_t> blocks[4] {};
+    size_t next = 0;
+    for (auto _ : state) {
+        pool.free(blocks[next]);
+        blocks[next] = pool.allocate();
+        benchmark::DoNotOptimize(blocks[next].data());
+        next = (next + 1) & 3;
+    }
+}
+BENCHMARK(BM_PoolInterleaved);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <delta.hpp>
+#include <frame.hpp>
+#include <packed.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Storage and wire density of 10-bit samples: bytes_per_sample is the figure of merit, time the cost
+
+namespace {
+
+/// Slowly varying 10-bit signal, a few LSB per step
+std::vector<uint16_t> make_signal(size_t size)
+{
+    std::vector<uint16_t> signal(size);
+    for (size_t i = 0; i < size; ++i) {
+        const size_t phase = i % 128;
+        signal[i] = static_cast<uint16_t>(300 + 4 * (phase < 64 ? phase : 128 - phase));
+    }
+    return signal;
+}
+
+} // namespace
+
+static void BM_PackedPack10(benchmark::State& state)
+{
+    const auto signal = make_signal(256);
+    core::packed_array<10, 256> block {};
+    for (auto _ : state) {
+        core::pack(signal, block.view());
+        benchmark::DoNotOptimize(block.bytes().data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+    state.counters["bytes_per_sample"] = static_cast<double>(block.bytes().size()) / 256;
+}
+BENCHMARK(BM_PackedPack10);
+
+static void BM_PackedUnpack10(benchmark::State& state)
+{
+    const auto signal = make_signal(256);
+    core::packed_array<10, 256> block {};
+    core::pack(signal, block.view());
+    uint16_t out[256];
+    for (auto _ : state) {
+        core::unpack(block.view(), core::span<uint16_t>(out));
+        benchmark::DoNotOptimize(out);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_PackedUnpack10);
+
+static void BM_DeltaEncode(benchmark::State& state)
+{
+    const auto signal = make_signal(256);
+    uint8_t out[core::delta::max_encoded_size(256)];
+    size_t size = 0;
+    for (auto _ : state) {
+        size = core::delta::encode(signal, out).size();
+        benchmark::DoNotOptimize(size);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+    state.counters["bytes_per_sample"] = static_cast<double>(size) / 256;
+}
+BENCHMARK(BM_DeltaEncode);
+
+static void BM_DeltaDecode(benchmark::State& state)
+{
+    const auto signal = make_signal(256);
+    uint8_t bytes[core::delta::max_encoded_size(256)];
+    const auto encoded = core::delta::encode(signal, bytes);
+    uint16_t out[256];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(core::delta::decode(encoded, out).size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_DeltaDecode);
+
+/// Whole frames per payload encoding: 0 raw16, 1 packed10, 2 delta
+static void BM_FrameEncodeFormat(benchmark::State& state)
+{
+    const auto format = static_cast<core::frame::encoding>(state.range(0));
+    const auto signal = make_signal(16);
+    uint8_t wire[core::frame::max_frame_size(16, core::frame::encoding::delta)];
+    size_t size = 0;
+    for (auto _ : state) {
+        size = core::frame::encode(0, 0, signal, wire, format).size();
+        benchmark::DoNotOptimize(size);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 16);
+    state.counters["bytes_per_sample"] = static_cast<double>(size) / 16;
+}
+BENCHMARK(BM_FrameEncodeFormat)->Arg(0)->Arg(1)->Arg(2);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <frame.hpp>
+#include <ring_buffer.hpp>
+
+#include <cstdint>
+
+// Buffering and framing stages between the ADC ISR and the UART
+
+static void BM_RingBufferPushPop(benchmark::State& state)
+{
+    core::ring_buffer<uint16_t, 64> buffer {};
+    uint16_t value = 0;
+    for (auto _ : state) {
+        buffer.push(value++);
+        uint16_t out = 0;
+        buffer.pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_RingBufferPushPop);
+
+static void BM_RingBufferBatch(benchmark::State& state)
+{
+    core::ring_buffer<uint16_t, 64> buffer {};
+    for (auto _ : state) {
+        auto region = buffer.write_reserve();
+        for (auto& slot : region) {
+            slot = 512;
+        }
+        buffer.write_commit(static_cast<uint8_t>(region.size()));
+
+        uint32_t sum = 0;
+        auto readable = buffer.read_reserve();
+        for (const auto value : readable) {
+            sum += value;
+        }
+        buffer.read_commit(static_cast<uint8_t>(readable.size()));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_RingBufferBatch);
+
+static void BM_FrameEncode(benchmark::State& state)
+{
+    uint16_t samples[16];
+    for (uint16_t i = 0; i < 16; ++i) {
+        samples[i] = static_cast<uint16_t>(i * 64);
+    }
+    uint8_t wire[core::frame::max_frame_size(16)];
+    uint8_t sequence = 0;
+    for (auto _ : state) {
+        const auto frame = core::frame::encode(sequence++, 0, samples, wire);
+        benchmark::DoNotOptimize(frame.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 16);
+}
+BENCHMARK(BM_FrameEncode);
+
+static void BM_FrameDecode(benchmark::State& state)
+{
+    uint16_t samples[16] {};
+    uint8_t wire[core::frame::max_frame_size(16)];
+    const auto frame = core::frame::encode(0, 0, samples, wire);
+
+    core::frame::decoder<16> decoder {};
+    for (auto _ : state) {
+        for (const auto byte : frame) {
+            benchmark::DoNotOptimize(decoder.feed(byte));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 16);
+}
+BENCHMARK(BM_FrameDecode);
@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include <span.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#define BENCH_HAS_STD_SPAN 1
+#endif
+
+// Every variant sums the same block, the "zero-overhead" claim holds if they all report the same time
+
+namespace {
+
+std::vector<uint16_t> make_block(size_t size)
+{
+    std::vector<uint16_t> block(size);
+    std::iota(block.begin(), block.end(), uint16_t { 0 });
+    return block;
+}
+
+} // namespace
+
+static void BM_RawPointerIndex(benchmark::State& state)
+{
+    const auto block = make_block(state.range(0));
+    const uint16_t* data = block.data();
+    const size_t size = block.size();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < size; ++i) {
+            sum += data[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RawPointerIndex)->Arg(64)->Arg(1024);
+
+static void BM_SpanIndex(benchmark::State& state)
+{
+    const auto block = make_block(state.range(0));
+    core::span<const uint16_t> view(block.data(), block.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < view.size(); ++i) {
+            sum += view[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpanIndex)->Arg(64)->Arg(1024);
+
+static void BM_SpanRangeFor(benchmark::State& state)
+{
+    const auto block = make_block(state.range(0));
+    core::span<const uint16_t> view(block.data(), block.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        uint32_t sum = 0;
+        for (const auto value : view) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpanRangeFor)->Arg(64)->Arg(1024);
+
+/// Fixed 64-sample block: compile-time trip count
+static void BM_StaticSpanIndex(benchmark::State& state)
+{
+    const auto block = make_block(64);
+    core::span<const uint16_t, 64> view(block.data(), 64);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < view.size(); ++i) {
+            sum += view[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_StaticSpanIndex);
+
+#ifdef BENCH_HAS_STD_SPAN
+static void BM_StdSpanIndex(benchmark::State& state)
+{
+    const auto block = make_block(state.range(0));
+    std::span<const uint16_t> view(block.data(), block.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        uint32_t sum = 0;
+        for (size_t i = 0; i < view.size(); ++i) {
+            sum += view[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdSpanIndex)->Arg(64)->Arg(1024);
+#endif
+
+// Subviews: pointer arithmetic only, compared to building the same view by hand
+
+static void BM_RawPointerSubview(benchmark::State& state)
+{
+    const auto block = make_block(64);
+    const uint16_t* data = block.data();
+    size_t size = block.size();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data);
+        benchmark::DoNotOptimize(size);
+        const uint16_t* sub = data + 8;
+        size_t sub_size = size - 16;
+        benchmark::DoNotOptimize(sub);
+        benchmark::DoNotOptimize(sub_size);
+    }
+}
+BENCHMARK(BM_RawPointerSubview);
+
+static void BM_SpanFirstLastSubspan(benchmark::State& state)
+{
+    const auto block = make_block(64);
+    core::span<const uint16_t> view(block.data(), block.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        auto head = view.first(8);
+        auto tail = view.last(8);
+        auto middle = view.subspan(8, view.size() - 16);
+        benchmark::DoNotOptimize(head);
+        benchmark::DoNotOptimize(tail);
+        benchmark::DoNotOptimize(middle);
+    }
+}
+BENCHMARK(BM_SpanFirstLastSubspan);
+
+#ifdef BENCH_HAS_STD_SPAN
+static void BM_StdSpanFirstLastSubspan(benchmark::State& state)
+{
+    const auto block = make_block(64);
+    std::span<const uint16_t> view(block.data(), block.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view);
+        auto head = view.first(8);
+        auto tail = view.last(8);
+        auto middle = view.subspan(8, view.size() - 16);
+        benchmark::DoNotOptimize(head);
+        benchmark::DoNotOptimize(tail);
+        benchmark::DoNotOptimize(middle);
+    }
+}
+BENCHMARK(BM_StdSpanFirstLastSubspan);
+#endif
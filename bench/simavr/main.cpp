@@ -0,0 +1,262 @@
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+#include "firmware_config.hpp"
+
+#include <fmt.hpp>
+#include <frame.hpp>
+#include <progmem.hpp>
+#include <utils/adc.hpp>
+#include <utils/adc_scanner.hpp>
+#include <utils/output.hpp>
+#include <utils/profiler.hpp>
+#include <utils/thermistor.hpp>
+#include <utils/uart_link.hpp>
+#include <utils/uart_tx.hpp>
+
+#include <math.h>
+#include <stdio.h>
+
+// Cycle profile of the firmware hot paths on the simulated ATmega328P at 16 MHz.
+// Runs every stage on synthetic 10-bit codes, prints a CSV report and makes simavr exit.
+//
+// The pipeline pass runs the interrupt-driven acquisition and output stage of the firmware with its
+// configuration (include/firmware_config.hpp); the ADC Noise Reduction scanner is profiled by bench/adc_sleep.
+
+namespace {
+
+enum region : uint8_t {
+    ADC_ISR,
+    SAMPLE_POP,
+    RAW_TO_MV_FLOAT,
+    RAW_TO_MV_INT,
+    NTC_FLOAT,
+    NTC_TABLE,
+    FORMAT_CSV,
+    FORMAT_SNPRINTF,
+    FRAME_ENCODE,
+    UART_WRITE,
+    LOOP_OUTPUT,
+    REGION_COUNT,
+};
+
+const char* const region_names[REGION_COUNT] = {
+    "adc_isr",
+    "sample_pop",
+    "raw_to_mv_float",
+    "raw_to_mv_int",
+    "ntc_float",
+    "ntc_table",
+    "format_csv",
+    "format_snprintf",
+    "frame_encode",
+    "uart_write",
+    "loop_output",
+};
+
+constexpr uint16_t ITERATIONS = 1000;
+
+/// The link is drained between measurements only, a fast one keeps the bench short
+constexpr core::uart::link_setting BENCH_LINK = core::uart::link_config<F_CPU, 500000>::setting;
+
+core::prof::profiler<REGION_COUNT> profiler(region_names);
+core::adc::scanner<SAMPLE_BUFFER_SLOTS, SENSOR_CHANNEL_COUNT> adc_scanner(SENSOR_CHANNELS);
+core::uart::transmitter<UART_QUEUE_BYTES, UART_QUEUE_RECORDS> uart_tx;
+core::output::stage<OUTPUT_MODE, FRAME_MAX_SAMPLES, FRAME_ENCODING> output;
+
+// 10k NTC (beta 3950) under a 10k series resistor, 33-point table in flash
+using ntc = core::thermistor::divider<10000, 10000, 3950>;
+constexpr auto ntc_table CORE_PROGMEM = ntc::make_table();
+
+volatile uint16_t sink_u16;
+volatile int16_t sink_i16;
+volatile float sink_float;
+
+/// Beta equation with libm, what the table replaces
+float ntc_celsius_float(uint16_t raw)
+{
+    const float ohm = 10000.0f * raw / (1023.0f - raw);
+    return 1.0f / (1.0f / 298.15f + logf(ohm / 10000.0f) / 3950.0f) - 273.15f;
+}
+
+void run_conversions()
+{
+    for (uint16_t i = 0; i < ITERATIONS; ++i) {
+        const uint16_t raw = i & 0x3FF;
+        {
+            const auto scope = profiler.measure(RAW_TO_MV_FLOAT);
+            sink_float = core::adc::raw_to_mv(raw);
+        }
+        {
+            const auto scope = profiler.measure(RAW_TO_MV_INT);
+            sink_u16 = core::adc::raw_to_mv_int(raw);
+        }
+    }
+
+    const core::progmem_span table(ntc_table);
+    for (uint16_t i = 0; i < ITERATIONS; ++i) {
+        const uint16_t raw = 64 + (i & 0x1FF);
+        {
+            const auto scope = profiler.measure(NTC_FLOAT);
+            sink_float = ntc_celsius_float(raw);
+        }
+        {
+            const auto scope = profiler.measure(NTC_TABLE);
+            sink_i16 = ntc::centi_celsius(table, raw);
+        }
+    }
+}
+
+void run_formatting()
+{
+    char line[16];
+    for (uint16_t i = 0; i < ITERATIONS; ++i) {
+        const uint16_t raw = i & 0x3FF;
+        {
+            const auto scope = profiler.measure(FORMAT_CSV);
+            core::fmt::writer out(line);
+            core::adc::format(out, raw).append("\r\n");
+            sink_u16 = out.size();
+        }
+        {
+            const auto scope = profiler.measure(FORMAT_SNPRINTF);
+            sink_u16 = snprintf(line, sizeof(line), "%u, %u\r\n", raw, static_cast<uint16_t>(core::adc::raw_to_mv(raw)));
+        }
+    }
+}
+
+void run_framing()
+{
+    uint16_t samples[16];
+    uint8_t wire[core::frame::max_frame_size(16)];
+    for (uint16_t i = 0; i < ITERATIONS / 16; ++i) {
+        for (uint8_t j = 0; j < 16; ++j) {
+            samples[j] = (i * 16 + j) & 0x3FF;
+        }
+        const auto scope = profiler.measure(FRAME_ENCODE);
+        sink_u16 = core::frame::encode(static_cast<uint8_t>(i), 0, samples, wire).size();
+    }
+}
+
+/// @brief Send everything queued. Only called between measurements: the UDRE interrupt never lands in a
+/// region and every timed write finds room in the queue.
+void drain()
+{
+    sei();
+    uart_tx.flush();
+    cli();
+}
+
+/// Scanner as seen by the output stage, with the sample reads timed
+struct timed_source {
+    bool pop(core::adc::tagged_sample& sample)
+    {
+        const auto scope = profiler.measure(SAMPLE_POP);
+        return adc_scanner.pop(sample);
+    }
+
+    core::span<core::adc::tagged_sample> peek()
+    {
+        const auto scope = profiler.measure(SAMPLE_POP);
+        return adc_scanner.peek();
+    }
+
+    void release(uint8_t count) { adc_scanner.release(count); }
+};
+
+/// Transmitter as seen by the output stage, with the writes timed on an empty queue
+struct timed_sink {
+    bool write(core::span<const uint8_t> record)
+    {
+        drain();
+        const auto scope = profiler.measure(UART_WRITE);
+        return uart_tx.write(record);
+    }
+
+    bool write(const char* text, size_t size)
+    {
+        return write(core::span<const uint8_t>(reinterpret_cast<const uint8_t*>(text), size));
+    }
+};
+
+void run_pipeline()
+{
+    // The ADC interrupt is left disabled so the handler can be timed in place, and no interrupt runs while a
+    // region is measured
+    cli();
+    for (uint16_t i = 0; i < ITERATIONS; ++i) {
+        {
+            const auto scope = profiler.measure(ADC_ISR);
+            adc_scanner.on_conversion();
+        }
+        // The transmit task only runs the output stage on buffered samples, a settling conversion leaves none
+        if (adc_scanner.available() == 0) {
+            continue;
+        }
+        drain();
+        const auto scope = profiler.measure(LOOP_OUTPUT);
+        output.send_next(adc_scanner, uart_tx);
+    }
+
+    // Same loop with the pop and the write timed, in a pass of its own: nested brackets would add their
+    // overhead to LOOP_OUTPUT
+    timed_source source;
+    timed_sink sink;
+    for (uint16_t i = 0; i < ITERATIONS; ++i) {
+        adc_scanner.on_conversion();
+        if (adc_scanner.available() != 0) {
+            output.send_next(source, sink);
+        }
+    }
+    drain();
+    sei();
+}
+
+void print_report()
+{
+    // Records the pipeline pass lost to a full queue, 0 unless a timed write took the drop path
+    const uint32_t dropped = uart_tx.stats().dropped;
+    profiler.report([](core::span<char> line) {
+        while (!uart_tx.write(line.data(), line.size())) { }
+    });
+    char line[32];
+    core::fmt::writer out(line);
+    out.append("uart_dropped,").append_uint(dropped).append("\r\n");
+    while (!uart_tx.write(out.written().data(), out.size())) { }
+    uart_tx.flush();
+}
+
+} // namespace
+
+ISR(USART_UDRE_vect)
+{
+    uart_tx.on_data_register_empty();
+}
+
+void setup()
+{
+    // No millis() tick skewing the max column
+    TIMSK0 &= ~_BV(TOIE0);
+
+    uart_tx.begin(BENCH_LINK);
+    // Converting with the ADC interrupt off: the handler is called in place and restarts each conversion
+    adc_scanner.start();
+    adc_scanner.stop();
+
+    profiler.start();
+    run_conversions();
+    run_formatting();
+    run_framing();
+    run_pipeline();
+    print_report();
+
+    // Sleeping with interrupts disabled makes simavr exit
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+}
+
+void loop()
+{
+}
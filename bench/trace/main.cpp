@@ -0,0 +1,101 @@
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+#include <fmt.hpp>
+#include <utils/adc.hpp>
+#include <utils/adc_scanner.hpp>
+#include <utils/trace.hpp>
+#include <utils/uart_tx.hpp>
+
+// Event trace of the acquisition pipeline on the simulated ATmega328P at 16 MHz.
+// Each round starts one conversion and prints its CSV line with the real ADC and UART interrupts, traced
+// from conversion complete to the last byte on the wire. The ring is dumped as "trace:" hex lines (the simavr
+// console does not carry binary) whenever it is full, then simavr exits. Decode with `make trace-simavr`.
+
+namespace {
+
+enum trace_id : uint8_t {
+    TRACE_ADC_ISR,
+    TRACE_UART_ISR,
+    TRACE_UART_IDLE,
+    TRACE_OUTPUT,
+};
+
+constexpr core::adc::channel_config CHANNELS[] = { { 0, 1 } };
+constexpr uint8_t DUMPS = 8;
+
+core::adc::scanner<8, 1> adc_scanner(CHANNELS);
+core::uart::transmitter<128, 16> uart_tx;
+
+void print_csv()
+{
+    char line[20];
+    core::adc::tagged_sample sample;
+    while (adc_scanner.pop(sample)) {
+        const core::trace::scope traced(TRACE_OUTPUT);
+        core::fmt::writer out(line);
+        out.append_uint(sample.channel()).append(", ");
+        core::adc::format(out, sample.value()).append("\r\n");
+        uart_tx.write(out.written().data(), out.size());
+    }
+}
+
+void dump()
+{
+    core::trace::dump_text([](core::span<char> line) {
+        while (!uart_tx.write(line.data(), line.size())) { }
+    });
+    uart_tx.flush();
+}
+
+} // namespace
+
+ISR(ADC_vect)
+{
+    const core::trace::scope traced(TRACE_ADC_ISR);
+    adc_scanner.on_conversion();
+    // One sample per round, after the settling conversion
+    if (adc_scanner.available() != 0) {
+        adc_scanner.stop();
+    }
+}
+
+ISR(USART_UDRE_vect)
+{
+    const core::trace::scope traced(TRACE_UART_ISR);
+    uart_tx.on_data_register_empty();
+    if (bit_is_clear(UCSR0B, UDRIE0)) {
+        core::trace::instant(TRACE_UART_IDLE);
+    }
+}
+
+void setup()
+{
+    // No millis() tick in the trace
+    TIMSK0 &= ~_BV(TOIE0);
+
+    uart_tx.begin(115200);
+    core::trace::start();
+
+    for (uint8_t dumps = 0; dumps < DUMPS;) {
+        adc_scanner.start();
+        while (adc_scanner.available() == 0) { }
+        print_csv();
+        uart_tx.flush();
+
+        if (core::trace::size() >= CORE_TRACE_CAPACITY - 40) {
+            dump();
+            ++dumps;
+        }
+    }
+
+    // Sleeping with interrupts disabled makes simavr exit
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+}
+
+void loop()
+{
+}
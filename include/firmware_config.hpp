@@ -0,0 +1,132 @@
+#pragma once
+
+#include <frame.hpp>
+#include <stats.hpp>
+#include <types.hpp>
+#include <utils/adc_schedule.hpp>
+#include <utils/output.hpp>
+#include <utils/trigger.hpp>
+#include <utils/uart_queue.hpp>
+
+// Firmware configuration: build flags turned into constants, shared by src/main.cpp and the native replay
+// (tools/replay/) so both run the same channels, buffers, formats and link settings.
+
+/// Scanned inputs (mux channel = pin - A0) and their rate divisors relative to the fastest channel
+constexpr core::adc::channel_config SENSOR_CHANNELS[] = {
+    { 0, 1 }, // A0 every round
+    { 1, 4 }, // A1 every 4th round
+};
+constexpr uint8_t SENSOR_CHANNEL_COUNT = sizeof(SENSOR_CHANNELS) / sizeof(SENSOR_CHANNELS[0]);
+
+/// Serial output format, binary framing is selected with -D OUTPUT_MODE_BINARY
+#ifdef OUTPUT_MODE_BINARY
+constexpr auto OUTPUT_MODE = core::output::mode::binary;
+#else
+constexpr auto OUTPUT_MODE = core::output::mode::csv;
+#endif
+
+/// Binary payload encoding, -D FRAME_ENCODING_PACKED10 or -D FRAME_ENCODING_DELTA, raw u16 otherwise
+#if defined(FRAME_ENCODING_PACKED10)
+constexpr auto FRAME_ENCODING = core::frame::encoding::packed10;
+#elif defined(FRAME_ENCODING_DELTA)
+constexpr auto FRAME_ENCODING = core::frame::encoding::delta;
+#else
+constexpr auto FRAME_ENCODING = core::frame::encoding::raw16;
+#endif
+
+constexpr uint8_t FRAME_MAX_SAMPLES = 16;
+
+/// ADC acquisition: free-running from the ADC interrupt, or with -D ACQUISITION_NOISE_REDUCTION bursts of
+/// QUIET_BURST conversions in ADC Noise Reduction sleep mode while the UART is idle (see core::adc::quiet_scanner).
+/// Tagged samples wait for the transmit task in SAMPLE_BUFFER_SLOTS slots.
+constexpr uint8_t SAMPLE_BUFFER_SLOTS = 32;
+constexpr uint8_t QUIET_BURST = 8;
+
+/// Triggered capture of one channel at full ADC rate instead of scanning, -D CAPTURE_TRIGGER (see core::trigger).
+/// Each window is sent as a burst in the selected output format, CSV windows behind a
+/// "capture,<number>,<trigger index>,<samples>" line, then the engine rearms.
+#ifdef CAPTURE_TRIGGER
+constexpr bool CAPTURE_MODE = true;
+#else
+constexpr bool CAPTURE_MODE = false;
+#endif
+
+#if defined(CAPTURE_TRIGGER) && defined(ACQUISITION_NOISE_REDUCTION)
+#error "CAPTURE_TRIGGER needs the free-running ADC, it cannot be combined with ACQUISITION_NOISE_REDUCTION"
+#endif
+
+constexpr uint8_t CAPTURE_CHANNEL = 0;
+/// Capture window buffer, 320 bytes of packed 10-bit samples
+constexpr uint16_t CAPTURE_CAPACITY = 256;
+
+/// Rising edge through mid-scale with 8 LSB of hysteresis, 192 samples of history and 64 from the edge on
+constexpr core::trigger::settings CAPTURE_SETTINGS = { { core::trigger::mode::rising, 512, 0, 8 }, 192, 64, 1 };
+
+/// Windowed summaries instead of samples, -D SUMMARY_WINDOW=<samples> (see core::stats): every scanned channel
+/// is reduced to one "stats,<channel>,<count>,<mean>,<min>,<max>,<rms>,<variance>" line per window, CSV mode
+/// only. Windows do not overlap, or slide by SUMMARY_HOP samples with -D SUMMARY_HOP=<divisor of the window>.
+#ifdef SUMMARY_WINDOW
+constexpr uint16_t SUMMARY_LENGTH = SUMMARY_WINDOW;
+#else
+constexpr uint16_t SUMMARY_LENGTH = 0;
+#endif
+#ifdef SUMMARY_HOP
+constexpr uint16_t SUMMARY_STEP = SUMMARY_HOP;
+#else
+constexpr uint16_t SUMMARY_STEP = SUMMARY_LENGTH;
+#endif
+constexpr bool SUMMARY_MODE = SUMMARY_LENGTH > 0;
+
+#if defined(SUMMARY_WINDOW) && (defined(OUTPUT_MODE_BINARY) || defined(CAPTURE_TRIGGER))
+#error "SUMMARY_WINDOW sends CSV summaries of the scanned channels, it excludes OUTPUT_MODE_BINARY and CAPTURE_TRIGGER"
+#endif
+
+static_assert(!SUMMARY_MODE || (SUMMARY_STEP > 0 && SUMMARY_LENGTH % SUMMARY_STEP == 0),
+    "SUMMARY_HOP must divide SUMMARY_WINDOW");
+
+using summary_window
+    = core::stats::sliding<SUMMARY_MODE ? SUMMARY_STEP : 1, SUMMARY_MODE ? SUMMARY_LENGTH / SUMMARY_STEP : 1>;
+
+/// Serial link baud rate, -D UART_BAUD=<baud>. The UBRR/U2X setting closest to it is chosen at compile time and
+/// the build fails if its error exceeds the receiver tolerance (see core::uart::link_config): 250000, 500000 and
+/// 1000000 are exact at 16 MHz
+#ifdef UART_BAUD
+constexpr uint32_t LINK_BAUD = UART_BAUD;
+#else
+constexpr uint32_t LINK_BAUD = 9600;
+#endif
+
+/// Transmit queue of core::uart::transmitter and what happens to records that do not fit
+constexpr uint8_t UART_QUEUE_BYTES = 128;
+constexpr uint8_t UART_QUEUE_RECORDS = 16;
+constexpr auto UART_OVERFLOW_POLICY = core::uart::overflow_policy::drop_newest;
+
+/// Link throughput self-test instead of acquisition, -D UART_SELFTEST: a "link,<baud>,<actual baud>,<error %>,
+/// <ubrr>,<u2x>" line, then pattern frames back to back (see core::uart::selftest), checked by `ingest linktest`
+#ifdef UART_SELFTEST
+constexpr bool SELFTEST_MODE = true;
+#else
+constexpr bool SELFTEST_MODE = false;
+#endif
+
+#if defined(UART_SELFTEST) \
+    && (defined(CAPTURE_TRIGGER) || defined(SUMMARY_WINDOW) || defined(ACQUISITION_NOISE_REDUCTION))
+#error "UART_SELFTEST replaces acquisition, it excludes CAPTURE_TRIGGER, SUMMARY_WINDOW and ACQUISITION_NOISE_REDUCTION"
+#endif
+
+/// Period of the transmit task in 1 ms scheduler ticks: the sample buffer fills in about 3.3 ms at full ADC rate
+constexpr uint8_t TRANSMIT_PERIOD_MS = 2;
+
+/// Period of the RAM usage report (see core::mem), -D MEM_REPORT_PERIOD_MS=<ms>, CSV mode only
+#ifdef MEM_REPORT_PERIOD_MS
+constexpr uint16_t MEM_REPORT_PERIOD = MEM_REPORT_PERIOD_MS;
+#else
+constexpr uint16_t MEM_REPORT_PERIOD = 0;
+#endif
+
+/// Period of the task timing report (see core::sched), -D SCHED_REPORT_PERIOD_MS=<ms>, CSV mode only
+#ifdef SCHED_REPORT_PERIOD_MS
+constexpr uint16_t SCHED_REPORT_PERIOD = SCHED_REPORT_PERIOD_MS;
+#else
+constexpr uint16_t SCHED_REPORT_PERIOD = 0;
+#endif
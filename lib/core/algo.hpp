@@ -0,0 +1,204 @@
+#pragma once
+
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "types.hpp"
+
+namespace core::algo {
+
+/// Allocation-free algorithms over core::span
+///
+/// Two builds of the same kernels: on AVR the loops walk pointers with narrow accumulators and a single
+/// compare per element where possible; on the host min, max, minmax and sum are plain branchless
+/// reductions over the span, which GCC and Clang auto-vectorize (SSE2 by default, AVX2 with -mavx2 or
+/// -march=native), and copy goes through memcpy. GCC only vectorizes these reductions from -O3 on, which
+/// the bench environment uses; bench/native/algo.cpp compares them against the same loops with
+/// vectorization off.
+///
+/// Functions taking a span that must not be empty say so; they do not check it.
+
+namespace detail {
+
+    /// @brief Accumulator type twice as wide as T
+    template <typename T>
+    struct widen;
+
+    template <>
+    struct widen<core::uint8_t> {
+        using type = core::uint16_t;
+    };
+    template <>
+    struct widen<core::uint16_t> {
+        using type = core::uint32_t;
+    };
+    template <>
+    struct widen<core::uint32_t> {
+        using type = core::uint64_t;
+    };
+    template <>
+    struct widen<core::int8_t> {
+        using type = core::int16_t;
+    };
+    template <>
+    struct widen<core::int16_t> {
+        using type = core::int32_t;
+    };
+    template <>
+    struct widen<core::int32_t> {
+        using type = core::int64_t;
+    };
+
+} // namespace detail
+
+/// Element type of a span of T or const T
+template <typename T>
+using value_t = core::remove_const_t<T>;
+
+/// Widened accumulator of T: 8 -> 16, 16 -> 32 and 32 -> 64 bits, signedness kept
+template <typename T>
+using widened_t = typename detail::widen<value_t<T>>::type;
+
+/// Result of minmax()
+template <typename T>
+struct minmax_result {
+    T min;
+    T max;
+};
+
+/// @brief Smallest element of a non-empty span
+template <typename T>
+constexpr value_t<T> min(span<T> values) noexcept
+{
+    value_t<T> result = values[0];
+    for (const auto value : values) {
+        result = value < result ? value : result;
+    }
+    return result;
+}
+
+/// @brief Largest element of a non-empty span
+template <typename T>
+constexpr value_t<T> max(span<T> values) noexcept
+{
+    value_t<T> result = values[0];
+    for (const auto value : values) {
+        result = value > result ? value : result;
+    }
+    return result;
+}
+
+/// @brief Smallest and largest elements of a non-empty span in one pass
+template <typename T>
+constexpr minmax_result<value_t<T>> minmax(span<T> values) noexcept
+{
+    minmax_result<value_t<T>> result { values[0], values[0] };
+#ifdef __AVR__
+    // An element below the minimum cannot be above the maximum: one compare for most samples
+    for (const auto value : values) {
+        if (value < result.min) {
+            result.min = value;
+        } else if (value > result.max) {
+            result.max = value;
+        }
+    }
+#else
+    // Two independent branchless reductions, vectorized to packed min/max
+    for (const auto value : values) {
+        result.min = value < result.min ? value : result.min;
+        result.max = value > result.max ? value : result.max;
+    }
+#endif
+    return result;
+}
+
+/// @brief Sum in an accumulator of type Acc, widened_t<T> by default
+///
+/// The widened accumulator cannot overflow for spans shorter than 2^(8 * sizeof(T)) + 1 elements, which
+/// covers any span of 16-bit samples on AVR. Pass a wider Acc for longer spans of 8-bit values.
+template <typename T, typename Acc = widened_t<T>>
+constexpr Acc sum(span<T> values) noexcept
+{
+    Acc total = 0;
+    for (const auto value : values) {
+        total += value;
+    }
+    return total;
+}
+
+/// @brief Sum of samples known to be at most MaxValue, e.g. 1023 for 10-bit ADC codes
+///
+/// On AVR the samples are added in 16-bit partial sums of 65535 / MaxValue elements (64 for 10-bit
+/// codes), each spilled once into the 32-bit total: two-byte adds instead of four-byte ones, and no
+/// overflow. The host build is the plain widened sum.
+template <core::uint16_t MaxValue>
+constexpr core::uint32_t sum_bounded(span<const core::uint16_t> values) noexcept
+{
+#ifdef __AVR__
+    constexpr core::size_t chunk = 0xFFFFU / (MaxValue > 0 ? MaxValue : 1);
+    core::uint32_t total = 0;
+    const core::uint16_t* it = values.data();
+    core::size_t left = values.size();
+    while (left > 0) {
+        core::size_t count = left < chunk ? left : chunk;
+        left -= count;
+        core::uint16_t partial = 0;
+        while (count-- > 0) {
+            partial += *it++;
+        }
+        total += partial;
+    }
+    return total;
+#else
+    return sum(values);
+#endif
+}
+
+/// @brief Arithmetic mean of a non-empty span, rounded to nearest (half away from zero)
+template <typename T, typename Acc = widened_t<T>>
+constexpr value_t<T> mean(span<T> values) noexcept
+{
+    const Acc total = sum<T, Acc>(values);
+    const Acc count = static_cast<Acc>(values.size());
+    const Acc half = count / 2;
+    if constexpr (static_cast<Acc>(-1) < 0) {
+        return static_cast<value_t<T>>((total < 0 ? total - half : total + half) / count);
+    } else {
+        return static_cast<value_t<T>>((total + half) / count);
+    }
+}
+
+/// @brief Assign value to every element
+template <typename T>
+constexpr void fill(span<T> values, const core::type_identity_t<T>& value) noexcept
+{
+    for (auto& element : values) {
+        element = value;
+    }
+}
+
+/// @brief Copy the first min(in.size(), out.size()) elements, the spans must not overlap
+///
+/// Both spans have the same element type, in may be const: the host copies bytes, AVR assigns elements,
+/// which only agree without conversion.
+/// @return Written prefix of out
+template <typename U, typename T>
+constexpr span<T> copy(span<U> in, span<T> out) noexcept
+{
+    static_assert(core::is_same_v<core::remove_const_t<U>, T>, "copy() takes spans of the same element type");
+    const core::size_t count = in.size() < out.size() ? in.size() : out.size();
+#ifndef __AVR__
+    // Library memcpy beats the vectorized loop on the host, elements are trivially copyable samples
+    if (!__builtin_is_constant_evaluated()) {
+        __builtin_memcpy(out.data(), in.data(), count * sizeof(T));
+        return out.first(count);
+    }
+#endif
+    const U* __restrict source = in.data();
+    T* __restrict destination = out.data();
+    for (core::size_t i = 0; i < count; ++i) {
+        destination[i] = source[i];
+    }
+    return out.first(count);
+}
+
+} // namespace core::algo
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core {
+
+/// Largest fundamental alignment: 1 on AVR, 16 on x86-64
+inline constexpr core::size_t max_alignment = alignof(long double) > alignof(long long) ? alignof(long double)
+                                                                                       : alignof(long long);
+
+/// Bump allocator over a fixed static buffer
+///
+/// Allocation advances an offset, so it is O(1) and never fragments. Memory is released in LIFO order by
+/// rolling back to a marker, either explicitly with release() or with a scope guard:
+/// @code
+/// core::static_arena<256> arena;
+/// {
+///     const auto scope = arena.make_scope();
+///     auto line = arena.allocate<char>(32);
+///     ...
+/// } // line is released here
+/// @endcode
+///
+/// Allocations hand out uninitialized storage for trivial types; an empty span means the arena is
+/// exhausted. No exceptions, no heap.
+///
+/// @tparam Bytes Capacity in bytes
+template <core::size_t Bytes>
+class static_arena {
+    static_assert(Bytes > 0, "Arena capacity must not be zero");
+
+public:
+    /// Allocation state to roll back to
+    using marker = core::size_t;
+
+    /// @brief Releases everything allocated after its construction when destroyed
+    class scope {
+    public:
+        explicit scope(static_arena& arena) noexcept
+            : arena_(arena)
+            , marker_(arena.mark())
+        {
+        }
+        ~scope() { arena_.release(marker_); }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+    private:
+        static_arena& arena_;
+        marker marker_;
+    };
+
+    /// @brief Allocate count uninitialized objects of trivial type T
+    /// @return Storage for count objects, empty if the arena cannot hold them
+    template <typename T>
+    span<T> allocate(core::size_t count) noexcept
+    {
+        static_assert(alignof(T) <= max_alignment, "Over-aligned types are not supported");
+        if (count > Bytes / sizeof(T)) {
+            return {};
+        }
+        const auto bytes = allocate_bytes(count * sizeof(T), alignof(T));
+        return bytes.empty() ? span<T>() : span<T>(reinterpret_cast<T*>(bytes.data()), count);
+    }
+
+    /// @brief Allocate size bytes aligned to align (a power of two up to max_alignment)
+    /// @return Storage, empty if the arena cannot hold it or size is 0
+    span<core::uint8_t> allocate_bytes(core::size_t size, core::size_t align = 1) noexcept
+    {
+        const core::size_t offset = (used_ + align - 1) & ~(align - 1);
+        if (size == 0 || offset > Bytes || size > Bytes - offset) {
+            return {};
+        }
+        used_ = offset + size;
+        high_water_ = used_ > high_water_ ? used_ : high_water_;
+        return span<core::uint8_t>(buffer_ + offset, size);
+    }
+
+    /// @brief Current allocation state
+    constexpr marker mark() const noexcept { return used_; }
+
+    /// @brief Release everything allocated after m was taken
+    constexpr void release(marker m) noexcept { used_ = m < used_ ? m : used_; }
+
+    /// @brief Guard releasing everything allocated during its lifetime
+    scope make_scope() noexcept { return scope(*this); }
+
+    /// @brief Release everything
+    constexpr void reset() noexcept { used_ = 0; }
+
+    constexpr core::size_t used() const noexcept { return used_; }
+    constexpr core::size_t remaining() const noexcept { return Bytes - used_; }
+    static constexpr core::size_t capacity() noexcept { return Bytes; }
+
+    /// @brief Largest used() seen since construction, sizes Bytes for the real workload
+    constexpr core::size_t high_water() const noexcept { return high_water_; }
+
+private:
+    alignas(max_alignment) core::uint8_t buffer_[Bytes];
+    core::size_t used_ {};
+    core::size_t high_water_ {};
+};
+
+} // namespace core
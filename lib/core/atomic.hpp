@@ -0,0 +1,59 @@
+#pragma once
+
+#include "types.hpp"
+
+#ifndef __AVR__
+#include <atomic>
+#endif
+
+namespace core {
+
+/// Single-byte value shared between exactly one writer and one reader
+/// (ISR and main loop on AVR, two threads on the host).
+///
+/// On AVR 8-bit loads and stores are naturally atomic, so a compiler barrier is all that is needed
+/// to order them against the surrounding data accesses. Host builds map to std::atomic with
+/// acquire/release semantics so the same code can be stress-tested with real threads.
+class atomic_u8 {
+public:
+    constexpr atomic_u8() noexcept = default;
+    constexpr explicit atomic_u8(core::uint8_t value) noexcept
+        : value_(value)
+    {
+    }
+
+    atomic_u8(const atomic_u8&) = delete;
+    atomic_u8& operator=(const atomic_u8&) = delete;
+
+#ifdef __AVR__
+    /// @brief Load without ordering guarantees (own index, only written by the caller)
+    core::uint8_t load_relaxed() const noexcept { return value_; }
+
+    /// @brief Load that happens-before any subsequent data access
+    core::uint8_t load_acquire() const noexcept
+    {
+        const core::uint8_t value = value_;
+        asm volatile("" ::: "memory");
+        return value;
+    }
+
+    /// @brief Store that happens-after any preceding data access
+    void store_release(core::uint8_t value) noexcept
+    {
+        asm volatile("" ::: "memory");
+        value_ = value;
+    }
+
+private:
+    volatile core::uint8_t value_ {};
+#else
+    core::uint8_t load_relaxed() const noexcept { return value_.load(std::memory_order_relaxed); }
+    core::uint8_t load_acquire() const noexcept { return value_.load(std::memory_order_acquire); }
+    void store_release(core::uint8_t value) noexcept { value_.store(value, std::memory_order_release); }
+
+private:
+    std::atomic<core::uint8_t> value_ {};
+#endif
+};
+
+} // namespace core
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::cobs {
+
+/// Frame delimiter, never present in encoded data
+inline constexpr core::uint8_t delimiter = 0x00;
+
+/// @brief Worst-case encoded size of size bytes, excluding the delimiter
+constexpr core::size_t max_encoded_size(core::size_t size) noexcept
+{
+    return size + size / 254 + 1;
+}
+
+/// Streaming Consistent Overhead Byte Stuffing encoder
+///
+/// Bytes are stuffed directly into the output buffer as they are put, so a frame can be built
+/// field by field without an intermediate raw copy. Overflow is sticky and reported by finish().
+class encoder {
+public:
+    /// @brief Start a new frame in out
+    constexpr explicit encoder(span<core::uint8_t> out) noexcept
+        : out_(out)
+    {
+        open_block();
+    }
+
+    /// @brief Append one payload byte
+    constexpr void put(core::uint8_t byte) noexcept
+    {
+        if (byte != delimiter) {
+            if (!write(byte)) {
+                return;
+            }
+            if (++code_ != 0xFF) {
+                return;
+            }
+        }
+        close_block();
+        open_block();
+    }
+
+    /// @brief Close the frame, optionally appending the delimiter
+    /// @return Encoded frame, empty if out was too small
+    constexpr span<core::uint8_t> finish(bool append_delimiter = true) noexcept
+    {
+        close_block();
+        if (append_delimiter) {
+            write(delimiter);
+        }
+        return overflow_ ? out_.first(0) : out_.first(size_);
+    }
+
+private:
+    constexpr bool write(core::uint8_t byte) noexcept
+    {
+        if (size_ >= out_.size()) {
+            overflow_ = true;
+            return false;
+        }
+        out_[size_++] = byte;
+        return true;
+    }
+
+    constexpr void open_block() noexcept
+    {
+        code_index_ = size_;
+        code_ = 1;
+        write(0); // placeholder for the block code
+    }
+
+    constexpr void close_block() noexcept
+    {
+        if (!overflow_) {
+            out_[code_index_] = code_;
+        }
+    }
+
+    span<core::uint8_t> out_;
+    core::size_t size_ {};
+    core::size_t code_index_ {};
+    core::uint8_t code_ {};
+    bool overflow_ {};
+};
+
+/// @brief Encode a whole buffer (no delimiter appended)
+/// @return Encoded bytes, empty if out is too small
+constexpr span<core::uint8_t> encode(span<const core::uint8_t> in, span<core::uint8_t> out) noexcept
+{
+    encoder stuffing(out);
+    for (const auto byte : in) {
+        stuffing.put(byte);
+    }
+    return stuffing.finish(false);
+}
+
+/// @brief Decode one frame (without delimiter). Decoding in place (out.data() == in.data()) is allowed.
+/// @return Decoded bytes, empty if the frame is malformed or out is too small
+constexpr span<core::uint8_t> decode(span<const core::uint8_t> in, span<core::uint8_t> out) noexcept
+{
+    core::size_t read = 0;
+    core::size_t written = 0;
+    while (read < in.size()) {
+        const core::uint8_t code = in[read++];
+        if (code == delimiter || read + code - 1 > in.size()) {
+            return out.first(0);
+        }
+        for (core::uint8_t i = 1; i < code; ++i) {
+            const core::uint8_t byte = in[read++];
+            if (byte == delimiter || written >= out.size()) {
+                return out.first(0);
+            }
+            out[written++] = byte;
+        }
+        // A zero follows every block except maximal ones and the last one
+        if (code != 0xFF && read < in.size()) {
+            if (written >= out.size()) {
+                return out.first(0);
+            }
+            out[written++] = 0;
+        }
+    }
+    return out.first(written);
+}
+
+} // namespace core::cobs
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::crc {
+
+/// Initial value of CRC-16/CCITT-FALSE
+inline constexpr core::uint16_t ccitt_init = 0xFFFF;
+
+/// @brief Update a CRC-16/CCITT-FALSE (poly 0x1021, MSB first) with one byte.
+///        Table-free byte-wise formulation: a handful of shifts and XORs, no flash table.
+constexpr core::uint16_t ccitt_update(core::uint16_t crc, core::uint8_t data) noexcept
+{
+    crc = static_cast<core::uint16_t>((crc >> 8) | (crc << 8));
+    crc ^= data;
+    crc ^= static_cast<core::uint16_t>((crc & 0xFF) >> 4);
+    crc ^= static_cast<core::uint16_t>(crc << 12);
+    crc ^= static_cast<core::uint16_t>((crc & 0xFF) << 5);
+    return crc;
+}
+
+/// @brief CRC-16/CCITT-FALSE of a byte sequence
+constexpr core::uint16_t ccitt(span<const core::uint8_t> data, core::uint16_t crc = ccitt_init) noexcept
+{
+    for (const auto byte : data) {
+        crc = ccitt_update(crc, byte);
+    }
+    return crc;
+}
+
+} // namespace core::crc
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::delta {
+
+/// Delta + zigzag + varint sample stream compression
+///
+/// Each sample is sent as the difference to the previous one (modulo 2^16, the first against a
+/// caller-chosen start value), zigzag-mapped so small negative and positive steps both become small
+/// unsigned numbers, then written as an LEB128 varint: 7 bits per byte, high bit set on all but the
+/// last byte. Steps within +/-63 LSB take one byte, 10-bit samples never take more than two and any
+/// 16-bit sample at most three. Lossless for all inputs; pays off on slowly varying signals.
+
+/// Longest varint of a 16-bit value
+inline constexpr core::size_t max_varint_size = 3;
+
+/// @brief Worst-case encoded size of count samples
+constexpr core::size_t max_encoded_size(core::size_t count) noexcept
+{
+    return count * max_varint_size;
+}
+
+/// @brief Map a signed step to unsigned: 0, -1, 1, -2, 2 ... -> 0, 1, 2, 3, 4 ...
+constexpr core::uint16_t zigzag(core::int16_t value) noexcept
+{
+    const unsigned bits = static_cast<core::uint16_t>(value);
+    return static_cast<core::uint16_t>((bits << 1) ^ static_cast<core::uint16_t>(value >> 15));
+}
+
+/// @brief Inverse of zigzag()
+constexpr core::int16_t unzigzag(core::uint16_t value) noexcept
+{
+    return static_cast<core::int16_t>((value >> 1) ^ static_cast<core::uint16_t>(-(value & 1)));
+}
+
+/// Streaming encoder, bytes are handed to a sink one at a time
+class encoder {
+public:
+    /// @param[in] previous Value the first sample is differenced against
+    constexpr explicit encoder(core::uint16_t previous = 0) noexcept
+        : previous_(previous)
+    {
+    }
+
+    /// @brief Encode one sample, calling sink(core::uint8_t) for each of its 1-3 bytes
+    template <class Sink>
+    constexpr void put(core::uint16_t sample, Sink&& sink) noexcept
+    {
+        core::uint16_t value = zigzag(static_cast<core::int16_t>(static_cast<core::uint16_t>(sample - previous_)));
+        previous_ = sample;
+        while (value >= 0x80) {
+            sink(static_cast<core::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        sink(static_cast<core::uint8_t>(value));
+    }
+
+    /// @brief Last encoded sample
+    constexpr core::uint16_t previous() const noexcept { return previous_; }
+
+private:
+    core::uint16_t previous_;
+};
+
+/// Streaming decoder, fed one byte at a time
+class decoder {
+public:
+    /// Decoder status after a byte
+    enum class status : core::uint8_t {
+        pending, //< Sample still incomplete
+        sample, //< A sample was decoded
+        error, //< Varint longer than max_varint_size, decoder reset to the current sample
+    };
+
+    /// @param[in] previous Value the first sample is differenced against, as given to the encoder
+    constexpr explicit decoder(core::uint16_t previous = 0) noexcept
+        : previous_(previous)
+    {
+    }
+
+    /// @brief Consume one byte
+    /// @param[out] sample Decoded sample when status::sample is returned
+    constexpr status feed(core::uint8_t byte, core::uint16_t& sample) noexcept
+    {
+        if (length_ == max_varint_size - 1 && (byte & 0x80 || byte > 0x03)) {
+            // Third byte carries the top 2 bits only
+            value_ = 0;
+            length_ = 0;
+            return status::error;
+        }
+        value_ |= static_cast<core::uint16_t>(static_cast<unsigned>(byte & 0x7F) << (7 * length_));
+        if (byte & 0x80) {
+            ++length_;
+            return status::pending;
+        }
+        previous_ = static_cast<core::uint16_t>(previous_ + unzigzag(value_));
+        sample = previous_;
+        value_ = 0;
+        length_ = 0;
+        return status::sample;
+    }
+
+    /// @brief True between samples
+    constexpr bool idle() const noexcept { return length_ == 0; }
+
+private:
+    core::uint16_t previous_;
+    core::uint16_t value_ {};
+    core::uint8_t length_ {};
+};
+
+/// @brief Encode a whole buffer
+/// @param[in] previous Value the first sample is differenced against
+/// @return Encoded bytes, empty if out is too small (max_encoded_size(in.size()) is always enough)
+constexpr span<core::uint8_t> encode(span<const core::uint16_t> in, span<core::uint8_t> out,
+    core::uint16_t previous = 0) noexcept
+{
+    encoder stream(previous);
+    core::size_t size = 0;
+    bool overflow = false;
+    for (const auto sample : in) {
+        stream.put(sample, [&](core::uint8_t byte) {
+            if (size < out.size()) {
+                out[size++] = byte;
+            } else {
+                overflow = true;
+            }
+        });
+    }
+    return overflow ? out.first(0) : out.first(size);
+}
+
+/// @brief Decode a whole buffer
+/// @param[in] previous Value the first sample is differenced against, as given to encode()
+/// @return Decoded samples, empty if the input is malformed, truncated or out is too small
+constexpr span<core::uint16_t> decode(span<const core::uint8_t> in, span<core::uint16_t> out,
+    core::uint16_t previous = 0) noexcept
+{
+    decoder stream(previous);
+    core::size_t size = 0;
+    for (const auto byte : in) {
+        core::uint16_t sample = 0;
+        switch (stream.feed(byte, sample)) {
+        case decoder::status::pending:
+            break;
+        case decoder::status::sample:
+            if (size >= out.size()) {
+                return out.first(0);
+            }
+            out[size++] = sample;
+            break;
+        case decoder::status::error:
+            return out.first(0);
+        }
+    }
+    return stream.idle() ? out.first(size) : out.first(0);
+}
+
+} // namespace core::delta
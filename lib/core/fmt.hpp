@@ -0,0 +1,192 @@
+#pragma once
+
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::fmt {
+
+namespace detail {
+
+    /// @brief x / 10 as multiply-shift, exact for every 16-bit value
+    constexpr core::uint16_t div10(core::uint16_t x) noexcept
+    {
+        return static_cast<core::uint16_t>((static_cast<core::uint32_t>(x) * 0xCCCDU) >> 19);
+    }
+
+    /// @brief Write the decimal digits of value backwards ending at end, return the first digit position.
+    ///        No division, one 16x16->32 multiply per digit (div10).
+    constexpr char* u16_digits_backwards(core::uint16_t value, char* end) noexcept
+    {
+        do {
+            const core::uint16_t quotient = div10(value);
+            *--end = static_cast<char>('0' + (value - quotient * 10U));
+            value = quotient;
+        } while (value != 0);
+        return end;
+    }
+
+    /// @brief Write the decimal digits of a 32-bit value backwards ending at end.
+    ///        Peels 4-digit chunks with one 32-bit division each, digits themselves use the 16-bit path.
+    constexpr char* u32_digits_backwards(core::uint32_t value, char* end) noexcept
+    {
+        while (value > 0xFFFFU) {
+            const core::uint32_t quotient = value / 10000U;
+            auto chunk = static_cast<core::uint16_t>(value - quotient * 10000U);
+            for (core::uint8_t i = 0; i < 4; ++i) {
+                const core::uint16_t q = div10(chunk);
+                *--end = static_cast<char>('0' + (chunk - q * 10U));
+                chunk = q;
+            }
+            value = quotient;
+        }
+        return u16_digits_backwards(static_cast<core::uint16_t>(value), end);
+    }
+
+    /// Digits of the largest 32-bit value plus sign
+    inline constexpr core::size_t max_digits = 11;
+
+    /// Most digits after the decimal point of writer::append_fixed(), all of a 32-bit value but one
+    inline constexpr core::uint8_t max_decimals = 9;
+
+} // namespace detail
+
+/// Heap-free text writer appending into a caller-provided buffer
+///
+/// Features:
+/// - Integers, fixed-point values, characters and literals
+/// - Decimal conversion without division in the digit loop (no vfprintf, no String)
+/// - Chainable, constexpr compatible, no exceptions
+///
+/// Output is not null-terminated. If an append does not fit, nothing of it is written and the writer
+/// enters an overflow state that ok() reports; written() still returns the text written so far.
+class writer {
+public:
+    /// @brief Writer over buffer, starting empty
+    constexpr explicit writer(span<char> buffer) noexcept
+        : buffer_(buffer)
+    {
+    }
+
+    /// @brief Append a single character
+    constexpr writer& append(char c) noexcept
+    {
+        if (reserve(1)) {
+            buffer_[size_++] = c;
+        }
+        return *this;
+    }
+
+    /// @brief Append a null-terminated literal
+    constexpr writer& append(const char* literal) noexcept
+    {
+        core::size_t length = 0;
+        while (literal[length] != '\0') {
+            ++length;
+        }
+        return append(literal, length);
+    }
+
+    /// @brief Append count characters
+    constexpr writer& append(const char* text, core::size_t count) noexcept
+    {
+        if (reserve(count)) {
+            for (core::size_t i = 0; i < count; ++i) {
+                buffer_[size_++] = text[i];
+            }
+        }
+        return *this;
+    }
+
+    /// @brief Append an unsigned integer in decimal
+    constexpr writer& append_uint(core::uint32_t value) noexcept
+    {
+        char digits[detail::max_digits] {};
+        char* const end = digits + detail::max_digits;
+        const char* const first = detail::u32_digits_backwards(value, end);
+        return append(first, static_cast<core::size_t>(end - first));
+    }
+
+    /// @brief Append a signed integer in decimal
+    constexpr writer& append_int(core::int32_t value) noexcept
+    {
+        char digits[detail::max_digits] {};
+        char* const end = digits + detail::max_digits;
+        char* first = detail::u32_digits_backwards(magnitude(value), end);
+        if (value < 0) {
+            *--first = '-';
+        }
+        return append(first, static_cast<core::size_t>(end - first));
+    }
+
+    /// @brief Append a fixed-point value scaled by 10^decimals, e.g. (2502, 3) -> "2.502"
+    /// @param[in] value Scaled value
+    /// @param[in] decimals Digits after the decimal point (0-9, larger values are clamped to 9)
+    constexpr writer& append_fixed(core::int32_t value, core::uint8_t decimals) noexcept
+    {
+        // The zero padding below must stay inside digits
+        if (decimals > detail::max_decimals) {
+            decimals = detail::max_decimals;
+        }
+        char digits[detail::max_digits + 2] {};
+        char* const end = digits + sizeof(digits);
+        char* first = detail::u32_digits_backwards(magnitude(value), end);
+
+        if (decimals > 0) {
+            // Zero-pad so there is at least one integer digit, then open a slot for the point
+            while (end - first <= decimals) {
+                *--first = '0';
+            }
+            char* const point = end - decimals;
+            for (char* it = first - 1; it < point - 1; ++it) {
+                *it = *(it + 1);
+            }
+            --first;
+            *(point - 1) = '.';
+        }
+        if (value < 0) {
+            *--first = '-';
+        }
+        return append(first, static_cast<core::size_t>(end - first));
+    }
+
+    /// @brief Discard the content and clear the overflow state
+    constexpr void clear() noexcept
+    {
+        size_ = 0;
+        overflow_ = false;
+    }
+
+    /// @brief False if any append did not fit
+    constexpr bool ok() const noexcept { return !overflow_; }
+
+    /// @brief Number of characters written
+    constexpr core::size_t size() const noexcept { return size_; }
+
+    /// @brief Remaining capacity in characters
+    constexpr core::size_t remaining() const noexcept { return buffer_.size() - size_; }
+
+    /// @brief Written subspan of the buffer
+    constexpr span<char> written() const noexcept { return buffer_.first(size_); }
+
+private:
+    constexpr bool reserve(core::size_t count) noexcept
+    {
+        if (overflow_ || count > remaining()) {
+            overflow_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Absolute value as unsigned, well-defined for INT32_MIN
+    static constexpr core::uint32_t magnitude(core::int32_t value) noexcept
+    {
+        return value < 0 ? 0U - static_cast<core::uint32_t>(value) : static_cast<core::uint32_t>(value);
+    }
+
+    span<char> buffer_;
+    core::size_t size_ {};
+    bool overflow_ {};
+};
+
+} // namespace core::fmt
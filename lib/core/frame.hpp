@@ -0,0 +1,291 @@
+#pragma once
+
+#include "cobs.hpp"
+#include "crc.hpp"
+#include "delta.hpp"
+#include "packed.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::frame {
+
+/// Binary sample frame
+///
+/// Raw packet layout (little-endian), COBS-stuffed and terminated by a 0x00 delimiter on the wire:
+///
+///     | sequence u8 | encoding u4 : channel u4 | count u8 | payload | crc16 u16 |
+///
+/// The payload carries count samples in one of the sample encodings:
+/// - raw16: u16 per sample
+/// - packed10: 10-bit samples bit-packed as in core::packed_span<10>, 5 bytes per 4 samples
+/// - delta: core::delta varint stream starting from 0, 1-3 bytes per sample
+///
+/// The CRC is CRC-16/CCITT-FALSE over everything before it. The sequence number increments once per
+/// frame on the link and wraps at 256, so the receiver detects dropped frames from gaps.
+
+/// Sample encoding of the payload, upper nibble of the channel byte. 0xF is reserved for core::trace dumps
+/// sharing the link, decoders count those as framing errors.
+enum class encoding : core::uint8_t {
+    raw16 = 0,
+    packed10 = 1,
+    delta = 2,
+};
+
+/// Bytes of a raw packet around the samples
+inline constexpr core::size_t header_size = 3;
+inline constexpr core::size_t trailer_size = 2;
+
+/// Most samples a single frame can carry
+inline constexpr core::size_t max_samples = 255;
+
+/// Highest channel id, the channel shares its byte with the encoding
+inline constexpr core::uint8_t max_channel = 0x0F;
+
+/// @brief Payload size of count samples, an upper bound for the variable-length delta encoding
+constexpr core::size_t max_payload_size(core::size_t count, encoding format = encoding::raw16) noexcept
+{
+    switch (format) {
+    case encoding::packed10:
+        return packed_size(10, count);
+    case encoding::delta:
+        return delta::max_encoded_size(count);
+    case encoding::raw16:
+    default:
+        return count * 2;
+    }
+}
+
+/// @brief Size of a raw16 packet carrying count samples, upper bound for any fixed-size encoding
+constexpr core::size_t packet_size(core::size_t count) noexcept
+{
+    return header_size + count * 2 + trailer_size;
+}
+
+/// @brief Worst-case size of a raw packet carrying count samples
+constexpr core::size_t max_packet_size(core::size_t count, encoding format = encoding::raw16) noexcept
+{
+    return header_size + max_payload_size(count, format) + trailer_size;
+}
+
+/// @brief Worst-case size on the wire of a frame carrying count samples, delimiter included
+constexpr core::size_t max_frame_size(core::size_t count, encoding format = encoding::raw16) noexcept
+{
+    return cobs::max_encoded_size(max_packet_size(count, format)) + 1;
+}
+
+/// @brief Encode a frame of samples ready to be written to the link.
+/// @param[in] sequence Frame sequence number
+/// @param[in] channel Source channel id (0-15, unchecked)
+/// @param[in] samples Up to max_samples samples (unchecked), 10-bit wide for encoding::packed10
+/// @param[out] out Destination, max_frame_size(samples.size(), format) bytes are always enough
+/// @param[in] format Sample encoding of the payload
+/// @return Encoded frame including the delimiter, empty if out is too small
+constexpr span<core::uint8_t> encode(core::uint8_t sequence, core::uint8_t channel,
+    span<const core::uint16_t> samples, span<core::uint8_t> out, encoding format = encoding::raw16) noexcept
+{
+    cobs::encoder stuffing(out);
+    core::uint16_t crc = crc::ccitt_init;
+    const auto put = [&stuffing, &crc](core::uint8_t byte) {
+        crc = crc::ccitt_update(crc, byte);
+        stuffing.put(byte);
+    };
+
+    put(sequence);
+    put(static_cast<core::uint8_t>(static_cast<core::uint8_t>(format) << 4 | channel));
+    put(static_cast<core::uint8_t>(samples.size()));
+    switch (format) {
+    case encoding::packed10: {
+        // LSB-first bit stream, at most 7 + 10 bits pending
+        core::uint32_t bits = 0;
+        core::uint8_t pending = 0;
+        for (const auto sample : samples) {
+            bits |= static_cast<core::uint32_t>(sample & 0x03FF) << pending;
+            pending += 10;
+            while (pending >= 8) {
+                put(static_cast<core::uint8_t>(bits));
+                bits >>= 8;
+                pending -= 8;
+            }
+        }
+        if (pending > 0) {
+            put(static_cast<core::uint8_t>(bits));
+        }
+        break;
+    }
+    case encoding::delta: {
+        delta::encoder stream {};
+        for (const auto sample : samples) {
+            stream.put(sample, put);
+        }
+        break;
+    }
+    case encoding::raw16:
+    default:
+        for (const auto sample : samples) {
+            put(static_cast<core::uint8_t>(sample));
+            put(static_cast<core::uint8_t>(sample >> 8));
+        }
+        break;
+    }
+    const core::uint16_t checksum = crc;
+    stuffing.put(static_cast<core::uint8_t>(checksum));
+    stuffing.put(static_cast<core::uint8_t>(checksum >> 8));
+    return stuffing.finish();
+}
+
+/// Decoded frame, valid until the next call to decoder::feed()
+struct packet {
+    core::uint8_t sequence;
+    core::uint8_t channel;
+    span<const core::uint16_t> samples;
+    encoding format; //< Encoding the samples were sent with
+};
+
+/// Decoder status after a byte
+enum class status : core::uint8_t {
+    pending, //< Frame still incomplete
+    packet, //< A valid packet is available through decoder::last()
+    error, //< Frame discarded (framing, length or CRC error)
+};
+
+/// Link statistics gathered by the decoder
+struct statistics {
+    core::uint32_t frames; //< Valid frames
+    core::uint32_t samples; //< Samples in valid frames
+    core::uint32_t dropped_frames; //< Frames missing according to sequence gaps
+    core::uint32_t crc_errors; //< Frames with a bad CRC
+    core::uint32_t framing_errors; //< Malformed, truncated or oversized frames
+};
+
+/// Streaming frame decoder, fed one byte at a time from the link
+///
+/// Resynchronizes on the next delimiter after any error, so it can join a stream mid-frame.
+///
+/// @tparam MaxSamples Largest frame accepted, bigger frames are counted as framing errors
+template <core::size_t MaxSamples = max_samples>
+class decoder {
+    static_assert(MaxSamples > 0 && MaxSamples <= max_samples, "MaxSamples must be in [1, 255]");
+
+public:
+    /// @brief Consume one byte from the link
+    status feed(core::uint8_t byte) noexcept
+    {
+        if (byte != cobs::delimiter) {
+            if (size_ < sizeof(frame_)) {
+                frame_[size_] = byte;
+            }
+            ++size_;
+            return status::pending;
+        }
+
+        const core::size_t size = size_;
+        size_ = 0;
+        if (size == 0) {
+            return status::pending; // Back-to-back delimiters, e.g. idle line filler
+        }
+        if (size > sizeof(frame_)) {
+            ++stats_.framing_errors;
+            return status::error;
+        }
+        return unpack(size);
+    }
+
+    /// @brief Consume a buffer, calling on_packet(const packet&) for every valid frame
+    template <class Callback>
+    void feed(span<const core::uint8_t> bytes, Callback&& on_packet)
+    {
+        for (const auto byte : bytes) {
+            if (feed(byte) == status::packet) {
+                on_packet(last_);
+            }
+        }
+    }
+
+    /// @brief Last valid packet
+    const packet& last() const noexcept { return last_; }
+
+    /// @brief Link statistics since construction or reset()
+    const statistics& stats() const noexcept { return stats_; }
+
+    /// @brief Forget partial frames, sequence tracking and statistics
+    void reset() noexcept
+    {
+        size_ = 0;
+        synced_ = false;
+        stats_ = {};
+    }
+
+private:
+    status unpack(core::size_t size) noexcept
+    {
+        const auto raw = cobs::decode(span<const core::uint8_t>(frame_, size), span<core::uint8_t>(frame_, size));
+        if (raw.size() < packet_size(0) || raw[2] > MaxSamples) {
+            ++stats_.framing_errors;
+            return status::error;
+        }
+        const auto format = static_cast<encoding>(raw[1] >> 4);
+        const core::uint8_t count = raw[2];
+        const core::size_t payload = raw.size() - header_size - trailer_size;
+        const bool sized = format == encoding::delta
+            ? payload >= count && payload <= max_payload_size(count, format)
+            : (format == encoding::raw16 || format == encoding::packed10) && payload == max_payload_size(count, format);
+        if (!sized) {
+            ++stats_.framing_errors;
+            return status::error;
+        }
+
+        const core::size_t body = raw.size() - trailer_size;
+        const core::uint16_t expected = raw[body] | static_cast<core::uint16_t>(raw[body + 1] << 8);
+        if (crc::ccitt(span<const core::uint8_t>(raw.data(), body)) != expected) {
+            ++stats_.crc_errors;
+            return status::error;
+        }
+
+        const auto bytes = span<const core::uint8_t>(raw.data() + header_size, payload);
+        if (!unpack_samples(format, bytes, count)) {
+            ++stats_.framing_errors;
+            return status::error;
+        }
+
+        const core::uint8_t sequence = raw[0];
+        if (synced_) {
+            stats_.dropped_frames += static_cast<core::uint8_t>(sequence - next_sequence_);
+        }
+        synced_ = true;
+        next_sequence_ = sequence + 1;
+
+        last_ = { sequence, static_cast<core::uint8_t>(raw[1] & max_channel), span<const core::uint16_t>(samples_, count),
+            format };
+        ++stats_.frames;
+        stats_.samples += count;
+        return status::packet;
+    }
+
+    /// @brief Decode count samples of the payload into samples_
+    bool unpack_samples(encoding format, span<const core::uint8_t> bytes, core::uint8_t count) noexcept
+    {
+        switch (format) {
+        case encoding::packed10:
+            core::unpack(packed_span<10, const core::uint8_t>(bytes, count), span<core::uint16_t>(samples_, count));
+            return true;
+        case encoding::delta:
+            return delta::decode(bytes, span<core::uint16_t>(samples_, count)).size() == count;
+        case encoding::raw16:
+        default:
+            for (core::uint8_t i = 0; i < count; ++i) {
+                samples_[i] = bytes[2 * i] | static_cast<core::uint16_t>(bytes[2 * i + 1] << 8);
+            }
+            return true;
+        }
+    }
+
+    core::uint8_t frame_[cobs::max_encoded_size(max_packet_size(MaxSamples, encoding::delta))] {};
+    core::uint16_t samples_[MaxSamples] {};
+    core::size_t size_ {};
+    packet last_ {};
+    statistics stats_ {};
+    core::uint8_t next_sequence_ {};
+    bool synced_ {};
+};
+
+} // namespace core::frame
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "progmem.hpp"
+#include "type_traits.hpp"
+#include "types.hpp"
+
+namespace core::lut {
+
+/// Fixed-size table returned by constexpr generators, placed in flash with CORE_PROGMEM
+///
+/// A plain aggregate: C-arrays cannot be returned from functions. View it with core::progmem_span when it
+/// is in flash, index it directly only in constant expressions or when it is in RAM.
+/// @code
+/// constexpr core::lut::table<core::uint16_t, 33> curve CORE_PROGMEM = grid::generate<core::uint16_t>(fn);
+/// @endcode
+template <typename T, core::size_t N>
+struct table {
+    T values[N];
+
+    constexpr const T* data() const noexcept { return values; }
+    static constexpr core::size_t size() noexcept { return N; }
+    constexpr const T& operator[](core::size_t index) const noexcept { return values[index]; }
+};
+
+/// @brief Natural logarithm usable in constant expressions (C++17 <cmath> is not constexpr), for table
+/// generators: thermistor and other exponential curves. About 1e-12 relative error, x must be positive.
+constexpr double ln(double x) noexcept
+{
+    constexpr double ln2 = 0.6931471805599453;
+    // x = m * 2^e with m in [0.75, 1.5), then ln(m) = 2 atanh((m - 1) / (m + 1)) with |term| < 0.2
+    int e = 0;
+    while (x >= 1.5) {
+        x /= 2;
+        ++e;
+    }
+    while (x < 0.75) {
+        x *= 2;
+        --e;
+    }
+    const double t = (x - 1) / (x + 1);
+    const double t2 = t * t;
+    double power = t;
+    double sum = 0;
+    for (int k = 1; k < 40; k += 2) {
+        sum += power / k;
+        power *= t2;
+    }
+    return 2 * sum + e * ln2;
+}
+
+namespace detail {
+
+    /// @brief Round to nearest (half away from zero) and saturate to the range of the integral type T
+    template <typename T>
+    constexpr T round_saturate(double value) noexcept
+    {
+        static_assert(is_integral_v<T>, "Tables hold integers, interpolation is integer-only");
+        constexpr core::uint8_t value_bits = 8 * sizeof(T) - (is_unsigned_v<T> ? 0 : 1);
+        constexpr double max = static_cast<double>((core::uint64_t { 1 } << value_bits) - 1);
+        constexpr double min = is_unsigned_v<T> ? 0.0 : -max - 1;
+        if (value <= min) {
+            return static_cast<T>(min);
+        }
+        if (value >= max) {
+            return static_cast<T>(max);
+        }
+        return static_cast<T>(value < 0 ? value - 0.5 : value + 0.5);
+    }
+
+} // namespace detail
+
+/// Uniform sampling grid of a curve over InputBits-wide codes, with integer linear interpolation
+///
+/// The curve is sampled every 2^(InputBits - SegmentBits) codes, at x = i << shift for i in
+/// [0, 2^SegmentBits]: the last point lies one step past the largest code so every code falls inside a
+/// segment. A lookup is then a shift, two table reads and one multiply,
+///     y = y[i] + ((y[i + 1] - y[i]) * (x & mask) + half) >> shift
+/// with no division and no floating point. The interpolation error of a smooth curve falls with the
+/// square of the segment width: each SegmentBits step doubles the table and quarters the error.
+/// @code
+/// using ntc_grid = core::lut::grid<10, 5>;
+/// constexpr auto ntc_table CORE_PROGMEM = ntc_grid::generate<core::int16_t>([](double raw) { ... });
+/// const core::int16_t centi_c = ntc_grid::interpolate(core::progmem_span(ntc_table), raw);
+/// @endcode
+///
+/// @tparam InputBits Width of the looked-up codes, 10 for the on-chip ADC (1-16)
+/// @tparam SegmentBits Log2 of the number of segments (0-InputBits)
+template <core::uint8_t InputBits, core::uint8_t SegmentBits>
+struct grid {
+    static_assert(InputBits >= 1 && InputBits <= 16, "Input codes must be 1 to 16 bits wide");
+    static_assert(SegmentBits <= InputBits, "At most one segment per code");
+    static_assert(InputBits - SegmentBits <= 15, "Interpolation product must fit in 32 bits");
+
+    static constexpr core::uint8_t shift = InputBits - SegmentBits; //< Log2 of the codes per segment
+    static constexpr core::size_t points = (core::size_t { 1 } << SegmentBits) + 1; //< Table size
+    static constexpr core::uint32_t max_code = (core::uint32_t { 1 } << InputBits) - 1;
+
+    /// @brief Code the curve is sampled at for table entry index
+    static constexpr core::uint32_t x(core::size_t index) noexcept
+    {
+        return static_cast<core::uint32_t>(index) << shift;
+    }
+
+    /// @brief Sample a curve into a table at compile time
+    /// @param[in] curve Callable taking the code as a double, returning the value to store; it is also
+    /// called one step past max_code
+    /// @tparam T Integral value type, results are rounded to nearest and saturated to its range
+    template <typename T, class Curve>
+    static constexpr table<T, points> generate(Curve curve) noexcept
+    {
+        table<T, points> result {};
+        for (core::size_t i = 0; i < points; ++i) {
+            result.values[i] = detail::round_saturate<T>(curve(static_cast<double>(x(i))));
+        }
+        return result;
+    }
+
+    /// @brief Interpolated value of the curve at code
+    /// @param[in] values Table of points entries made by generate(): a core::progmem_span in flash, or the
+    /// table itself in constant expressions or RAM
+    /// @param[in] code Input code, codes past max_code read the last entry
+    template <class Table>
+    static constexpr auto interpolate(const Table& values, core::uint16_t code) noexcept
+        -> remove_cvref_t<decltype(values[0])>
+    {
+        using value_type = remove_cvref_t<decltype(values[0])>;
+        static_assert(sizeof(value_type) <= 2, "Interpolation product must fit in 32 bits");
+
+        const core::uint16_t index = static_cast<core::uint16_t>(code >> shift);
+        if (index >= points - 1) {
+            return values[points - 1];
+        }
+        const value_type low = values[index];
+        if constexpr (shift == 0) {
+            return low;
+        } else {
+            constexpr core::uint16_t mask = static_cast<core::uint16_t>((1U << shift) - 1);
+            constexpr core::int32_t half = core::int32_t { 1 } << (shift - 1);
+            const core::int32_t delta = static_cast<core::int32_t>(values[index + 1]) - low;
+            // Arithmetic shift: rounds half up on falling segments too
+            return static_cast<value_type>(low + ((delta * (code & mask) + half) >> shift));
+        }
+    }
+};
+
+} // namespace core::lut
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core {
+
+/// Bit-packed storage of narrow unsigned samples
+///
+/// Samples of Bits bits are stored back-to-back as a little-endian bit stream: sample i occupies bits
+/// [i * Bits, (i + 1) * Bits) of the byte sequence, least significant bit first. For 10-bit ADC results
+/// four samples take five bytes instead of eight. The same layout is used on the wire by core::frame.
+
+/// @brief Bytes needed to store count samples of bits bits
+constexpr core::size_t packed_size(core::size_t bits, core::size_t count) noexcept
+{
+    return (bits * count + 7) / 8;
+}
+
+/// Non-owning view of bit-packed samples, the packed counterpart of core::span
+///
+/// Element access is unchecked. Samples are returned by value and written with set(), there are no
+/// element references. Bits up to 16 are supported; for widths where a sample never straddles more
+/// than two bytes (10, 12, 16 and all widths up to 9) accesses use 16-bit arithmetic only.
+///
+/// @tparam Bits Width of a sample (1-16)
+/// @tparam T Byte type, const core::uint8_t for read-only views
+template <core::uint8_t Bits, typename T = core::uint8_t>
+class packed_span {
+    static_assert(Bits >= 1 && Bits <= 16, "Packed samples must be 1 to 16 bits wide");
+
+public:
+    using value_type = core::uint16_t;
+    using size_type = core::size_t;
+
+    static constexpr core::uint8_t bits = Bits;
+    static constexpr value_type mask = static_cast<value_type>((1UL << Bits) - 1);
+
+    constexpr packed_span() noexcept = default;
+
+    /// @brief View count samples packed at data (unchecked, packed_size(Bits, count) bytes)
+    constexpr packed_span(T* data, size_type count) noexcept
+        : data_(data)
+        , size_(count)
+    {
+    }
+
+    /// @brief View count samples packed in bytes (unchecked, bytes must hold packed_size(Bits, count))
+    constexpr packed_span(span<T> bytes, size_type count) noexcept
+        : data_(bytes.data())
+        , size_(count)
+    {
+    }
+
+    /// @brief Sample i
+    constexpr value_type get(size_type index) const noexcept
+    {
+        const size_type bit = index * Bits;
+        const T* byte = data_ + (bit >> 3);
+        const core::uint8_t shift = bit & 7;
+        if constexpr (fits16) {
+            core::uint16_t word = byte[0];
+            if (shift + Bits > 8) {
+                word |= static_cast<unsigned>(byte[1]) << 8;
+            }
+            return static_cast<value_type>(word >> shift) & mask;
+        } else {
+            core::uint32_t word = byte[0] | static_cast<core::uint32_t>(byte[1]) << 8;
+            if (shift + Bits > 16) {
+                word |= static_cast<core::uint32_t>(byte[2]) << 16;
+            }
+            return static_cast<value_type>(word >> shift) & mask;
+        }
+    }
+
+    constexpr value_type operator[](size_type index) const noexcept { return get(index); }
+
+    /// @brief Overwrite sample i, bits above Bits are ignored
+    constexpr void set(size_type index, value_type value) const noexcept
+    {
+        const size_type bit = index * Bits;
+        T* byte = data_ + (bit >> 3);
+        const core::uint8_t shift = bit & 7;
+        value &= mask;
+        if constexpr (fits16) {
+            // unsigned keeps the shifts well-defined where int is 16 bits
+            const core::uint16_t clear = static_cast<core::uint16_t>(~(static_cast<unsigned>(mask) << shift));
+            const core::uint16_t bits_in = static_cast<core::uint16_t>(static_cast<unsigned>(value) << shift);
+            byte[0] = static_cast<core::uint8_t>((byte[0] & clear) | bits_in);
+            if (shift + Bits > 8) {
+                byte[1] = static_cast<core::uint8_t>((byte[1] & (clear >> 8)) | (bits_in >> 8));
+            }
+        } else {
+            const core::uint32_t clear = ~(static_cast<core::uint32_t>(mask) << shift);
+            const core::uint32_t bits_in = static_cast<core::uint32_t>(value) << shift;
+            byte[0] = static_cast<core::uint8_t>((byte[0] & clear) | bits_in);
+            byte[1] = static_cast<core::uint8_t>((byte[1] & (clear >> 8)) | (bits_in >> 8));
+            if (shift + Bits > 16) {
+                byte[2] = static_cast<core::uint8_t>((byte[2] & (clear >> 16)) | (bits_in >> 16));
+            }
+        }
+    }
+
+    /// @brief Number of samples
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief Underlying bytes, packed_size(Bits, size()) of them
+    constexpr span<T> bytes() const noexcept { return span<T>(data_, packed_size(Bits, size_)); }
+
+    /// @brief First count samples (unchecked)
+    constexpr packed_span first(size_type count) const noexcept { return packed_span(data_, count); }
+
+private:
+    /// Sample offsets within a byte are multiples of gcd(Bits, 8), the largest one is 8 - gcd(Bits, 8)
+    static constexpr core::uint8_t offset_step = (Bits & 7) == 0 ? 8 : (Bits & 3) == 0 ? 4 : (Bits & 1) == 0 ? 2 : 1;
+    /// A sample straddles at most two bytes when the largest offset plus the width fits 16 bits
+    static constexpr bool fits16 = 8 - offset_step + Bits <= 16;
+
+    T* data_ {};
+    size_type size_ {};
+};
+
+/// Fixed-capacity array of bit-packed samples
+///
+/// @code
+/// core::packed_array<10, 64> block; // 64 ADC samples in 80 bytes instead of 128
+/// block.set(0, 1023);
+/// uart_tx.write(block.bytes());
+/// @endcode
+///
+/// @tparam Bits Width of a sample (1-16)
+/// @tparam Count Number of samples
+template <core::uint8_t Bits, core::size_t Count>
+class packed_array {
+public:
+    using value_type = core::uint16_t;
+    using size_type = core::size_t;
+
+    static constexpr core::uint8_t bits = Bits;
+    static constexpr size_type byte_size = packed_size(Bits, Count);
+
+    constexpr value_type get(size_type index) const noexcept { return view().get(index); }
+    constexpr value_type operator[](size_type index) const noexcept { return get(index); }
+    constexpr void set(size_type index, value_type value) noexcept { view().set(index, value); }
+
+    static constexpr size_type size() noexcept { return Count; }
+
+    constexpr packed_span<Bits> view() noexcept { return packed_span<Bits>(span<core::uint8_t>(bytes_), Count); }
+    constexpr packed_span<Bits, const core::uint8_t> view() const noexcept
+    {
+        return packed_span<Bits, const core::uint8_t>(span<const core::uint8_t>(bytes_), Count);
+    }
+
+    constexpr span<core::uint8_t, byte_size> bytes() noexcept { return span<core::uint8_t, byte_size>(bytes_); }
+    constexpr span<const core::uint8_t, byte_size> bytes() const noexcept
+    {
+        return span<const core::uint8_t, byte_size>(bytes_);
+    }
+
+private:
+    core::uint8_t bytes_[byte_size] {};
+};
+
+/// @brief Pack samples into out, up to the smaller of both sizes
+/// @return Number of samples packed
+template <core::uint8_t Bits>
+constexpr core::size_t pack(span<const core::uint16_t> in, packed_span<Bits> out) noexcept
+{
+    // Sequential bit stream instead of per-sample read-modify-write, at most 7 + Bits bits pending
+    const core::size_t count = in.size() < out.size() ? in.size() : out.size();
+    core::uint8_t* byte = out.bytes().data();
+    core::uint32_t bits = 0;
+    core::uint8_t pending = 0;
+    for (core::size_t i = 0; i < count; ++i) {
+        bits |= static_cast<core::uint32_t>(in[i] & packed_span<Bits>::mask) << pending;
+        pending += Bits;
+        while (pending >= 8) {
+            *byte++ = static_cast<core::uint8_t>(bits);
+            bits >>= 8;
+            pending -= 8;
+        }
+    }
+    if (pending > 0) {
+        // Keep the bits of the samples following the packed range
+        *byte = static_cast<core::uint8_t>((*byte & (0xFFU << pending)) | bits);
+    }
+    return count;
+}
+
+/// @brief Unpack samples into out, up to the smaller of both sizes
+/// @return Number of samples unpacked
+template <core::uint8_t Bits, typename T>
+constexpr core::size_t unpack(packed_span<Bits, T> in, span<core::uint16_t> out) noexcept
+{
+    const core::size_t count = in.size() < out.size() ? in.size() : out.size();
+    for (core::size_t i = 0; i < count; ++i) {
+        out[i] = in.get(i);
+    }
+    return count;
+}
+
+} // namespace core
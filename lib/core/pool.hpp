@@ -0,0 +1,132 @@
+#pragma once
+
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "types.hpp"
+
+namespace core {
+
+namespace detail {
+
+    /// @brief Element type and element count of a pool block: T, or U[M] for array blocks
+    template <typename T>
+    struct pool_block {
+        using element_type = T;
+        static constexpr core::size_t size = 1;
+    };
+
+    template <typename U, core::size_t M>
+    struct pool_block<U[M]> {
+        using element_type = U;
+        static constexpr core::size_t size = M;
+    };
+
+} // namespace detail
+
+/// Fixed-block pool allocator with O(1) allocate and free
+///
+/// Holds N blocks of type T in a static array and threads the free ones on an index list. A block is a
+/// single T or, for array types, M elements: core::pool<uint16_t[32], 4> hands out spans of 32 samples.
+/// Blocks are default-initialized once at construction and keep their contents across reuse.
+/// free() rejects spans that do not come from the pool or are already free.
+/// @code
+/// core::pool<uint16_t[32], 4> blocks;
+/// auto block = blocks.allocate(); // span<uint16_t>, empty when exhausted
+/// ...
+/// blocks.free(block);
+/// @endcode
+///
+/// @tparam T Block type
+/// @tparam N Number of blocks (1-65533)
+template <typename T, core::size_t N>
+class pool {
+    static_assert(N > 0 && N <= 0xFFFD, "Pool size must be in [1, 65533]");
+
+public:
+    using element_type = typename detail::pool_block<T>::element_type;
+    /// Narrowest index type able to hold N plus two sentinels
+    using index_type = core::conditional_t<(N <= 0xFD), core::uint8_t, core::uint16_t>;
+
+    /// Elements per block
+    static constexpr core::size_t block_size = detail::pool_block<T>::size;
+
+    constexpr pool() noexcept { reset(); }
+
+    /// @brief Take a free block
+    /// @return Block of block_size elements, empty if the pool is exhausted
+    constexpr span<element_type> allocate() noexcept
+    {
+        if (free_ == end) {
+            return {};
+        }
+        const index_type index = free_;
+        free_ = next_[index];
+        next_[index] = in_use;
+        ++used_;
+        low_free_ = N - used_ < low_free_ ? static_cast<index_type>(N - used_) : low_free_;
+        return block(index);
+    }
+
+    /// @brief Return a block obtained from allocate()
+    /// @return false if the span is not a block of this pool or the block is already free
+    constexpr bool free(span<element_type> block) noexcept
+    {
+        const core::size_t index = index_of(block.data());
+        if (index >= N || next_[index] != in_use) {
+            return false;
+        }
+        next_[index] = free_;
+        free_ = static_cast<index_type>(index);
+        --used_;
+        return true;
+    }
+
+    /// @brief Mark every block free, outstanding spans must no longer be used
+    constexpr void reset() noexcept
+    {
+        for (core::size_t i = 0; i < N; ++i) {
+            next_[i] = static_cast<index_type>(i + 1);
+        }
+        free_ = 0;
+        used_ = 0;
+        low_free_ = N;
+    }
+
+    /// @brief Number of free blocks
+    constexpr core::size_t available() const noexcept { return N - used_; }
+
+    /// @brief Number of allocated blocks
+    constexpr core::size_t in_use_count() const noexcept { return used_; }
+
+    static constexpr core::size_t capacity() noexcept { return N; }
+
+    /// @brief Fewest free blocks seen since construction or reset()
+    constexpr core::size_t low_water() const noexcept { return low_free_; }
+
+private:
+    static constexpr index_type end = static_cast<index_type>(N); //< Free list terminator
+    static constexpr index_type in_use = static_cast<index_type>(N + 1); //< Allocated block marker
+
+    constexpr span<element_type> block(index_type index) noexcept
+    {
+        return span<element_type>(storage_ + index * block_size, block_size);
+    }
+
+    /// @brief Block index of data, N if data is not the start of a block
+    constexpr core::size_t index_of(const element_type* data) const noexcept
+    {
+        if (data < storage_ || data >= storage_ + N * block_size) {
+            return N;
+        }
+        const core::size_t offset = static_cast<core::size_t>(data - storage_);
+        return offset % block_size == 0 ? offset / block_size : N;
+    }
+
+    element_type storage_[N * block_size] {}; //< Blocks back-to-back, a single array keeps index_of() defined
+    index_type next_[N] {};
+    index_type free_ {};
+    index_type used_ {};
+    index_type low_free_ {};
+};
+
+} // namespace core
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "types.hpp"
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#endif
+
+/// Places a namespace-scope constant in flash on AVR (PROGMEM), no-op on the host
+///
+/// Flash data is not in the data address space on AVR: it must only be read through core::progmem::load()
+/// or a core::progmem_span, never dereferenced directly (constant-index reads in constant expressions
+/// are fine, the compiler folds them).
+/// @code
+/// constexpr core::uint16_t gains[] CORE_PROGMEM = { 1, 2, 4, 8 };
+/// @endcode
+#ifdef __AVR__
+#define CORE_PROGMEM PROGMEM
+#else
+#define CORE_PROGMEM
+#endif
+
+namespace core::progmem {
+
+/// @brief Read an object placed with CORE_PROGMEM: pgm_read_byte/word/dword (LPM) on AVR, a plain load on
+/// the host
+template <typename T>
+inline T load(const T* address) noexcept
+{
+#ifdef __AVR__
+    T value;
+    if constexpr (sizeof(T) == 1) {
+        const core::uint8_t bits = pgm_read_byte(address);
+        __builtin_memcpy(&value, &bits, sizeof(T));
+    } else if constexpr (sizeof(T) == 2) {
+        const core::uint16_t bits = pgm_read_word(address);
+        __builtin_memcpy(&value, &bits, sizeof(T));
+    } else if constexpr (sizeof(T) == 4) {
+        const core::uint32_t bits = pgm_read_dword(address);
+        __builtin_memcpy(&value, &bits, sizeof(T));
+    } else {
+        memcpy_P(&value, address, sizeof(T));
+    }
+    return value;
+#else
+    return *address;
+#endif
+}
+
+} // namespace core::progmem
+
+namespace core {
+
+/// Read-only view of a table placed in flash with CORE_PROGMEM
+///
+/// Same shape as core::span<const T>, except that elements are returned by value through
+/// core::progmem::load(): LPM reads on AVR, plain loads on the host, so code using it is unit-tested
+/// natively. There are no references into the table, and data() is a flash address on AVR.
+/// @code
+/// constexpr core::uint16_t gains[] CORE_PROGMEM = { 1, 2, 4, 8 };
+/// const core::progmem_span<core::uint16_t> table(gains);
+/// const core::uint16_t gain = table[index];
+/// @endcode
+///
+/// @tparam T Element type, trivially copyable
+template <typename T>
+class progmem_span {
+public:
+    using element_type = const T;
+    using value_type = remove_cv_t<T>;
+    using size_type = core::size_t;
+
+    /// Forward iterator reading one element per dereference
+    class iterator {
+    public:
+        constexpr explicit iterator(const value_type* address) noexcept
+            : address_(address)
+        {
+        }
+
+        value_type operator*() const noexcept { return progmem::load(address_); }
+
+        constexpr iterator& operator++() noexcept
+        {
+            ++address_;
+            return *this;
+        }
+
+        constexpr bool operator==(const iterator& other) const noexcept { return address_ == other.address_; }
+        constexpr bool operator!=(const iterator& other) const noexcept { return address_ != other.address_; }
+
+    private:
+        const value_type* address_;
+    };
+
+    /// @brief Empty view
+    constexpr progmem_span() noexcept = default;
+
+    /// @brief View of count elements at a flash address
+    constexpr progmem_span(const value_type* address, size_type count) noexcept
+        : ptr_(address)
+        , size_(count)
+    {
+    }
+
+    /// @brief View of a flash C-array with automatic size deduction
+    template <size_type N>
+    constexpr progmem_span(const value_type (&array)[N]) noexcept
+        : ptr_(array)
+        , size_(N)
+    {
+    }
+
+    /// @brief View of a flash table with data() and size(), e.g. a core::lut::table
+    template <class Container,
+        enable_if_t<has_data_and_size_v<const Container>
+                && is_same_v<remove_cv_t<container_element_t<const Container>>, value_type>,
+            int> = 0>
+    constexpr progmem_span(const Container& container) noexcept
+        : ptr_(container.data())
+        , size_(static_cast<size_type>(container.size()))
+    {
+    }
+
+    /// @brief Read the element at index (unchecked)
+    value_type operator[](size_type index) const noexcept { return progmem::load(ptr_ + index); }
+
+    /// @brief Read the first element (unchecked)
+    value_type front() const noexcept { return progmem::load(ptr_); }
+
+    /// @brief Read the last element (unchecked)
+    value_type back() const noexcept { return progmem::load(ptr_ + size_ - 1); }
+
+    /// @brief Flash address of the first element, not dereferenceable on AVR
+    constexpr const value_type* data() const noexcept { return ptr_; }
+
+    constexpr iterator begin() const noexcept { return iterator(ptr_); }
+    constexpr iterator end() const noexcept { return iterator(ptr_ + size_); }
+
+    constexpr size_type size() const noexcept { return size_; }
+    constexpr size_type size_bytes() const noexcept { return size_ * sizeof(value_type); }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    /// @brief View of the first count elements (unchecked)
+    constexpr progmem_span first(size_type count) const noexcept { return progmem_span(ptr_, count); }
+
+    /// @brief View of the last count elements (unchecked)
+    constexpr progmem_span last(size_type count) const noexcept
+    {
+        return progmem_span(ptr_ + (size_ - count), count);
+    }
+
+    /// @brief View of count elements from offset, the rest by default (unchecked)
+    constexpr progmem_span subspan(size_type offset, size_type count = dynamic_extent) const noexcept
+    {
+        return progmem_span(ptr_ + offset, count == dynamic_extent ? size_ - offset : count);
+    }
+
+private:
+    const value_type* ptr_ = nullptr;
+    size_type size_ = 0;
+};
+
+template <typename T, core::size_t N>
+progmem_span(const T (&)[N]) -> progmem_span<T>;
+
+template <class Container, enable_if_t<has_data_and_size_v<const Container>, int> = 0>
+progmem_span(const Container&) -> progmem_span<remove_cv_t<container_element_t<const Container>>>;
+
+} // namespace core
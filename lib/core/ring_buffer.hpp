@@ -0,0 +1,139 @@
+#pragma once
+
+#include "atomic.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core {
+
+/// Lock-free single-producer/single-consumer ring buffer with fixed capacity
+///
+/// Features:
+/// - Safe between one ISR and the main loop without disabling interrupts (or between two threads on host)
+/// - Single-byte free-running indices: full capacity usable, atomic on AVR
+/// - Element push/pop and in-place batch access through contiguous span reservations
+/// - No dynamic allocation, no exceptions
+///
+/// Batch protocol: the producer calls write_reserve(), fills a prefix of the returned span and publishes it
+/// with write_commit(n). The consumer calls read_reserve(), processes a prefix in place and frees it with
+/// read_commit(n). Reservations stop at the end of the storage, so a wrapped region takes two rounds.
+///
+/// @tparam T Element type
+/// @tparam N Capacity, power of two up to 128
+template <typename T, core::size_t N>
+class ring_buffer {
+    static_assert(N >= 2 && N <= 128, "Ring buffer capacity must be in [2, 128]");
+    static_assert((N & (N - 1)) == 0, "Ring buffer capacity must be a power of two");
+
+public:
+    using value_type = T;
+    using size_type = core::uint8_t;
+
+    /**
+     * @section Producer side
+     **/
+
+    /// @brief Append one element
+    /// @return false if the buffer is full, the element is not stored
+    bool push(const T& value) noexcept
+    {
+        const size_type head = head_.load_relaxed();
+        if (static_cast<size_type>(head - tail_.load_acquire()) == N) {
+            return false;
+        }
+        buffer_[head & mask] = value;
+        head_.store_release(head + 1);
+        return true;
+    }
+
+    /// @brief Contiguous free region starting at the write position (may be shorter than free())
+    span<T> write_reserve() noexcept
+    {
+        const size_type head = head_.load_relaxed();
+        const size_type available = N - static_cast<size_type>(head - tail_.load_acquire());
+        const size_type offset = head & mask;
+        const size_type contiguous = N - offset;
+        return span<T>(buffer_ + offset, available < contiguous ? available : contiguous);
+    }
+
+    /// @brief Publish the first count elements of the last write_reserve() (unchecked)
+    void write_commit(size_type count) noexcept { head_.store_release(head_.load_relaxed() + count); }
+
+    /**
+     * @section Consumer side
+     **/
+
+    /// @brief Remove the oldest element
+    /// @param[out] value Element, untouched if the buffer is empty
+    /// @return false if the buffer is empty
+    bool pop(T& value) noexcept
+    {
+        const size_type tail = tail_.load_relaxed();
+        if (tail == head_.load_acquire()) {
+            return false;
+        }
+        value = buffer_[tail & mask];
+        tail_.store_release(tail + 1);
+        return true;
+    }
+
+    /// @brief Contiguous readable region starting at the read position (may be shorter than size())
+    span<T> read_reserve() noexcept
+    {
+        const size_type tail = tail_.load_relaxed();
+        const size_type used = static_cast<size_type>(head_.load_acquire() - tail);
+        const size_type offset = tail & mask;
+        const size_type contiguous = N - offset;
+        return span<T>(buffer_ + offset, used < contiguous ? used : contiguous);
+    }
+
+    /// @brief Release the first count elements of the last read_reserve() (unchecked)
+    void read_commit(size_type count) noexcept { tail_.store_release(tail_.load_relaxed() + count); }
+
+    /// @brief Remove count elements located offset elements after the read position (unchecked).
+    ///        The offset elements in front are moved forward to close the gap, so the cost is O(offset).
+    void erase(size_type offset, size_type count) noexcept
+    {
+        const size_type tail = tail_.load_relaxed();
+        for (size_type i = offset; i-- > 0;) {
+            buffer_[(tail + count + i) & mask] = buffer_[(tail + i) & mask];
+        }
+        tail_.store_release(tail + count);
+    }
+
+    /**
+     * @section Observers
+     * Exact from either side for its own operations, a snapshot otherwise.
+     **/
+
+    /// @brief Number of stored elements
+    size_type size() const noexcept { return static_cast<size_type>(head_.load_acquire() - tail_.load_acquire()); }
+
+    /// @brief Number of free slots
+    size_type free() const noexcept { return N - size(); }
+
+    /// @brief Checks if the buffer is empty
+    bool empty() const noexcept { return size() == 0; }
+
+    /// @brief Checks if the buffer is full
+    bool full() const noexcept { return size() == N; }
+
+    /// @brief Maximum number of elements
+    static constexpr size_type capacity() noexcept { return N; }
+
+    /// @brief Drop all elements. Only valid while neither side is active.
+    void clear() noexcept
+    {
+        head_.store_release(0);
+        tail_.store_release(0);
+    }
+
+private:
+    static constexpr size_type mask = N - 1;
+
+    T buffer_[N] {};
+    core::atomic_u8 head_ {}; //< Written by the producer only
+    core::atomic_u8 tail_ {}; //< Written by the consumer only
+};
+
+} // namespace core
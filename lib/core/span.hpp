@@ -1,5 +1,6 @@
 #pragma once
 
+#include "type_traits.hpp"
 #include "types.hpp"
 
 namespace core {
@@ -7,23 +8,27 @@ namespace core {
 /// Basic std::span-like implementation focused on C-arrays
 ///
 /// Current features:
+/// - Dynamic extent (pointer + size) and static extent span<T, N> (pointer only)
 /// - C-array constructors with automatic size deduction
-/// - Iterator-based constructors (pointer + count, iterator range)
+/// - Contiguous iterator constructors (iterator + count, iterator range), pointers or opted-in class iterators
+/// - Container constructor from anything with data() and size() (std::array, std::vector, std::string...)
+/// - span<U> to span<const U> conversions, any qualification-only element conversion
 /// - Element access (operator[], front, back, data) - unchecked for performance
 /// - Iterator support (begin, end, cbegin, cend)
 /// - Observers (size, size_bytes, empty)
 /// - Subview operations (first, last, subspan) - unchecked for performance
+/// - Compile-time subviews (first<Count>, last<Count>, subspan<Offset, Count>) returning static extents
+/// - Static to dynamic extent conversion (implicit) and dynamic to static (explicit, unchecked)
 /// - Copy/assignment semantics
 /// - Constexpr compatible, no exceptions, no dynamic allocation
 ///
+/// Constructors are constrained with core::type_traits: element types must be array-convertible (T to
+/// const T, never derived to base or between integer types), so no overload is ambiguous and no view
+/// reinterprets its elements. Containers are only viewed by dynamic extent spans.
+///
 /// Missing features (future implementation):
-/// - std::array constructors (const std::array<U,N>&)
-/// - Range-based constructor (R&& r) for C++ containers
+/// - Static extent constructors from std::array and other containers
 /// - std::initializer_list constructor (C++26)
-/// - span-to-span conversion constructor
-/// - Static/dynamic extent template parameter distinction (span<T,N>)
-/// - explicit(extent != dynamic_extent) modifiers
-/// - Template constraints for iterator constructors (SFINAE/concepts)
 /// - Reverse iterators (rbegin, rend, crbegin, crend)
 /// - Comparison operators (==, !=, <, <=, >, >=)
 /// - Bounds checking variants (at() method)
@@ -33,8 +38,39 @@ namespace core {
 /// Value: SIZE_MAX (largest possible size_t value)
 inline constexpr core::size_t dynamic_extent = static_cast<core::size_t>(-1);
 
+template <typename T, core::size_t Extent = dynamic_extent>
+class span;
+
+namespace detail {
+
+    template <typename T>
+    struct is_span : false_type { };
+
+    template <typename T, core::size_t Extent>
+    struct is_span<span<T, Extent>> : true_type { };
+
+    /// @brief Contiguous iterator whose elements can be viewed as T
+    template <typename It, typename T, typename = void>
+    struct span_compatible_iterator : false_type { };
+
+    template <typename It, typename T>
+    struct span_compatible_iterator<It, T, enable_if_t<is_contiguous_iterator_v<It>>>
+        : bool_constant<is_array_convertible_v<iter_element_t<It>, T>> { };
+
+    /// @brief Container other than a span or C-array whose data() elements can be viewed as T
+    template <typename Container, typename T, typename = void>
+    struct span_compatible_container : false_type { };
+
+    template <typename Container, typename T>
+    struct span_compatible_container<Container, T, enable_if_t<has_data_and_size_v<Container>>>
+        : bool_constant<!is_span<remove_cv_t<Container>>::value && !is_array_v<Container>
+              && is_array_convertible_v<container_element_t<Container>, T>> { };
+
+} // namespace detail
+
+/// Dynamic extent: stores pointer and size
 template <typename T>
-class span {
+class span<T, dynamic_extent> {
 public:
     using element_type = T;
     using value_type = T;
@@ -47,6 +83,8 @@ public:
     using iterator = T*;
     using const_iterator = const T*;
 
+    static constexpr size_type extent = dynamic_extent;
+
     /**
      * @section Constructors and assignment
      **/
@@ -79,22 +117,49 @@ public:
     {
     }
 
-    // TODO(any): Reenable after adding type traits support
-    // Prevents ambiguous overload with pointer + count constructor
-    /// @brief Iterator-based constructor from pointer + count
-    // template <class It>
-    // constexpr span(It first, size_type count) noexcept
-    //     : ptr_(first)
-    //     , size_(count)
-    // {
-    // }
-    // /// @brief Iterator-based constructor from iterator range [first, last)
-    // template <class It, class End>
-    // constexpr span(It first, End last) noexcept
-    //     : ptr_(first)
-    //     , size_(last - first)
-    // {
-    // }
+    /// @brief Constructor from a contiguous iterator and element count
+    template <class It, enable_if_t<detail::span_compatible_iterator<It, T>::value, int> = 0>
+    constexpr span(It first, size_type count) noexcept
+        : ptr_(core::to_address(first))
+        , size_(count)
+    {
+    }
+
+    /// @brief Constructor from a contiguous iterator range [first, last)
+    /// An End convertible to size_type selects the iterator + count constructor instead.
+    template <class It, class End,
+        enable_if_t<detail::span_compatible_iterator<It, T>::value && is_contiguous_iterator_v<End>
+                && !is_convertible_v<End, size_type>,
+            int> = 0>
+    constexpr span(It first, End last) noexcept
+        : ptr_(core::to_address(first))
+        , size_(static_cast<size_type>(core::to_address(last) - core::to_address(first)))
+    {
+    }
+
+    /// @brief View of a contiguous container with data() and size(), without copying
+    template <class Container, enable_if_t<detail::span_compatible_container<Container, T>::value, int> = 0>
+    constexpr span(Container& container) noexcept(noexcept(container.data()) && noexcept(container.size()))
+        : ptr_(container.data())
+        , size_(static_cast<size_type>(container.size()))
+    {
+    }
+
+    /// @brief View of a const contiguous container, span<const T> only
+    template <class Container, enable_if_t<detail::span_compatible_container<const Container, T>::value, int> = 0>
+    constexpr span(const Container& container) noexcept(noexcept(container.data()) && noexcept(container.size()))
+        : ptr_(container.data())
+        , size_(static_cast<size_type>(container.size()))
+    {
+    }
+
+    /// @brief Conversion from a span of another extent or a less qualified element type (span<T> to span<const T>)
+    template <class U, size_type N, enable_if_t<is_array_convertible_v<U, T>, int> = 0>
+    constexpr span(const span<U, N>& other) noexcept
+        : ptr_(other.data())
+        , size_(other.size())
+    {
+    }
 
     /**
      * @section Iterators
@@ -123,9 +188,9 @@ public:
     constexpr reference back() const noexcept { return ptr_[size_ - 1]; }
 
     /// @brief Access element at index (unchecked)
-    /// @Todo: Ensure only unsigned integral types are used as index. Requires type traits support.
-    /// static_assert(std::is_unsigned<Index>::value, "Span index must be unsigned to prevent negative indexing");
-    /// static_assert(std::is_integral<Index>::value, "Span index must be an integral type");
+    /// @Todo: Ensure only unsigned integral types are used as index, once call sites no longer index with int.
+    /// static_assert(core::is_unsigned_v<Index>, "Span index must be unsigned to prevent negative indexing");
+    /// static_assert(core::is_integral_v<Index>, "Span index must be an integral type");
     constexpr reference operator[](size_type index) const noexcept { return ptr_[index]; }
 
     /// @brief Direct access to underlying data
@@ -160,9 +225,176 @@ public:
         return span(ptr_ + offset, count != dynamic_extent ? count : size_ - offset);
     }
 
+    /// @brief Returns static extent subspan of the first Count elements (unchecked)
+    template <size_type Count>
+    constexpr span<T, Count> first() const noexcept { return span<T, Count>(ptr_, Count); }
+
+    /// @brief Returns static extent subspan of the last Count elements (unchecked)
+    template <size_type Count>
+    constexpr span<T, Count> last() const noexcept { return span<T, Count>(ptr_ + size_ - Count, Count); }
+
+    /// @brief Returns subspan starting at Offset, with static extent Count or the remaining elements (unchecked)
+    template <size_type Offset, size_type Count = dynamic_extent>
+    constexpr span<T, Count> subspan() const noexcept
+    {
+        return span<T, Count>(ptr_ + Offset, Count != dynamic_extent ? Count : size_ - Offset);
+    }
+
 private:
     T* ptr_;
     size_type size_;
 };
 
+/// Static extent: the size is part of the type, only the pointer is stored
+/// Loops over size() have a compile-time trip count and can be fully unrolled.
+template <typename T, core::size_t Extent>
+class span {
+public:
+    using element_type = T;
+    using value_type = T;
+    using size_type = core::size_t;
+    using difference_type = core::ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_type extent = Extent;
+
+    /**
+     * @section Constructors and assignment
+     **/
+
+    /// @brief Copy constructor
+    constexpr span(const span& other) noexcept = default;
+
+    /// @brief Copy assignment
+    constexpr span& operator=(const span& other) noexcept = default;
+
+    /// @brief Constructor from pointer, count must equal Extent (unchecked)
+    constexpr explicit span(T* ptr, [[maybe_unused]] size_type count) noexcept
+        : ptr_(ptr)
+    {
+    }
+
+    /// @brief Constructor from C-array of exactly Extent elements
+    constexpr span(type_identity_t<element_type> (&array)[Extent]) noexcept
+        : ptr_(array)
+    {
+    }
+
+    /// @brief Constructor from a contiguous iterator, count must equal Extent (unchecked)
+    template <class It, enable_if_t<detail::span_compatible_iterator<It, T>::value, int> = 0>
+    constexpr explicit span(It first, [[maybe_unused]] size_type count) noexcept
+        : ptr_(core::to_address(first))
+    {
+    }
+
+    /// @brief Conversion from a span of the same extent and a less qualified element type
+    template <class U, enable_if_t<is_array_convertible_v<U, T>, int> = 0>
+    constexpr span(const span<U, Extent>& other) noexcept
+        : ptr_(other.data())
+    {
+    }
+
+    /// @brief Explicit conversion from a dynamic extent span, its size must equal Extent (unchecked)
+    template <class U, enable_if_t<is_array_convertible_v<U, T>, int> = 0>
+    constexpr explicit span(const span<U, dynamic_extent>& other) noexcept
+        : ptr_(other.data())
+    {
+    }
+
+    /**
+     * @section Iterators
+     **/
+
+    /// @brief Returns iterator to the beginning
+    constexpr iterator begin() const noexcept { return ptr_; }
+
+    /// @brief Returns iterator to the end
+    constexpr iterator end() const noexcept { return ptr_ + Extent; }
+
+    /// @brief Returns const iterator to the beginning
+    constexpr const_iterator cbegin() const noexcept { return ptr_; }
+
+    /// @brief Returns const iterator to the end
+    constexpr const_iterator cend() const noexcept { return ptr_ + Extent; }
+
+    /**
+     * @section Element access
+     **/
+
+    /// @brief Access first element (unchecked)
+    constexpr reference front() const noexcept { return ptr_[0]; }
+
+    /// @brief Access last element (unchecked)
+    constexpr reference back() const noexcept { return ptr_[Extent - 1]; }
+
+    /// @brief Access element at index (unchecked)
+    constexpr reference operator[](size_type index) const noexcept { return ptr_[index]; }
+
+    /// @brief Direct access to underlying data
+    constexpr T* data() const noexcept { return ptr_; }
+
+    /**
+     * @section Observers
+     **/
+
+    /// @brief Returns number of elements
+    static constexpr size_type size() noexcept { return Extent; }
+
+    /// @brief Returns size in bytes
+    static constexpr size_type size_bytes() noexcept { return Extent * sizeof(T); }
+
+    /// @brief Checks if span is empty
+    static constexpr bool empty() noexcept { return Extent == 0; }
+
+    /**
+     * @section Subviews
+     **/
+
+    /// @brief Returns static extent subspan of the first Count elements
+    template <size_type Count>
+    constexpr span<T, Count> first() const noexcept
+    {
+        static_assert(Count <= Extent, "Count exceeds span extent");
+        return span<T, Count>(ptr_, Count);
+    }
+
+    /// @brief Returns static extent subspan of the last Count elements
+    template <size_type Count>
+    constexpr span<T, Count> last() const noexcept
+    {
+        static_assert(Count <= Extent, "Count exceeds span extent");
+        return span<T, Count>(ptr_ + Extent - Count, Count);
+    }
+
+    /// @brief Returns static extent subspan starting at Offset with Count or the remaining elements
+    template <size_type Offset, size_type Count = dynamic_extent>
+    constexpr span<T, Count != dynamic_extent ? Count : Extent - Offset> subspan() const noexcept
+    {
+        static_assert(Offset <= Extent, "Offset exceeds span extent");
+        static_assert(Count == dynamic_extent || Count <= Extent - Offset, "Count exceeds span extent");
+        constexpr size_type size = Count != dynamic_extent ? Count : Extent - Offset;
+        return span<T, size>(ptr_ + Offset, size);
+    }
+
+    /// @brief Returns dynamic subspan of first count elements (unchecked)
+    constexpr span<T> first(size_type count) const noexcept { return span<T>(ptr_, count); }
+
+    /// @brief Returns dynamic subspan of last count elements (unchecked)
+    constexpr span<T> last(size_type count) const noexcept { return span<T>(ptr_ + Extent - count, count); }
+
+    /// @brief Returns dynamic subspan starting at offset with optional count (unchecked)
+    constexpr span<T> subspan(size_type offset, size_type count = dynamic_extent) const noexcept
+    {
+        return span<T>(ptr_ + offset, count != dynamic_extent ? count : Extent - offset);
+    }
+
+private:
+    T* ptr_;
+};
+
 } // namespace core
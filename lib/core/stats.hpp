@@ -0,0 +1,193 @@
+#pragma once
+
+#include "type_traits.hpp"
+#include "types.hpp"
+
+namespace core::stats {
+
+/// Fractional summary fields are fixed point with this many decimals (hundredths)
+inline constexpr core::uint8_t decimals = 2;
+inline constexpr core::uint32_t scale = 100;
+
+/// Statistics of a window of samples, all zero for an empty one
+struct summary {
+    core::uint16_t count;
+    core::uint16_t min;
+    core::uint16_t max;
+    core::uint32_t mean; //< Hundredths, rounded
+    core::uint32_t rms; //< Hundredths, rounded
+    core::uint32_t variance; //< Population variance in hundredths of a squared code, rounded
+};
+
+namespace detail {
+
+    /// @brief Square root rounded to nearest, bit by bit without division
+    constexpr core::uint32_t sqrt_round(core::uint64_t value) noexcept
+    {
+        core::uint64_t root = 0;
+        core::uint64_t bit = core::uint64_t { 1 } << 62;
+        while (bit > value) {
+            bit >>= 2;
+        }
+        while (bit != 0) {
+            if (value >= root + bit) {
+                value -= root + bit;
+                root = (root >> 1) + bit;
+            } else {
+                root >>= 1;
+            }
+            bit >>= 2;
+        }
+        // value is now the remainder n - root^2, round up past (root + 0.5)^2
+        return static_cast<core::uint32_t>(value > root ? root + 1 : root);
+    }
+
+} // namespace detail
+
+/// Online accumulator of count, sum, sum of squares, minimum and maximum
+///
+/// The integer counterpart of Welford's running mean and variance: with exact integer sums there is no
+/// cancellation to guard against, so a sample costs one 16x16 multiply and three additions, no division.
+/// Two accumulators merge by adding their sums (Chan's parallel form), which sliding windows use to
+/// combine their blocks. Mean, RMS and variance are only derived in result(), once per window.
+///
+/// @tparam MaxValue Largest sample, 1023 for 10-bit ADC codes (up to 8191)
+/// @tparam MaxCount Most samples accumulated; the sum of squares is 32-bit if MaxValue^2 * MaxCount fits
+template <core::uint16_t MaxValue = 1023, core::uint16_t MaxCount = 4096>
+class accumulator {
+    static_assert(MaxValue > 0 && MaxValue <= 8191, "Summaries of up to 13-bit samples fit their fields");
+    static_assert(MaxCount > 0, "An accumulator holds at least one sample");
+
+public:
+    static constexpr core::uint16_t max_value = MaxValue;
+    static constexpr core::uint16_t max_count = MaxCount;
+
+    using sum_type = core::uint32_t;
+    using square_sum_type = conditional_t<(core::uint64_t { MaxValue } * MaxValue * MaxCount <= 0xFFFFFFFFU),
+        core::uint32_t, core::uint64_t>;
+
+    /// @brief Add one sample (at most MaxValue, at most MaxCount samples since reset(), unchecked)
+    constexpr void add(core::uint16_t value) noexcept
+    {
+        ++count_;
+        sum_ += value;
+        squares_ += static_cast<core::uint32_t>(value) * value;
+        min_ = value < min_ ? value : min_;
+        max_ = value > max_ ? value : max_;
+    }
+
+    /// @brief Add the samples of another accumulator (at most MaxCount in total, unchecked)
+    constexpr void merge(const accumulator& other) noexcept
+    {
+        count_ += other.count_;
+        sum_ += other.sum_;
+        squares_ += other.squares_;
+        min_ = other.min_ < min_ ? other.min_ : min_;
+        max_ = other.max_ > max_ ? other.max_ : max_;
+    }
+
+    constexpr void reset() noexcept { *this = accumulator(); }
+
+    constexpr core::uint16_t count() const noexcept { return count_; }
+    constexpr sum_type sum() const noexcept { return sum_; }
+    constexpr square_sum_type sum_of_squares() const noexcept { return squares_; }
+
+    /// @brief Summary of the samples so far
+    constexpr summary result() const noexcept
+    {
+        if (count_ == 0) {
+            return {};
+        }
+        const core::uint64_t n = count_;
+        const core::uint64_t sum = sum_;
+        const core::uint64_t squares = squares_;
+        const core::uint64_t n2 = n * n;
+        // n * sum(x^2) - sum(x)^2 is n^2 times the variance, exact and never negative
+        const core::uint64_t spread = n * squares - sum * sum;
+        return {
+            count_,
+            min_,
+            max_,
+            static_cast<core::uint32_t>((sum * scale + n / 2) / n),
+            detail::sqrt_round((squares * scale * scale + n / 2) / n),
+            static_cast<core::uint32_t>((spread * scale + n2 / 2) / n2),
+        };
+    }
+
+private:
+    sum_type sum_ {};
+    square_sum_type squares_ {};
+    core::uint16_t count_ {};
+    core::uint16_t min_ = 0xFFFF;
+    core::uint16_t max_ {};
+};
+
+/// Sliding window of Hop * Blocks samples advancing by Hop samples
+///
+/// The window is split into Blocks accumulators of Hop samples. Each completed block merges the last
+/// Blocks into a summary, so RAM is Blocks accumulators whatever the window length, no sample is stored,
+/// and min/max stay exact. The first summary comes once the window is full. With Blocks = 1 windows do
+/// not overlap, see core::stats::tumbling.
+/// @code
+/// core::stats::sliding<16, 4> window; // 64 samples, a summary every 16
+/// if (window.add(sample)) {
+///     send(window.last());
+/// }
+/// @endcode
+///
+/// @tparam Hop Samples between two summaries
+/// @tparam Blocks Window length in hops
+/// @tparam MaxValue Largest sample
+template <core::uint16_t Hop, core::uint8_t Blocks, core::uint16_t MaxValue = 1023>
+class sliding {
+    static_assert(Hop > 0 && Blocks > 0, "Windows hold at least one sample");
+    static_assert(core::uint32_t { Hop } * Blocks <= 0xFFFF, "Window length must fit in 16 bits");
+
+public:
+    static constexpr core::uint16_t length = Hop * Blocks;
+    static constexpr core::uint16_t hop = Hop;
+
+    using accumulator_type = accumulator<MaxValue, length>;
+
+    /// @brief Add one sample
+    /// @return true if it completed a window, whose summary is then available through last()
+    constexpr bool add(core::uint16_t value) noexcept
+    {
+        blocks_[current_].add(value);
+        if (blocks_[current_].count() < Hop) {
+            return false;
+        }
+        if (filled_ < Blocks) {
+            ++filled_;
+        }
+        const bool full = filled_ == Blocks;
+        if (full) {
+            accumulator_type window = blocks_[0];
+            for (core::uint8_t i = 1; i < Blocks; ++i) {
+                window.merge(blocks_[i]);
+            }
+            last_ = window.result();
+        }
+        current_ = current_ + 1 < Blocks ? current_ + 1 : 0;
+        blocks_[current_].reset();
+        return full;
+    }
+
+    /// @brief Summary of the last completed window
+    constexpr const summary& last() const noexcept { return last_; }
+
+    /// @brief Drop every sample, the next summary comes after a full window again
+    constexpr void reset() noexcept { *this = sliding(); }
+
+private:
+    accumulator_type blocks_[Blocks] {};
+    summary last_ {};
+    core::uint8_t current_ {};
+    core::uint8_t filled_ {};
+};
+
+/// Non-overlapping windows of Length samples, one summary each
+template <core::uint16_t Length, core::uint16_t MaxValue = 1023>
+using tumbling = sliding<Length, 1, MaxValue>;
+
+} // namespace core::stats
@@ -0,0 +1,340 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace core {
+
+/// Subset of <type_traits> (C++17) for toolchains without a standard library, such as avr-gcc
+///
+/// Names and semantics follow the standard, so code can switch to std:: without changes. Only what core
+/// needs is provided: constants, enable_if/conditional, cv/reference/pointer manipulation, declval and
+/// void_t, a few primary and property categories, is_convertible, and the iterator and container
+/// detection the span constructors are constrained with.
+
+/**
+ * @section Helper classes
+ **/
+
+/// @brief Compile-time constant of type T
+template <typename T, T Value>
+struct integral_constant {
+    using value_type = T;
+    using type = integral_constant;
+    static constexpr T value = Value;
+    constexpr operator value_type() const noexcept { return value; }
+    constexpr value_type operator()() const noexcept { return value; }
+};
+
+template <bool Value>
+using bool_constant = integral_constant<bool, Value>;
+
+using true_type = bool_constant<true>;
+using false_type = bool_constant<false>;
+
+/**
+ * @section Conditional type selection
+ **/
+
+/// @brief type is T if Condition holds, missing otherwise (removes overloads from resolution)
+template <bool Condition, typename T = void>
+struct enable_if { };
+
+template <typename T>
+struct enable_if<true, T> {
+    using type = T;
+};
+
+template <bool Condition, typename T = void>
+using enable_if_t = typename enable_if<Condition, T>::type;
+
+/// @brief type is Then if Condition holds, Else otherwise
+template <bool Condition, typename Then, typename Else>
+struct conditional {
+    using type = Then;
+};
+
+template <typename Then, typename Else>
+struct conditional<false, Then, Else> {
+    using type = Else;
+};
+
+template <bool Condition, typename Then, typename Else>
+using conditional_t = typename conditional<Condition, Then, Else>::type;
+
+/**
+ * @section Type relationships
+ **/
+
+template <typename T, typename U>
+struct is_same : false_type { };
+
+template <typename T>
+struct is_same<T, T> : true_type { };
+
+template <typename T, typename U>
+inline constexpr bool is_same_v = is_same<T, U>::value;
+
+/**
+ * @section Const-volatility, reference and pointer modifications
+ **/
+
+template <typename T>
+struct remove_const {
+    using type = T;
+};
+
+template <typename T>
+struct remove_const<const T> {
+    using type = T;
+};
+
+template <typename T>
+struct remove_volatile {
+    using type = T;
+};
+
+template <typename T>
+struct remove_volatile<volatile T> {
+    using type = T;
+};
+
+template <typename T>
+struct remove_cv {
+    using type = typename remove_const<typename remove_volatile<T>::type>::type;
+};
+
+template <typename T>
+struct remove_reference {
+    using type = T;
+};
+
+template <typename T>
+struct remove_reference<T&> {
+    using type = T;
+};
+
+template <typename T>
+struct remove_reference<T&&> {
+    using type = T;
+};
+
+/// @brief Backport of std::remove_cvref (C++20)
+template <typename T>
+struct remove_cvref {
+    using type = typename remove_cv<typename remove_reference<T>::type>::type;
+};
+
+template <typename T>
+struct remove_pointer {
+    using type = T;
+};
+
+template <typename T>
+struct remove_pointer<T*> {
+    using type = T;
+};
+
+template <typename T>
+struct remove_pointer<T* const> {
+    using type = T;
+};
+
+template <typename T>
+struct remove_pointer<T* volatile> {
+    using type = T;
+};
+
+template <typename T>
+struct remove_pointer<T* const volatile> {
+    using type = T;
+};
+
+template <typename T>
+using remove_const_t = typename remove_const<T>::type;
+template <typename T>
+using remove_volatile_t = typename remove_volatile<T>::type;
+template <typename T>
+using remove_cv_t = typename remove_cv<T>::type;
+template <typename T>
+using remove_reference_t = typename remove_reference<T>::type;
+template <typename T>
+using remove_cvref_t = typename remove_cvref<T>::type;
+template <typename T>
+using remove_pointer_t = typename remove_pointer<T>::type;
+
+/**
+ * @section Unevaluated operands
+ **/
+
+/// @brief Reference to T for use in decltype and sizeof only, never defined
+template <typename T>
+T&& declval() noexcept;
+
+/// @brief void for any well-formed list of types, the building block of expression detection
+template <typename...>
+using void_t = void;
+
+/**
+ * @section Type categories and properties
+ **/
+
+template <typename T>
+struct is_const : false_type { };
+
+template <typename T>
+struct is_const<const T> : true_type { };
+
+namespace detail {
+
+    template <typename T>
+    struct is_pointer : false_type { };
+
+    template <typename T>
+    struct is_pointer<T*> : true_type { };
+
+    template <typename T>
+    struct is_integral : false_type { };
+
+    // clang-format off
+    template <> struct is_integral<bool> : true_type { };
+    template <> struct is_integral<char> : true_type { };
+    template <> struct is_integral<signed char> : true_type { };
+    template <> struct is_integral<unsigned char> : true_type { };
+    template <> struct is_integral<wchar_t> : true_type { };
+    template <> struct is_integral<char16_t> : true_type { };
+    template <> struct is_integral<char32_t> : true_type { };
+    template <> struct is_integral<short> : true_type { };
+    template <> struct is_integral<unsigned short> : true_type { };
+    template <> struct is_integral<int> : true_type { };
+    template <> struct is_integral<unsigned int> : true_type { };
+    template <> struct is_integral<long> : true_type { };
+    template <> struct is_integral<unsigned long> : true_type { };
+    template <> struct is_integral<long long> : true_type { };
+    template <> struct is_integral<unsigned long long> : true_type { };
+    // clang-format on
+
+    template <typename T, bool Integral = is_integral<T>::value>
+    struct is_unsigned : bool_constant<(T(0) < T(-1))> { };
+
+    template <typename T>
+    struct is_unsigned<T, false> : false_type { };
+
+} // namespace detail
+
+template <typename T>
+struct is_pointer : detail::is_pointer<remove_cv_t<T>> { };
+
+template <typename T>
+struct is_array : false_type { };
+
+template <typename T>
+struct is_array<T[]> : true_type { };
+
+template <typename T, core::size_t N>
+struct is_array<T[N]> : true_type { };
+
+template <typename T>
+struct is_integral : detail::is_integral<remove_cv_t<T>> { };
+
+/// @brief Unsigned integral types, bool included (floating point is not supported)
+template <typename T>
+struct is_unsigned : detail::is_unsigned<remove_cv_t<T>> { };
+
+template <typename T>
+inline constexpr bool is_const_v = is_const<T>::value;
+template <typename T>
+inline constexpr bool is_pointer_v = is_pointer<T>::value;
+template <typename T>
+inline constexpr bool is_array_v = is_array<T>::value;
+template <typename T>
+inline constexpr bool is_integral_v = is_integral<T>::value;
+template <typename T>
+inline constexpr bool is_unsigned_v = is_unsigned<T>::value;
+
+/**
+ * @section Conversions
+ **/
+
+namespace detail {
+
+    template <typename To>
+    void convert_to(To) noexcept;
+
+    template <typename From, typename To, typename = void>
+    struct is_convertible : false_type { };
+
+    template <typename From, typename To>
+    struct is_convertible<From, To, void_t<decltype(convert_to<To>(declval<From>()))>> : true_type { };
+
+} // namespace detail
+
+/// @brief Whether From converts implicitly to To (void to void included, arrays and functions as To are not)
+template <typename From, typename To>
+struct is_convertible
+    : bool_constant<detail::is_convertible<From, To>::value
+          || (is_same_v<remove_cv_t<From>, void> && is_same_v<remove_cv_t<To>, void>)> { };
+
+template <typename From, typename To>
+inline constexpr bool is_convertible_v = is_convertible<From, To>::value;
+
+/// @brief Whether an array of From can be viewed as an array of To: only adds qualifiers (T to const T), no
+/// derived to base or numeric conversions, which would change the element size or representation
+template <typename From, typename To>
+inline constexpr bool is_array_convertible_v = is_convertible_v<From (*)[], To (*)[]>;
+
+/**
+ * @section Iterators and containers
+ **/
+
+/// @brief Iterator over elements adjacent in memory, so that [first, first + n) is the array at to_address(first)
+///
+/// Pointers are. Without the standard library contiguity of a class iterator cannot be detected (a deque
+/// iterator has the same interface as a vector one), so class iterators opt in with a specialization:
+/// @code
+/// template <> struct core::is_contiguous_iterator<my_buffer::iterator> : core::true_type { };
+/// @endcode
+template <typename It>
+struct is_contiguous_iterator : is_pointer<It> { };
+
+template <typename It>
+inline constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<It>::value;
+
+/// @brief Address of the element a contiguous iterator refers to, without dereferencing it (end() is valid)
+template <typename T>
+constexpr T* to_address(T* pointer) noexcept
+{
+    return pointer;
+}
+
+template <typename It>
+constexpr auto to_address(const It& it) noexcept -> decltype(core::to_address(it.operator->()))
+{
+    return core::to_address(it.operator->());
+}
+
+/// @brief Element type a contiguous iterator refers to, cv-qualifiers kept
+template <typename It>
+using iter_element_t = remove_pointer_t<decltype(core::to_address(declval<It&>()))>;
+
+namespace detail {
+
+    template <typename Container, typename = void>
+    struct has_data_and_size : false_type { };
+
+    template <typename Container>
+    struct has_data_and_size<Container,
+        void_t<decltype(declval<Container&>().data()), decltype(declval<Container&>().size())>>
+        : is_pointer<decltype(declval<Container&>().data())> { };
+
+} // namespace detail
+
+/// @brief Whether Container stores its elements contiguously behind data() and size(), e.g. std::array,
+/// std::vector, std::string or a core::span
+template <typename Container>
+inline constexpr bool has_data_and_size_v = detail::has_data_and_size<Container>::value;
+
+/// @brief Element type of a container with data() and size(), cv-qualifiers kept (const for const containers)
+template <typename Container>
+using container_element_t = remove_pointer_t<decltype(declval<Container&>().data())>;
+
+} // namespace core
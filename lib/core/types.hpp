@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #else
 #include <cstddef>
+#include <cstdint>
 #endif
 
 namespace core {
@@ -11,9 +12,25 @@ namespace core {
 #ifdef ARDUINO
 using size_t = ::size_t;
 using ptrdiff_t = ::ptrdiff_t;
+using uint8_t = ::uint8_t;
+using uint16_t = ::uint16_t;
+using uint32_t = ::uint32_t;
+using uint64_t = ::uint64_t;
+using int8_t = ::int8_t;
+using int16_t = ::int16_t;
+using int32_t = ::int32_t;
+using int64_t = ::int64_t;
 #else
 using size_t = ::std::size_t;
 using ptrdiff_t = ::std::ptrdiff_t;
+using uint8_t = ::std::uint8_t;
+using uint16_t = ::std::uint16_t;
+using uint32_t = ::std::uint32_t;
+using uint64_t = ::std::uint64_t;
+using int8_t = ::std::int8_t;
+using int16_t = ::std::int16_t;
+using int32_t = ::std::int32_t;
+using int64_t = ::std::int64_t;
 #endif
 
 /// Helper for type deduction in constructors (C++17 backport of std::type_identity)
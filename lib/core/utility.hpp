@@ -1,21 +1,8 @@
 #pragma once
 
-namespace core {
-
-template<typename T>
-struct remove_reference {
-    using type = T;
-};
+#include "type_traits.hpp"
 
-template<typename T>
-struct remove_reference<T&> {
-    using type = T;
-};
-
-template<typename T>
-struct remove_reference<T&&> {
-    using type = T;
-};
+namespace core {
 
 template<typename T>
 constexpr typename remove_reference<T>::type&& move(T&& t) noexcept {
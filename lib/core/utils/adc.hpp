@@ -2,13 +2,23 @@
 
 #include <Arduino.h>
 
+#include "adc_converter.hpp"
+#include "adc_oversampler.hpp"
+#include "fmt.hpp"
+#include "span.hpp"
+
 namespace core::adc {
 
 using ADC_raw = uint16_t; //< ADC value in raw format (0-1023 for 10-bit ADC).
 using ADC_mv = float; //< ADC value in millivolts (0-5000 mV for 10-bit ADC with 5V reference).
+using ADC_mv_int = uint16_t; //< ADC value in whole millivolts, integer path without soft-float.
+
+/// @brief On-chip ADC: 10-bit with a 5V (AVcc) reference.
+using default_converter = converter<10, 5000>;
 
 /// @brief Convert raw ADC value to millivolts.
 ///        Assumes a 10-bit ADC (0-1023) with a 5V reference (0-5000mV).
+///        Float facade kept for compatibility, prefer raw_to_mv_int() on hot paths.
 /// @param[in] raw_adc Raw ADC value.
 /// @return Voltage in millivolts
 constexpr ADC_mv raw_to_mv(uint16_t raw_adc)
@@ -18,6 +28,24 @@ constexpr ADC_mv raw_to_mv(uint16_t raw_adc)
     return raw_adc * adc_scale;
 }
 
+/// @brief Convert raw ADC value to whole millivolts (rounded to nearest) in integer arithmetic.
+/// @param[in] raw_adc Raw ADC value (0-1023).
+/// @return Voltage in millivolts
+constexpr ADC_mv_int raw_to_mv_int(ADC_raw raw_adc)
+{
+    return default_converter::to_mv(raw_adc);
+}
+
+/// @brief Convert an oversampled result of the on-chip ADC to whole millivolts.
+/// @tparam ExtraBits Extra resolution of the core::adc::oversampler that produced the value.
+/// @param[in] value Decimated value (0 to 1023 * 2^ExtraBits).
+/// @return Voltage in millivolts
+template <uint8_t ExtraBits>
+constexpr ADC_mv_int oversampled_to_mv(uint16_t value)
+{
+    return oversampler<ExtraBits>::template mv_converter<default_converter::vref_mv>::to_mv(value);
+}
+
 /// @brief Read ADC value in raw format from a pin.
 /// @param[in] pin Analog pin to read from.
 inline ADC_raw read_raw(uint8_t pin)
@@ -32,21 +60,29 @@ inline ADC_mv read_mv(uint8_t pin)
     return raw_to_mv(read_raw(pin));
 }
 
-// @brief Convert ADC_Value to a string representation.
-inline String to_string(ADC_raw value_raw)
+/// @brief Append an ADC value as "raw, mv" to a writer.
+constexpr core::fmt::writer& format(core::fmt::writer& out, ADC_raw value_raw)
 {
-    char buffer[16] {};
-
-    const auto value_mv = raw_to_mv(value_raw);
-    const auto result = snprintf(buffer, sizeof(buffer), "%u, %u", value_raw, static_cast<uint16_t>(value_mv));
-    if (result < 0 || static_cast<size_t>(result) >= sizeof(buffer)) {
-        return F("Err, Err");
-    }
+    return out.append_uint(value_raw).append(", ").append_uint(raw_to_mv_int(value_raw));
+}
 
-    return buffer;
+/// @brief Format an ADC value as "raw, mv" into a caller-provided buffer, without heap allocation.
+/// @param[in] value_raw Raw ADC value.
+/// @param[out] buffer Destination, 10 characters are enough for any 10-bit value.
+/// @return Written subspan of buffer (not null-terminated), empty if it does not fit.
+constexpr core::span<char> to_string(ADC_raw value_raw, core::span<char> buffer)
+{
+    core::fmt::writer out(buffer);
+    format(out, value_raw);
+    return out.ok() ? out.written() : buffer.first(0);
 }
 
 } // namespace core::adc
 
 static_assert(core::adc::raw_to_mv(0) == 0.0);
 static_assert(core::adc::raw_to_mv(1023) == 5000U);
+static_assert(core::adc::raw_to_mv_int(0) == 0U);
+static_assert(core::adc::raw_to_mv_int(512) == 2502U);
+static_assert(core::adc::raw_to_mv_int(1023) == 5000U);
+static_assert(core::adc::oversampled_to_mv<3>(8184) == 5000U);
+static_assert(core::adc::default_converter::uses_reciprocal, "Hot path must not fall back to 32-bit division");
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace core::adc {
+
+/// @brief Rounding applied when converting ADC codes to millivolts.
+enum class rounding : core::uint8_t {
+    nearest, //< Round half up to the nearest millivolt
+    toward_zero, //< Truncate, same as casting the float result to an integer
+};
+
+namespace detail {
+
+    /// @brief Q-format reciprocal: value = (raw * multiplier + offset) >> shift
+    struct reciprocal {
+        bool found;
+        core::uint8_t shift;
+        core::uint32_t multiplier;
+        core::uint32_t offset;
+    };
+
+    /// @brief Try a multiplier/shift pair, returning the smallest valid rounding offset if any.
+    constexpr reciprocal try_reciprocal(core::uint16_t max_raw, core::uint16_t vref_mv, core::uint32_t bias,
+        core::uint8_t shift, core::uint64_t multiplier)
+    {
+        const core::int64_t scale = core::int64_t { 1 } << shift;
+        core::int64_t lo = 0;
+        core::int64_t hi = scale;
+        // Every code needs expected * 2^shift <= raw * multiplier + offset < (expected + 1) * 2^shift
+        for (core::uint32_t raw = 0; raw <= max_raw && lo < hi; ++raw) {
+            const core::int64_t product = static_cast<core::int64_t>(raw * multiplier);
+            const core::int64_t expected = (static_cast<core::uint32_t>(raw) * vref_mv + bias) / max_raw;
+            const core::int64_t min_offset = expected * scale - product;
+            const core::int64_t max_offset = (expected + 1) * scale - product;
+            lo = min_offset > lo ? min_offset : lo;
+            hi = max_offset < hi ? max_offset : hi;
+        }
+        const bool fits = max_raw * multiplier + static_cast<core::uint64_t>(lo) <= core::uint32_t(-1);
+        return { lo < hi && fits, shift, static_cast<core::uint32_t>(multiplier), static_cast<core::uint32_t>(lo) };
+    }
+
+    /// @brief Search the smallest shift whose reciprocal is exact for every code and fits in 32 bits.
+    constexpr reciprocal find_reciprocal(core::uint16_t max_raw, core::uint16_t vref_mv, core::uint32_t bias)
+    {
+        for (core::uint8_t shift = 0; shift < 32; ++shift) {
+            const core::uint64_t floor = (static_cast<core::uint64_t>(vref_mv) << shift) / max_raw;
+            if (max_raw * floor > core::uint32_t(-1)) {
+                break;
+            }
+            for (core::uint64_t multiplier = floor; multiplier <= floor + 1; ++multiplier) {
+                const auto candidate = try_reciprocal(max_raw, vref_mv, bias, shift, multiplier);
+                if (candidate.found) {
+                    return candidate;
+                }
+            }
+        }
+        return { false, 0, 0, 0 };
+    }
+
+} // namespace detail
+
+/// @brief Integer code to millivolt converter for an arbitrary full-scale code and reference voltage.
+///
+/// Computes round(raw * VrefMv / MaxRaw) without floating point. At compile time it searches for a
+/// Q-format reciprocal (multiplier, rounding offset, shift) such that
+///     (raw * multiplier + offset) >> shift
+/// matches the exact quotient for every code, with the product fitting in 32 bits. On the AVR that is a
+/// single 16x32 multiply and a shift instead of soft-float or a 32-bit division. When no such reciprocal
+/// exists for the parameters, to_mv() falls back to the exact 32-bit division.
+///
+/// @tparam MaxRaw Full-scale code, converted to VrefMv (1-16383)
+/// @tparam VrefMv Reference voltage in millivolts
+/// @tparam Round Rounding mode
+template <core::uint16_t MaxRaw, core::uint16_t VrefMv, rounding Round = rounding::nearest>
+class scaled_converter {
+    static_assert(MaxRaw >= 1 && MaxRaw <= 0x3FFF, "Full-scale code must be in [1, 16383]");
+    static_assert(VrefMv > 0, "Reference voltage must be positive");
+
+public:
+    using raw_type = core::uint16_t;
+    using mv_type = core::uint16_t;
+
+    static constexpr raw_type max_raw = MaxRaw; //< Full-scale code
+    static constexpr mv_type vref_mv = VrefMv;
+
+private:
+    static constexpr core::uint32_t bias = Round == rounding::nearest ? max_raw / 2 : 0;
+    static constexpr detail::reciprocal reciprocal = detail::find_reciprocal(max_raw, VrefMv, bias);
+
+public:
+    /// @brief Reference conversion using an exact 32-bit division.
+    /// @param[in] raw Code in [0, max_raw] (unchecked)
+    static constexpr mv_type to_mv_exact(raw_type raw) noexcept
+    {
+        return static_cast<mv_type>((static_cast<core::uint32_t>(raw) * VrefMv + bias) / max_raw);
+    }
+
+    /// @brief Fast conversion, bit-exact with to_mv_exact() for every code.
+    /// @param[in] raw Code in [0, max_raw] (unchecked)
+    static constexpr mv_type to_mv(raw_type raw) noexcept
+    {
+        if constexpr (reciprocal.found) {
+            return static_cast<mv_type>((static_cast<core::uint32_t>(raw) * reciprocal.multiplier + reciprocal.offset)
+                >> reciprocal.shift);
+        } else {
+            return to_mv_exact(raw);
+        }
+    }
+
+    /// @brief True when to_mv() runs on the multiply-shift path
+    static constexpr bool uses_reciprocal = reciprocal.found;
+};
+
+/// @brief Converter for a Bits-wide ADC whose full-scale code 2^Bits - 1 reads VrefMv.
+/// @tparam Bits ADC resolution in bits (1-14)
+/// @tparam VrefMv Reference voltage in millivolts
+/// @tparam Round Rounding mode
+template <core::uint8_t Bits, core::uint16_t VrefMv, rounding Round = rounding::nearest>
+class converter : public scaled_converter<static_cast<core::uint16_t>((1U << Bits) - 1), VrefMv, Round> {
+    static_assert(Bits >= 1 && Bits <= 14, "ADC resolution must be in [1, 14] bits");
+
+public:
+    static constexpr core::uint8_t bits = Bits;
+};
+
+} // namespace core::adc
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "adc_converter.hpp"
+#include "type_traits.hpp"
+#include "types.hpp"
+
+namespace core::adc {
+
+/// @brief Oversampling and decimation engine for ExtraBits of additional resolution.
+///
+/// Accumulates 4^ExtraBits consecutive samples and decimates the sum by 2^ExtraBits (rounded), turning
+/// noisy InputBits-wide samples into an (InputBits + ExtraBits)-wide result. Runs one sample at a time,
+/// only the running sum is stored. The input noise must span at least 1 LSB for the extra bits to be real.
+///
+/// The full-scale result is max_input * 2^ExtraBits (8184 for 3 extra bits over 10-bit input), not
+/// 2^output_bits - 1, so millivolts are converted with mv_converter, which uses that full scale.
+///
+/// @tparam ExtraBits Additional bits of resolution (1-4), costs 4^ExtraBits input samples per result
+/// @tparam InputBits Resolution of the input samples
+template <core::uint8_t ExtraBits, core::uint8_t InputBits = 10>
+class oversampler {
+    static_assert(ExtraBits >= 1 && ExtraBits <= 4, "Oversampling must add 1 to 4 bits");
+    static_assert(InputBits + ExtraBits <= 14, "Output resolution must not exceed 14 bits");
+
+public:
+    static constexpr core::uint16_t window = 1U << (2 * ExtraBits); //< Input samples per result
+    static constexpr core::uint8_t output_bits = InputBits + ExtraBits;
+    static constexpr core::uint16_t max_input = (1U << InputBits) - 1;
+    static constexpr core::uint16_t full_scale = max_input << ExtraBits; //< Largest result
+
+    /// 16-bit accumulator whenever the window sum and rounding term fit, e.g. up to 3 extra bits over 10
+    using accumulator_type = core::conditional_t<
+        static_cast<core::uint32_t>(window) * max_input + (1U << (ExtraBits - 1)) <= 0xFFFF, core::uint16_t,
+        core::uint32_t>;
+
+    /// @brief Millivolt converter for results of this oversampler
+    template <core::uint16_t VrefMv, rounding Round = rounding::nearest>
+    using mv_converter = scaled_converter<full_scale, VrefMv, Round>;
+
+    /// @brief Add one input sample.
+    /// @param[in] sample Input sample in [0, max_input] (unchecked)
+    /// @return true when a window completed and value() holds a new result
+    constexpr bool push(core::uint16_t sample) noexcept
+    {
+        sum_ += sample;
+        if (++count_ != window) {
+            return false;
+        }
+        value_ = static_cast<core::uint16_t>((sum_ + (1U << (ExtraBits - 1))) >> ExtraBits);
+        sum_ = 0;
+        count_ = 0;
+        return true;
+    }
+
+    /// @brief Last decimated result in [0, full_scale]
+    constexpr core::uint16_t value() const noexcept { return value_; }
+
+    /// @brief Samples accumulated in the current window
+    constexpr core::uint16_t pending() const noexcept { return count_; }
+
+    /// @brief Discard the current window
+    constexpr void reset() noexcept
+    {
+        sum_ = 0;
+        count_ = 0;
+    }
+
+private:
+    accumulator_type sum_ {};
+    core::uint16_t count_ {};
+    core::uint16_t value_ {};
+};
+
+} // namespace core::adc
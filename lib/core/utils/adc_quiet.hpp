@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+#include "adc_sampler.hpp"
+#include "adc_schedule.hpp"
+#include "span.hpp"
+
+namespace core::adc {
+
+/// @brief Multi-channel ADC scanner converting in ADC Noise Reduction sleep mode, for the ATmega328P.
+///
+/// Same schedule, tagged samples and draining interface as core::adc::scanner, but conversions are taken on
+/// demand by acquire(): the CPU sleeps through each conversion and wakes on ADC_vect, so neither the core nor
+/// the I/O clock (timers, UART) switch next to the converter while it samples. Cleaner conversions need less
+/// averaging, and the CPU draws idle current while converting.
+///
+/// The I/O clock is halted while asleep: a byte on the UART wire would be stretched, so only acquire() with
+/// the transmitter idle (core::uart::transmitter::idle()), and expect Timer0 (millis()) and Timer2 (the
+/// core::sched tick) to fall behind by the conversion time. Interrupts must be enabled. The application owns
+/// the vector and forwards it:
+/// @code
+/// core::adc::quiet_scanner<32, 2> adc_scanner(channels);
+/// ISR(ADC_vect) { adc_scanner.on_conversion(); }
+/// ...
+/// if (uart_tx.idle()) {
+///     adc_scanner.acquire(8);
+/// }
+/// @endcode
+///
+/// @tparam Capacity Buffer slots, power of two up to 128.
+/// @tparam Channels Number of scanned channels.
+template <uint8_t Capacity, uint8_t Channels>
+class quiet_scanner {
+public:
+    explicit quiet_scanner(const channel_config (&config)[Channels])
+        : sequencer_(config)
+    {
+    }
+
+    /// @brief Enable the ADC in single-conversion mode (AVcc reference) at the first channel.
+    /// @param[in] clock ADC clock prescaler, a conversion takes 13 ADC clocks.
+    void start(prescaler clock = prescaler::div128)
+    {
+        stop();
+        early_wakes_ = 0;
+        ADMUX = _BV(REFS0) | (sequencer_.restart() & 0x07);
+        ADCSRB = 0;
+        ADCSRA = _BV(ADEN) | _BV(ADIE) | static_cast<uint8_t>(clock);
+    }
+
+    /// @brief Disable the conversion interrupt, acquire() returns at once afterwards.
+    void stop() { ADCSRA &= ~_BV(ADIE); }
+
+    /// @brief Convert the next samples of the schedule, sleeping through every conversion.
+    ///
+    /// A mux switch costs one discarded settling conversion, as with core::adc::scanner. Stops early when
+    /// the buffer is full, so samples are never dropped. Blocks for about count conversion times (104 us
+    /// each with div128 at 16 MHz).
+    /// @param[in] count Samples wanted.
+    /// @return Number of samples stored.
+    uint8_t acquire(uint8_t count)
+    {
+        uint8_t stored = 0;
+        while (stored < count && !sequencer_.full() && bit_is_set(ADCSRA, ADIE)) {
+            const bool kept = !sequencer_.settling();
+            if (sequencer_.on_conversion(convert())) {
+                ADMUX = _BV(REFS0) | (sequencer_.channel() & 0x07);
+            }
+            stored += kept;
+        }
+        return stored;
+    }
+
+    /// @brief Pop the oldest tagged sample.
+    /// @param[out] sample Sample, untouched if the buffer is empty.
+    /// @return true if a sample was read.
+    bool pop(tagged_sample& sample) { return sequencer_.pop(sample); }
+
+    /// @brief Contiguous block of tagged samples, processed in place and released with release().
+    core::span<tagged_sample> peek() { return sequencer_.peek(); }
+
+    /// @brief Release the first count samples of the last peek().
+    void release(uint8_t count) { sequencer_.release(count); }
+
+    /// @brief Number of samples ready to be drained.
+    uint8_t available() const { return sequencer_.available(); }
+
+    /// @brief Wake-ups by another interrupt (pin change, INT0/1, watchdog) before the conversion completed.
+    uint16_t early_wakes() const { return early_wakes_; }
+
+    /// @brief Conversion complete handler. Must only be called from ADC_vect.
+    void on_conversion()
+    {
+        value_ = ADC;
+        converted_ = true;
+    }
+
+private:
+    /// @brief One conversion of the current mux channel with the CPU asleep
+    uint16_t convert()
+    {
+        converted_ = false;
+        set_sleep_mode(SLEEP_MODE_ADC);
+        sleep_enable();
+        // Entering the sleep mode would start the conversion by itself, but simulators do not model that.
+        // Starting it here is equivalent: sample-and-hold happens 1.5 ADC clocks (192 CPU cycles with div128)
+        // after the start, long after the CPU went to sleep.
+        ADCSRA |= _BV(ADSC);
+        for (;;) {
+            cli();
+            if (converted_) {
+                break;
+            }
+            // sei takes effect after sleep: ADC_vect cannot fire between the check and the sleep
+            sei();
+            sleep_cpu();
+            if (!converted_) {
+                ++early_wakes_;
+            }
+        }
+        sei();
+        sleep_disable();
+        return value_;
+    }
+
+    scan_sequencer<Capacity, Channels> sequencer_;
+    volatile uint16_t value_ {};
+    volatile bool converted_ {};
+    uint16_t early_wakes_ {};
+};
+
+} // namespace core::adc
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+#include "adc.hpp"
+#include "ring_buffer.hpp"
+#include "span.hpp"
+
+namespace core::adc {
+
+/// @brief ADC clock prescaler (ADPS2:0 bits of ADCSRA).
+///        A conversion takes 13 ADC clocks, so at 16 MHz div128 yields ~9.6 kS/s.
+enum class prescaler : uint8_t {
+    div16 = 0b100,
+    div32 = 0b101,
+    div64 = 0b110,
+    div128 = 0b111,
+};
+
+/// @brief Start free-running conversions with the conversion interrupt enabled (AVcc reference).
+///        The application's ADC_vect handler reads ADC for every result.
+/// @param[in] channel Mux channel (0-7).
+/// @param[in] clock ADC clock prescaler.
+inline void start_free_running(uint8_t channel, prescaler clock = prescaler::div128)
+{
+    ADMUX = _BV(REFS0) | (channel & 0x07);
+    ADCSRB = 0; // ADTS2:0 = 0 -> free-running mode
+    ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIE) | static_cast<uint8_t>(clock);
+}
+
+/// @brief Interrupt-driven free-running ADC sampler for the ATmega328P.
+///
+/// The ADC runs in free-running auto-trigger mode, so conversions are started back-to-back by the
+/// hardware. Each result is pushed by the ADC_vect ISR into a fixed-size buffer and the main loop only
+/// drains completed samples. Samples arriving while the buffer is full are dropped and counted.
+///
+/// The library is header-only, so the application owns the interrupt vector and forwards it:
+/// @code
+/// core::adc::sampler<32> adc_sampler;
+/// ISR(ADC_vect) { adc_sampler.on_conversion(); }
+/// @endcode
+///
+/// @tparam Capacity Buffer slots, power of two up to 128.
+template <uint8_t Capacity>
+class sampler {
+public:
+    /// @brief Start free-running conversions on an analog pin (AVcc reference).
+    /// @param[in] pin Analog pin (A0-A7) or channel number (0-7).
+    /// @param[in] clock ADC clock prescaler.
+    void start(uint8_t pin, prescaler clock = prescaler::div128)
+    {
+        stop();
+        samples_.clear();
+        overruns_ = 0;
+
+        start_free_running(pin_to_channel(pin), clock);
+    }
+
+    /// @brief Stop conversions and disable the ADC interrupt. Buffered samples remain readable.
+    void stop() { ADCSRA &= ~(_BV(ADATE) | _BV(ADIE)); }
+
+    /// @brief Pop the oldest completed sample.
+    /// @param[out] value Sample, untouched if the buffer is empty.
+    /// @return true if a sample was read.
+    bool pop(ADC_raw& value) { return samples_.pop(value); }
+
+    /// @brief Contiguous block of completed samples, processed in place and released with release().
+    core::span<ADC_raw> peek() { return samples_.read_reserve(); }
+
+    /// @brief Release the first count samples of the last peek().
+    void release(uint8_t count) { samples_.read_commit(count); }
+
+    /// @brief Number of samples ready to be drained.
+    uint8_t available() const { return samples_.size(); }
+
+    /// @brief Number of samples dropped because the buffer was full.
+    uint16_t overruns() const
+    {
+        uint16_t count;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { count = overruns_; }
+        return count;
+    }
+
+    /// @brief Conversion complete handler. Must only be called from ADC_vect.
+    void on_conversion()
+    {
+        const ADC_raw value = ADC;
+        if (!samples_.push(value)) {
+            ++overruns_;
+        }
+    }
+
+private:
+    /// @brief Map an Arduino analog pin to its mux channel, same as analogRead does.
+    static constexpr uint8_t pin_to_channel(uint8_t pin) { return pin >= A0 ? pin - A0 : pin; }
+
+    core::ring_buffer<ADC_raw, Capacity> samples_ {};
+    volatile uint16_t overruns_ {};
+};
+
+} // namespace core::adc
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+#include "adc_sampler.hpp"
+#include "adc_schedule.hpp"
+#include "span.hpp"
+
+namespace core::adc {
+
+/// @brief Interrupt-driven multi-channel ADC scanner for the ATmega328P.
+///
+/// Converts the channels of a core::adc::scan_schedule back-to-back in single-conversion mode: the
+/// ADC_vect handler stores the result, programs the mux for the next channel and restarts the ADC, so
+/// the main loop never blocks on a conversion. The register accesses are all here; the schedule, the
+/// settling conversion after a mux switch and the buffer are core::adc::scan_sequencer, shared with the
+/// native replay.
+///
+/// Samples are tagged with their channel. Samples arriving while the buffer is full are dropped and
+/// counted. The application owns the interrupt vector and forwards it:
+/// @code
+/// constexpr core::adc::channel_config channels[] = { { 0, 1 }, { 1, 4 } }; // A0 at 4x the rate of A1
+/// core::adc::scanner<32, 2> adc_scanner(channels);
+/// ISR(ADC_vect) { adc_scanner.on_conversion(); }
+/// @endcode
+///
+/// @tparam Capacity Buffer slots, power of two up to 128.
+/// @tparam Channels Number of scanned channels.
+template <uint8_t Capacity, uint8_t Channels>
+class scanner {
+public:
+    explicit scanner(const channel_config (&config)[Channels])
+        : sequencer_(config)
+    {
+    }
+
+    /// @brief Start scanning from the first channel (AVcc reference).
+    /// @param[in] clock ADC clock prescaler, a conversion takes 13 ADC clocks.
+    void start(prescaler clock = prescaler::div128)
+    {
+        stop();
+        ADMUX = _BV(REFS0) | (sequencer_.restart() & 0x07);
+        ADCSRB = 0;
+        ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADIE) | static_cast<uint8_t>(clock);
+    }
+
+    /// @brief Stop after the conversion in progress. Buffered samples remain readable.
+    void stop() { ADCSRA &= ~_BV(ADIE); }
+
+    /// @brief Pop the oldest tagged sample.
+    /// @param[out] sample Sample, untouched if the buffer is empty.
+    /// @return true if a sample was read.
+    bool pop(tagged_sample& sample) { return sequencer_.pop(sample); }
+
+    /// @brief Contiguous block of tagged samples, processed in place and released with release().
+    core::span<tagged_sample> peek() { return sequencer_.peek(); }
+
+    /// @brief Release the first count samples of the last peek().
+    void release(uint8_t count) { sequencer_.release(count); }
+
+    /// @brief Number of samples ready to be drained.
+    uint8_t available() const { return sequencer_.available(); }
+
+    /// @brief Number of samples dropped because the buffer was full.
+    uint16_t overruns() const
+    {
+        uint16_t count;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { count = sequencer_.overruns(); }
+        return count;
+    }
+
+    /// @brief Conversion complete handler. Must only be called from ADC_vect.
+    void on_conversion()
+    {
+        const uint16_t value = ADC;
+        if (sequencer_.on_conversion(value)) {
+            ADMUX = _BV(REFS0) | (sequencer_.channel() & 0x07);
+        }
+        ADCSRA |= _BV(ADSC);
+    }
+
+private:
+    scan_sequencer<Capacity, Channels> sequencer_;
+};
+
+} // namespace core::adc
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::adc {
+
+/// @brief One scanned input: mux channel and its rate divisor.
+struct channel_config {
+    core::uint8_t channel; //< Mux channel (0-7), i.e. pin - A0
+    core::uint8_t divisor; //< Sampled once every divisor rounds (1-255)
+};
+
+/// @brief Channel-tagged sample: mux channel in bits 15:12, 10-bit result in bits 9:0.
+///
+/// Packed in 16 bits so a tagged buffer costs the same RAM as an untagged one.
+struct tagged_sample {
+    core::uint16_t bits;
+
+    static constexpr tagged_sample make(core::uint8_t channel, core::uint16_t value)
+    {
+        return { static_cast<core::uint16_t>((static_cast<core::uint16_t>(channel) << 12) | (value & 0x03FF)) };
+    }
+
+    constexpr core::uint8_t channel() const { return static_cast<core::uint8_t>(bits >> 12); }
+    constexpr core::uint16_t value() const { return bits & 0x03FF; }
+};
+
+/// @brief Round-robin scan order with per-channel rate divisors.
+///
+/// Every round visits the configured channels in order and yields those that are due; a channel with
+/// divisor d is due every d-th round, starting with the first. With divisors {1, 4} the sequence is
+/// 0 1 0 0 0 0 1 0 ..., so channel 0 gets four times the rate of channel 1. Rounds with no channel due
+/// are skipped, which makes rates relative to the fastest channel; keep one divisor at 1 so next() never
+/// needs more than one pass over the channels.
+///
+/// Pure bookkeeping with no hardware access, driven by core::adc::scan_sequencer.
+///
+/// @tparam Channels Number of scanned channels.
+template <core::uint8_t Channels>
+class scan_schedule {
+    static_assert(Channels > 0, "At least one channel must be scanned");
+
+public:
+    constexpr explicit scan_schedule(const channel_config (&config)[Channels])
+    {
+        for (core::uint8_t i = 0; i < Channels; ++i) {
+            channels_[i] = config[i].channel;
+            divisors_[i] = config[i].divisor > 0 ? config[i].divisor : 1;
+        }
+        reset();
+    }
+
+    /// @brief Restart at the first channel of a round where every channel is due.
+    constexpr void reset()
+    {
+        for (auto& countdown : countdowns_) {
+            countdown = 0;
+        }
+        index_ = 0;
+    }
+
+    /// @brief Mux channel of the next conversion.
+    constexpr core::uint8_t next()
+    {
+        for (;;) {
+            for (; index_ < Channels; ++index_) {
+                auto& countdown = countdowns_[index_];
+                if (countdown == 0) {
+                    countdown = divisors_[index_] - 1;
+                    return channels_[index_++];
+                }
+                --countdown;
+            }
+            index_ = 0;
+        }
+    }
+
+    /// @brief Number of scanned channels.
+    static constexpr core::uint8_t size() { return Channels; }
+
+private:
+    core::uint8_t channels_[Channels] {};
+    core::uint8_t divisors_[Channels] {};
+    core::uint8_t countdowns_[Channels] {}; //< Rounds left until due
+    core::uint8_t index_ {}; //< Position in the current round
+};
+
+/// @brief Hardware-free core of the ADC scanners: schedule, settling conversions and the tagged sample buffer.
+///
+/// The scanners read the conversion result and hand it to on_conversion(), which stores it and tells them
+/// when to program the mux for the next channel; the native replay (lib/host/replay.hpp) drives the same
+/// object with trace samples. The first conversion after a mux switch only lets the sample-and-hold
+/// capacitor settle on the new source and is discarded, consecutive conversions of the same channel are
+/// all kept, so a switch costs one extra conversion and staying costs nothing.
+///
+/// @tparam Capacity Buffer slots, power of two up to 128.
+/// @tparam Channels Number of scanned channels.
+template <core::uint8_t Capacity, core::uint8_t Channels>
+class scan_sequencer {
+public:
+    constexpr explicit scan_sequencer(const channel_config (&config)[Channels])
+        : schedule_(config)
+    {
+    }
+
+    /// @brief Empty the buffer and restart the schedule, the next conversion settles on its first channel.
+    /// @return Mux channel of the first conversion.
+    core::uint8_t restart()
+    {
+        samples_.clear();
+        overruns_ = 0;
+        schedule_.reset();
+        current_ = schedule_.next();
+        settling_ = true;
+        return current_;
+    }
+
+    /// @brief Handle the result of the conversion of channel(). Samples arriving while the buffer is full
+    /// are dropped and counted.
+    /// @return true if the mux must be switched to channel() before the next conversion.
+    bool on_conversion(core::uint16_t value)
+    {
+        if (settling_) {
+            // The mux already points at current_
+            settling_ = false;
+            return false;
+        }
+        if (!samples_.push(tagged_sample::make(current_, value))) {
+            ++overruns_;
+        }
+        const core::uint8_t next = schedule_.next();
+        if (next == current_) {
+            return false;
+        }
+        current_ = next;
+        settling_ = true;
+        return true;
+    }
+
+    /// @brief Mux channel of the conversion in progress.
+    core::uint8_t channel() const { return current_; }
+
+    /// @brief Whether the conversion in progress follows a mux switch and will be discarded.
+    bool settling() const { return settling_; }
+
+    bool pop(tagged_sample& sample) { return samples_.pop(sample); }
+    core::span<tagged_sample> peek() { return samples_.read_reserve(); }
+    void release(core::uint8_t count) { samples_.read_commit(count); }
+    core::uint8_t available() const { return samples_.size(); }
+    bool full() const { return samples_.full(); }
+
+    /// @brief Samples dropped because the buffer was full, read with the conversion interrupt masked.
+    core::uint16_t overruns() const { return overruns_; }
+
+private:
+    scan_schedule<Channels> schedule_;
+    core::ring_buffer<tagged_sample, Capacity> samples_ {};
+    volatile core::uint16_t overruns_ {};
+    core::uint8_t current_ {}; //< Channel of the conversion in progress
+    bool settling_ {}; //< Conversion in progress follows a mux switch
+};
+
+} // namespace core::adc
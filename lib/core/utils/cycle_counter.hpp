@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Arduino.h>
+
+namespace core::cycles {
+
+/// CPU cycles counted by Timer1 running at clk/1: wraps every 65536 cycles (4.096 ms at 16 MHz).
+/// Differences of two readings are exact for intervals shorter than that, unsigned wraparound included.
+using count = uint16_t;
+
+/// @brief Run Timer1 as a free-running CPU cycle counter (normal mode, no prescaler).
+///        Takes Timer1 from the Arduino core: analogWrite() on pins 9 and 10 stops working.
+inline void start()
+{
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TCCR1C = 0;
+    TIMSK1 = 0;
+    TCNT1 = 0;
+}
+
+/// @brief Current cycle count. A 16-bit read of TCNT1, atomic in hardware through the TEMP register
+///        as long as no ISR also reads 16-bit Timer1 registers.
+inline count now()
+{
+    return TCNT1;
+}
+
+/// @brief Cycles elapsed since a previous reading.
+inline count since(count start)
+{
+    return static_cast<count>(now() - start);
+}
+
+} // namespace core::cycles
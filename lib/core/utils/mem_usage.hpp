@@ -0,0 +1,98 @@
+#pragma once
+
+#include "fmt.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::mem {
+
+/// Byte painted over free RAM at boot. Any other value means the stack reached that address (a stack byte
+/// that happens to hold the pattern at the boundary makes the peak read a few bytes low).
+inline constexpr core::uint8_t paint_pattern = 0xC5;
+
+/// @brief Fill region with the paint pattern
+constexpr void paint(span<core::uint8_t> region, core::uint8_t pattern = paint_pattern) noexcept
+{
+    for (auto& byte : region) {
+        byte = pattern;
+    }
+}
+
+/// @brief Number of leading bytes of region still holding the paint pattern.
+///
+/// The stack grows down towards the heap, so scanning a painted region upwards from its low end stops at the
+/// deepest address the stack ever reached: the result is the free RAM that was never used.
+constexpr core::size_t untouched(span<const core::uint8_t> region, core::uint8_t pattern = paint_pattern) noexcept
+{
+    core::size_t count = 0;
+    while (count < region.size() && region[count] == pattern) {
+        ++count;
+    }
+    return count;
+}
+
+/// Boundaries of the SRAM regions, as addresses
+///
+///     | .data .bss | heap -> | free | <- stack |
+///     data_start   static_end  heap_end  stack_pointer  ram_end
+struct ram_layout {
+    core::uint16_t data_start; //< First byte of .data
+    core::uint16_t static_end; //< One past the last byte of .bss (start of the heap)
+    core::uint16_t heap_end; //< One past the last byte handed out by malloc(), static_end if unused
+    core::uint16_t stack_pointer; //< Next free stack byte
+    core::uint16_t ram_end; //< Last byte of SRAM
+};
+
+/// RAM usage in bytes
+struct usage {
+    core::uint16_t static_bytes; //< .data + .bss
+    core::uint16_t heap_bytes; //< Heap in use (String, malloc)
+    core::uint16_t stack_bytes; //< Current stack depth
+    core::uint16_t stack_peak; //< Deepest stack since boot
+    core::uint16_t free_bytes; //< Between heap and stack right now
+    core::uint16_t free_min; //< Smallest gap between heap and stack since boot
+};
+
+/// @brief Usage figures of a layout
+/// @param[in] layout Current region boundaries
+/// @param[in] untouched_bytes Painted bytes above heap_end never written, see untouched()
+constexpr usage summarize(const ram_layout& layout, core::uint16_t untouched_bytes) noexcept
+{
+    const core::uint16_t stack_bytes = static_cast<core::uint16_t>(layout.ram_end - layout.stack_pointer);
+    // The byte at the stack pointer is free: static + heap + free + stack always add up to the whole SRAM
+    const core::uint16_t free_bytes = layout.stack_pointer + 1 >= layout.heap_end
+        ? static_cast<core::uint16_t>(layout.stack_pointer + 1 - layout.heap_end)
+        : 0;
+    const core::uint16_t free_min = untouched_bytes < free_bytes ? untouched_bytes : free_bytes;
+    return {
+        static_cast<core::uint16_t>(layout.static_end - layout.data_start),
+        static_cast<core::uint16_t>(layout.heap_end - layout.static_end),
+        stack_bytes,
+        static_cast<core::uint16_t>(layout.ram_end + 1 - layout.heap_end - free_min),
+        free_bytes,
+        free_min,
+    };
+}
+
+/// CSV header of format()
+inline constexpr char report_header[] = "ram,static,heap,stack,stack_peak,free,free_min\r\n";
+
+/// @brief Append one CRLF-terminated report line, e.g. "ram,412,0,38,187,1598,1449"
+inline fmt::writer& format(fmt::writer& out, const usage& figures) noexcept
+{
+    return out.append("ram,")
+        .append_uint(figures.static_bytes)
+        .append(',')
+        .append_uint(figures.heap_bytes)
+        .append(',')
+        .append_uint(figures.stack_bytes)
+        .append(',')
+        .append_uint(figures.stack_peak)
+        .append(',')
+        .append_uint(figures.free_bytes)
+        .append(',')
+        .append_uint(figures.free_min)
+        .append("\r\n");
+}
+
+} // namespace core::mem
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "adc.hpp"
+#include "adc_schedule.hpp"
+#include "fmt.hpp"
+#include "frame.hpp"
+#include "span.hpp"
+#include "stats.hpp"
+#include "trigger.hpp"
+
+namespace core::output {
+
+/// Serial output format
+enum class mode : core::uint8_t {
+    csv, //< "channel, raw, mv" text lines
+    binary, //< COBS-framed sample batches, see core::frame
+};
+
+/// Longest "channel, raw, mv" line, CRLF included
+inline constexpr core::uint8_t csv_line_size = 20;
+
+/// @brief Format one sample as a "channel, raw, mv" line and hand it to the sink
+/// @return false if the sink did not queue it
+template <class Sink>
+bool send_csv(Sink& sink, core::uint8_t channel, core::uint16_t raw)
+{
+    char line[csv_line_size];
+    core::fmt::writer out(line);
+    out.append_uint(channel).append(", ");
+    core::adc::format(out, raw).append("\r\n");
+    return sink.write(out.written().data(), out.size());
+}
+
+/// Longest "stats,channel,count,mean,min,max,rms,variance" line, CRLF included
+inline constexpr core::uint8_t summary_line_size = 64;
+
+/// @brief Format a window summary as a "stats,channel,count,mean,min,max,rms,variance" line (fractional
+/// fields with core::stats::decimals) and hand it to the sink
+/// @return false if the sink did not queue it
+template <class Sink>
+bool send_summary(Sink& sink, core::uint8_t channel, const core::stats::summary& window)
+{
+    char line[summary_line_size];
+    core::fmt::writer out(line);
+    out.append("stats,")
+        .append_uint(channel)
+        .append(',')
+        .append_uint(window.count)
+        .append(',')
+        .append_fixed(static_cast<core::int32_t>(window.mean), core::stats::decimals)
+        .append(',')
+        .append_uint(window.min)
+        .append(',')
+        .append_uint(window.max)
+        .append(',')
+        .append_fixed(static_cast<core::int32_t>(window.rms), core::stats::decimals)
+        .append(',')
+        .append_fixed(static_cast<core::int32_t>(window.variance), core::stats::decimals)
+        .append("\r\n");
+    return sink.write(out.written().data(), out.size());
+}
+
+/// Output stage of the firmware, between the sample buffers and the serial link
+///
+/// Formats tagged samples from a core::adc::scanner-like source (pop(), peek(), release()) or the windows of
+/// a core::trigger::capture, and queues the records on a core::uart::transmitter-like sink (write() of a
+/// byte span or of text, false when the record was not queued). In CSV mode a stream can also be reduced
+/// to one summary line per core::stats window instead. Free of hardware access, so the firmware
+/// and the native replay (tools/replay/) run the same formatting and framing code.
+/// @code
+/// core::output::stage<core::output::mode::binary, 16> output;
+/// while (adc_scanner.available() != 0) {
+///     output.send_next(adc_scanner, uart_tx);
+/// }
+/// @endcode
+///
+/// @tparam Mode Output format
+/// @tparam MaxSamples Most samples per binary frame (the encode buffer is on the stack)
+/// @tparam Encoding Sample encoding of binary frames
+template <mode Mode, core::uint8_t MaxSamples, core::frame::encoding Encoding = core::frame::encoding::raw16>
+class stage {
+    static_assert(MaxSamples > 0, "MaxSamples must be at least 1");
+
+public:
+    /// @brief Queue the next record of a stream: one CSV line, or one frame of the next run of same-channel
+    /// samples. A record the sink drops is lost, binary frames still consume their sequence number so the
+    /// receiver sees the gap.
+    /// @return false if the source was empty
+    template <class Source, class Sink>
+    bool send_next(Source& source, Sink& sink)
+    {
+        if constexpr (Mode == mode::binary) {
+            const auto samples = source.peek();
+            if (samples.empty()) {
+                return false;
+            }
+            const core::uint8_t channel = samples[0].channel();
+            core::uint16_t values[MaxSamples];
+            core::uint8_t count = 0;
+            while (count < samples.size() && count < MaxSamples && samples[count].channel() == channel) {
+                values[count] = samples[count].value();
+                ++count;
+            }
+            send_frame(sink, channel, core::span<const core::uint16_t>(values, count));
+            ++sequence_;
+            source.release(count);
+        } else {
+            core::adc::tagged_sample sample;
+            if (!source.pop(sample)) {
+                return false;
+            }
+            send_csv(sink, sample.channel(), sample.value());
+        }
+        return true;
+    }
+
+    /// @brief Feed the next sample of a stream into the window of its channel, queue a summary line when the
+    /// window completes. A summary the sink drops is lost.
+    /// @param[in] channels Scanned channels, windows[i] summarizes channels[i]
+    /// @param[in,out] windows core::stats::sliding or core::stats::tumbling windows
+    /// @return false if the source was empty
+    template <class Source, class Window, core::uint8_t Channels, class Sink>
+    bool summarize_next(Source& source, const core::adc::channel_config (&channels)[Channels],
+        Window (&windows)[Channels], Sink& sink)
+    {
+        static_assert(Mode == mode::csv, "Summaries are sent as CSV lines");
+        core::adc::tagged_sample sample;
+        if (!source.pop(sample)) {
+            return false;
+        }
+        for (core::uint8_t i = 0; i < Channels; ++i) {
+            if (channels[i].channel == sample.channel()) {
+                if (windows[i].add(sample.value())) {
+                    send_summary(sink, sample.channel(), windows[i].last());
+                }
+                break;
+            }
+        }
+        return true;
+    }
+
+    /// @brief Queue the completed window of a capture as far as the sink accepts, rearm once all of it is out.
+    ///
+    /// Resumes where the previous call stopped, nothing is dropped. CSV windows go out behind a
+    /// "capture,<number>,<trigger index>,<samples>" line.
+    /// @param[in] channel Channel the window is tagged with
+    /// @return true if the window was completely queued and the capture rearmed
+    template <core::uint16_t Capacity, class Sink>
+    bool send_capture(core::trigger::capture<Capacity>& capture, Sink& sink, core::uint8_t channel)
+    {
+        if (!capture.ready()) {
+            return false;
+        }
+
+        if constexpr (Mode == mode::binary) {
+            core::uint16_t values[MaxSamples];
+            while (sent_ < capture.size()) {
+                core::uint8_t count = 0;
+                while (count < MaxSamples && sent_ + count < capture.size()) {
+                    values[count] = capture[sent_ + count];
+                    ++count;
+                }
+                if (!send_frame(sink, channel, core::span<const core::uint16_t>(values, count))) {
+                    return false;
+                }
+                ++sequence_;
+                sent_ += count;
+            }
+        } else {
+            if (!announced_) {
+                char line[32];
+                core::fmt::writer out(line);
+                out.append("capture,")
+                    .append_uint(capture.captures())
+                    .append(',')
+                    .append_uint(capture.trigger_index())
+                    .append(',')
+                    .append_uint(capture.size())
+                    .append("\r\n");
+                if (!sink.write(out.written().data(), out.size())) {
+                    return false;
+                }
+                announced_ = true;
+            }
+            while (sent_ < capture.size()) {
+                if (!send_csv(sink, channel, capture[sent_])) {
+                    return false;
+                }
+                ++sent_;
+            }
+        }
+
+        announced_ = false;
+        sent_ = 0;
+        capture.rearm();
+        return true;
+    }
+
+    /// @brief Sequence number of the next binary frame
+    core::uint8_t sequence() const noexcept { return sequence_; }
+
+private:
+    template <class Sink>
+    bool send_frame(Sink& sink, core::uint8_t channel, core::span<const core::uint16_t> values)
+    {
+        core::uint8_t wire[core::frame::max_frame_size(MaxSamples, Encoding)];
+        return sink.write(core::frame::encode(sequence_, channel, values, wire, Encoding));
+    }
+
+    core::uint16_t sent_ {}; //< Samples of the current capture window already queued
+    core::uint8_t sequence_ {};
+    bool announced_ {}; //< Header line of the current CSV capture window queued
+};
+
+} // namespace core::output
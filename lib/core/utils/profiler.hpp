@@ -0,0 +1,142 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "cycle_counter.hpp"
+#include "fmt.hpp"
+#include "span.hpp"
+
+namespace core::prof {
+
+/// @brief Cycle statistics of one region, corrected for the measurement overhead.
+struct region_stats {
+    uint16_t count; //< Measured executions (saturates)
+    core::cycles::count min;
+    core::cycles::count max;
+    uint32_t total; //< Sum of all measured executions
+};
+
+/// @brief Cycle-accurate region profiler on top of the Timer1 cycle counter.
+///
+/// Regions are bracketed with an RAII scope and accumulate count/min/max/total cycles. The cost of the
+/// bracketing itself is measured once at start() and subtracted, so an empty region reads 0 cycles.
+/// Regions must be shorter than 65536 cycles (4.096 ms at 16 MHz). Reports are CSV lines, meant to be read
+/// from the simavr console or a serial monitor:
+/// @code
+/// region,count,min,mean,max
+/// format,1000,301,322,388
+/// @endcode
+///
+/// @tparam Regions Number of regions, ids are [0, Regions)
+template <uint8_t Regions>
+class profiler {
+public:
+    /// @brief Measures from construction to destruction
+    class scope {
+    public:
+        scope(profiler& owner, uint8_t id)
+            : owner_(owner)
+            , id_(id)
+            , start_(core::cycles::now())
+        {
+        }
+        ~scope() { owner_.record(id_, core::cycles::since(start_)); }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+    private:
+        profiler& owner_;
+        uint8_t id_;
+        core::cycles::count start_;
+    };
+
+    /// @param[in] names Region names used in reports, indexed by id
+    explicit profiler(const char* const (&names)[Regions])
+        : names_(names)
+    {
+        reset();
+    }
+
+    /// @brief Start the cycle counter and calibrate the bracketing overhead.
+    void start()
+    {
+        core::cycles::start();
+        overhead_ = 0;
+        core::cycles::count calibrated = static_cast<core::cycles::count>(-1);
+        for (uint8_t i = 0; i < 8; ++i) {
+            const core::cycles::count begin = core::cycles::now();
+            const core::cycles::count elapsed = core::cycles::since(begin);
+            calibrated = elapsed < calibrated ? elapsed : calibrated;
+        }
+        overhead_ = calibrated;
+        reset();
+    }
+
+    /// @brief Measure the enclosing block as region id (unchecked)
+    scope measure(uint8_t id) { return scope(*this, id); }
+
+    /// @brief Account one execution of region id (unchecked)
+    void record(uint8_t id, core::cycles::count cycles)
+    {
+        cycles = cycles > overhead_ ? cycles - overhead_ : 0;
+        auto& region = stats_[id];
+        if (region.count != static_cast<uint16_t>(-1)) {
+            ++region.count;
+            region.total += cycles;
+        }
+        region.min = cycles < region.min ? cycles : region.min;
+        region.max = cycles > region.max ? cycles : region.max;
+    }
+
+    /// @brief Forget all measurements
+    void reset()
+    {
+        for (auto& region : stats_) {
+            region = { 0, static_cast<core::cycles::count>(-1), 0, 0 };
+        }
+    }
+
+    /// @brief Statistics of region id (unchecked)
+    const region_stats& stats(uint8_t id) const { return stats_[id]; }
+
+    /// @brief Measurement overhead subtracted from every execution
+    core::cycles::count overhead() const { return overhead_; }
+
+    /// @brief Emit the CSV header and one line per measured region.
+    /// @param[in] sink Callable taking a core::span<char> line (CRLF terminated)
+    template <class Sink>
+    void report(Sink&& sink) const
+    {
+        char line[64];
+        const char header[] = "region,count,min,mean,max\r\n";
+        core::fmt::writer out(line);
+        sink(out.append(header).written());
+
+        for (uint8_t id = 0; id < Regions; ++id) {
+            const auto& region = stats_[id];
+            if (region.count == 0) {
+                continue;
+            }
+            out.clear();
+            out.append(names_[id])
+                .append(',')
+                .append_uint(region.count)
+                .append(',')
+                .append_uint(region.min)
+                .append(',')
+                .append_uint(region.total / region.count)
+                .append(',')
+                .append_uint(region.max)
+                .append("\r\n");
+            sink(out.written());
+        }
+    }
+
+private:
+    const char* const (&names_)[Regions];
+    region_stats stats_[Regions];
+    core::cycles::count overhead_ {};
+};
+
+} // namespace core::prof
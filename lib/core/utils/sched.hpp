@@ -0,0 +1,110 @@
+#pragma once
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+
+#include "fmt.hpp"
+#include "scheduler.hpp"
+#include "span.hpp"
+
+namespace core::sched {
+
+/// 1 ms scheduler tick from Timer2 in CTC mode, the clock policy of core::sched::scheduler on the ATmega328P
+///
+/// Timer0 stays with millis() and Timer1 with core::cycles, Timer2 costs analogWrite() on pins 3 and 11.
+/// The application owns the compare match vector and forwards it:
+/// @code
+/// ISR(TIMER2_COMPA_vect) { core::sched::timer2::on_tick(); }
+/// @endcode
+struct timer2 {
+    static constexpr core::uint8_t prescaler = 64;
+
+    /// Timer2 counts per tick, also the stamp() units per tick (250 at 16 MHz)
+    static constexpr core::uint16_t stamps_per_tick = F_CPU / prescaler / 1000;
+    static_assert(stamps_per_tick > 0 && stamps_per_tick <= 256, "F_CPU out of range for a 1 ms Timer2 tick");
+
+    /// Length of a stamp in microseconds (4 at 16 MHz)
+    static constexpr core::uint16_t us_per_stamp = prescaler / (F_CPU / 1000000UL);
+
+    /// @brief Start the 1 kHz tick interrupt (CTC on OCR2A, clk/64)
+    static void start()
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            TCCR2A = _BV(WGM21);
+            TCCR2B = _BV(CS22);
+            OCR2A = stamps_per_tick - 1;
+            TCNT2 = 0;
+            TIFR2 = _BV(OCF2A);
+            TIMSK2 = _BV(OCIE2A);
+            ticks_ = 0;
+        }
+    }
+
+    /// @brief Compare match handler. Must only be called from TIMER2_COMPA_vect.
+    static void on_tick() { ticks_ = ticks_ + 1; }
+
+    /// @brief Ticks since start()
+    static tick ticks()
+    {
+        tick count;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { count = ticks_; }
+        return count;
+    }
+
+    /// @brief Free-running stamp, ticks * stamps_per_tick + TCNT2 modulo 65536
+    static core::uint16_t stamp()
+    {
+        tick count;
+        core::uint8_t fraction;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            count = ticks_;
+            fraction = TCNT2;
+            if (bit_is_set(TIFR2, OCF2A)) {
+                // The counter cleared with the tick interrupt still pending
+                fraction = TCNT2;
+                ++count;
+            }
+        }
+        return static_cast<core::uint16_t>(count * stamps_per_tick + fraction);
+    }
+
+private:
+    static inline volatile tick ticks_ {};
+};
+
+/// @brief Sleep in idle mode until the next interrupt, unless a task is already due.
+///
+/// The due check and the sleep instruction run with interrupts disabled (sei takes effect after the next
+/// instruction), so a tick landing in between wakes the CPU instead of being slept through.
+template <class Scheduler>
+void idle(const Scheduler& scheduler)
+{
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cli();
+    if (!scheduler.pending()) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+}
+
+/// @brief Emit the CSV header and one line per task of scheduler, in table order.
+/// @param[in] sink Callable taking a core::span<char> line (CRLF terminated)
+template <class Scheduler, class Sink>
+void report(const Scheduler& scheduler, Sink&& sink)
+{
+    char line[64];
+    fmt::writer out(line);
+    sink(out.append(report_header).written());
+    for (core::uint8_t i = 0; i < scheduler.size(); ++i) {
+        out.clear();
+        sink(format(out, i, scheduler.stats(i), timer2::us_per_stamp).written());
+    }
+}
+
+} // namespace core::sched
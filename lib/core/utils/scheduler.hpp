@@ -0,0 +1,180 @@
+#pragma once
+
+#include "fmt.hpp"
+#include "types.hpp"
+
+namespace core::sched {
+
+/// Scheduler time in ticks (1 ms with core::sched::timer2), wraps every 65536 ticks
+using tick = core::uint16_t;
+
+/// One periodic task of a static task table
+struct task {
+    void (*run)(); //< Task body, runs to completion
+    tick period; //< Release period in ticks (1-32767)
+    tick deadline; //< Completion deadline relative to the release, 0 for the period
+    tick offset; //< First release after start(), spreads tasks of equal period over different ticks
+};
+
+/// Per-task timing figures, counters saturate instead of wrapping
+struct task_stats {
+    core::uint16_t runs; //< Completed jobs
+    core::uint16_t misses; //< Jobs completed on or after their deadline tick
+    core::uint16_t skips; //< Releases dropped because the task was still behind a whole period
+    core::uint16_t wcet; //< Longest execution time seen, in clock stamps
+    tick max_response; //< Longest release-to-completion time seen, in ticks
+};
+
+/// Time-triggered cooperative scheduler over a static task table
+///
+/// Tasks are released every period ticks of a timer tick and run to completion from the main loop, so they
+/// never preempt each other and share data without locks; only ISRs preempt them. Table order is priority:
+/// dispatch() always runs the first due task, so a slow low-priority task delays a high-priority one by at most
+/// its own execution time (order the table rate-monotonic, shortest period first). A task still due a whole
+/// period after its release skips the releases it missed rather than running back-to-back to catch up.
+///
+/// Pure bookkeeping: the Clock policy supplies the tick count and a finer free-running stamp used to measure
+/// execution times, core::sched::timer2 on the ATmega328P.
+/// @code
+/// constexpr core::sched::task tasks[] = {
+///     { acquire, 1, 1, 0 }, // every ms, done within the same tick
+///     { transmit, 10, 0, 0 },
+///     { housekeeping, 1000, 0, 5 },
+/// };
+/// core::sched::scheduler<3, core::sched::timer2> scheduler(tasks);
+/// @endcode
+///
+/// @tparam Tasks Number of tasks in the table.
+/// @tparam Clock Type with static functions tick ticks() and core::uint16_t stamp(), the stamp a free-running
+///         count wrapping at 65536 (execution times must stay below one wrap).
+template <core::uint8_t Tasks, class Clock>
+class scheduler {
+    static_assert(Tasks > 0, "At least one task must be scheduled");
+
+    using signed_tick = core::int16_t;
+
+public:
+    constexpr explicit scheduler(const task (&table)[Tasks])
+        : table_(table)
+    {
+    }
+
+    /// @brief Release every task offset ticks from now and clear the statistics
+    void start()
+    {
+        const tick now = Clock::ticks();
+        for (core::uint8_t i = 0; i < Tasks; ++i) {
+            releases_[i] = static_cast<tick>(now + table_[i].offset);
+            stats_[i] = {};
+        }
+    }
+
+    /// @brief Run the highest-priority due task, if any
+    /// @return true if a task ran, false if none was due (the caller may sleep until the next interrupt)
+    bool dispatch()
+    {
+        const tick now = Clock::ticks();
+        for (core::uint8_t i = 0; i < Tasks; ++i) {
+            if (due(i, now)) {
+                run(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Whether any task is due now
+    bool pending() const
+    {
+        const tick now = Clock::ticks();
+        for (core::uint8_t i = 0; i < Tasks; ++i) {
+            if (due(i, now)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief Timing figures of the task at index in the table
+    const task_stats& stats(core::uint8_t index) const { return stats_[index]; }
+
+    /// @brief Number of tasks in the table
+    static constexpr core::uint8_t size() { return Tasks; }
+
+private:
+    bool due(core::uint8_t index, tick now) const
+    {
+        return static_cast<signed_tick>(now - releases_[index]) >= 0;
+    }
+
+    void run(core::uint8_t index)
+    {
+        const task& job = table_[index];
+        const tick release = releases_[index];
+        const core::uint16_t started = Clock::stamp();
+        job.run();
+        const core::uint16_t elapsed = static_cast<core::uint16_t>(Clock::stamp() - started);
+        const tick finished = Clock::ticks();
+
+        task_stats& figures = stats_[index];
+        const tick response = static_cast<tick>(finished - release);
+        const tick deadline = job.deadline != 0 ? job.deadline : job.period;
+        increment(figures.runs);
+        if (response >= deadline) {
+            increment(figures.misses);
+        }
+        if (elapsed > figures.wcet) {
+            figures.wcet = elapsed;
+        }
+        if (response > figures.max_response) {
+            figures.max_response = response;
+        }
+
+        tick next = static_cast<tick>(release + job.period);
+        const signed_tick behind = static_cast<signed_tick>(finished - next);
+        if (behind >= static_cast<signed_tick>(job.period)) {
+            // Overloaded: keep only the latest release, the division only runs on this path
+            const tick skipped = static_cast<tick>(static_cast<tick>(behind) / job.period);
+            next = static_cast<tick>(next + skipped * job.period);
+            figures.skips = skipped > 0xFFFF - figures.skips ? 0xFFFF
+                                                             : static_cast<core::uint16_t>(figures.skips + skipped);
+        }
+        releases_[index] = next;
+    }
+
+    static void increment(core::uint16_t& counter)
+    {
+        if (counter != 0xFFFF) {
+            ++counter;
+        }
+    }
+
+    const task* table_;
+    tick releases_[Tasks] {};
+    task_stats stats_[Tasks] {};
+};
+
+/// CSV header of format()
+inline constexpr char report_header[] = "task,index,runs,misses,skips,wcet_us,max_response_ticks\r\n";
+
+/// @brief Append one CRLF-terminated report line, e.g. "task,0,1000,0,0,148,0"
+/// @param[in] us_per_stamp Clock stamp length in microseconds
+inline fmt::writer& format(fmt::writer& out, core::uint8_t index, const task_stats& figures,
+    core::uint16_t us_per_stamp) noexcept
+{
+    return out.append("task,")
+        .append_uint(index)
+        .append(',')
+        .append_uint(figures.runs)
+        .append(',')
+        .append_uint(figures.misses)
+        .append(',')
+        .append_uint(figures.skips)
+        .append(',')
+        .append_uint(static_cast<core::uint32_t>(figures.wcet) * us_per_stamp)
+        .append(',')
+        .append_uint(figures.max_response)
+        .append("\r\n");
+}
+
+} // namespace core::sched
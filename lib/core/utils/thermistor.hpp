@@ -0,0 +1,57 @@
+#pragma once
+
+#include "lut.hpp"
+#include "types.hpp"
+
+namespace core::thermistor {
+
+/// NTC thermistor between the ADC input and ground, series resistor to AVcc, read by the 10-bit ADC
+///
+/// The divider is ratiometric: the code gives the resistance without knowing the reference voltage, so
+/// the curve is tabulated over raw codes rather than over core::adc::raw_to_mv() millivolts. The
+/// beta-equation temperature is evaluated at compile time only; at run time a reading is one
+/// core::lut::grid interpolation in a flash table.
+/// @code
+/// using sensor = core::thermistor::divider<10000, 10000, 3950>;
+/// constexpr auto sensor_table CORE_PROGMEM = sensor::make_table();
+/// const core::int16_t centi_c = sensor::centi_celsius(core::progmem_span(sensor_table), raw);
+/// @endcode
+///
+/// @tparam SeriesOhm Fixed resistor to AVcc
+/// @tparam NominalOhm Thermistor resistance at 25 degrees Celsius
+/// @tparam Beta Beta coefficient in kelvin
+/// @tparam SegmentBits Log2 of the table segments, 5 gives 33 entries (66 bytes of flash)
+template <core::uint32_t SeriesOhm, core::uint32_t NominalOhm, core::uint16_t Beta, core::uint8_t SegmentBits = 5>
+struct divider {
+    static_assert(SeriesOhm > 0 && NominalOhm > 0 && Beta > 0, "Divider parameters must be positive");
+
+    using grid = core::lut::grid<10, SegmentBits>;
+    using table_type = core::lut::table<core::int16_t, grid::points>;
+
+    /// @brief Beta-equation temperature in degrees Celsius for a code, clamped half a code inside the
+    /// rails (open and shorted sensor)
+    static constexpr double celsius(double raw) noexcept
+    {
+        constexpr double max_raw = 1023.0;
+        constexpr double kelvin_25 = 298.15;
+        raw = raw < 0.5 ? 0.5 : raw > max_raw - 0.5 ? max_raw - 0.5 : raw;
+        const double ohm = SeriesOhm * raw / (max_raw - raw);
+        return 1.0 / (1.0 / kelvin_25 + core::lut::ln(ohm / NominalOhm) / Beta) - 273.15;
+    }
+
+    /// @brief Table of hundredths of a degree, saturated to +-327.67 degrees near the rails
+    static constexpr table_type make_table() noexcept
+    {
+        return grid::template generate<core::int16_t>([](double raw) { return celsius(raw) * 100; });
+    }
+
+    /// @brief Temperature in hundredths of a degree Celsius
+    /// @param[in] table make_table() result, through a core::progmem_span when it is in flash
+    template <class Table>
+    static constexpr core::int16_t centi_celsius(const Table& table, core::uint16_t raw) noexcept
+    {
+        return grid::interpolate(table, raw);
+    }
+};
+
+} // namespace core::thermistor
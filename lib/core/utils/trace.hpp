@@ -0,0 +1,134 @@
+#pragma once
+
+#include <Arduino.h>
+#include <util/atomic.h>
+
+#include "cycle_counter.hpp"
+#include "span.hpp"
+#include "trace_buffer.hpp"
+
+/// Events kept by the trace ring, 3 bytes of RAM each (power of two up to 128)
+#ifndef CORE_TRACE_CAPACITY
+#define CORE_TRACE_CAPACITY 64
+#endif
+
+namespace core::trace {
+
+/// Cycle-stamped event tracing, compiled in with -D CORE_TRACE
+///
+/// Trace points record (id, Timer1 count) into a static ring in about 20 cycles, from the main loop or ISRs.
+/// Without CORE_TRACE every call below is an empty inline function and the ring does not exist, so trace
+/// points can stay in the code. Stamps are CPU cycles modulo 65536 (see core::cycles): the decoder unwraps
+/// them assuming consecutive events are less than 4.096 ms apart at 16 MHz, which any periodic ISR traced at a
+/// higher rate guarantees.
+///
+/// @code
+/// ISR(ADC_vect)
+/// {
+///     const core::trace::scope traced(TRACE_ADC_ISR);
+///     adc_scanner.on_conversion();
+/// }
+/// ...
+/// core::trace::dump([](core::span<const uint8_t> chunk) { while (!uart_tx.write(chunk)) { } });
+/// @endcode
+#ifdef CORE_TRACE
+inline constexpr bool enabled = true;
+
+namespace detail {
+    inline ring<CORE_TRACE_CAPACITY> events {};
+    inline volatile bool paused {};
+    inline core::uint8_t dumps {};
+
+    inline void record(core::uint8_t tag)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            if (!paused) {
+                events.record(tag, core::cycles::now());
+            }
+        }
+    }
+
+    /// @brief Run emit(dump number, ring) with recording paused, then start over with an empty ring
+    template <class Emit>
+    void drain(Emit&& emit)
+    {
+        paused = true;
+        emit(dumps++, events);
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            events.clear();
+            paused = false;
+        }
+    }
+} // namespace detail
+
+/// @brief Start Timer1 as the cycle counter (takes Timer1 from the Arduino core) and clear the ring
+inline void start()
+{
+    core::cycles::start();
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        detail::events.clear();
+        detail::paused = false;
+    }
+}
+
+inline void instant(core::uint8_t id) { detail::record(tag(kind::instant, id)); }
+inline void begin(core::uint8_t id) { detail::record(tag(kind::begin, id)); }
+inline void end(core::uint8_t id) { detail::record(tag(kind::end, id)); }
+
+/// @brief Events currently in the ring
+inline core::uint8_t size() { return detail::events.size(); }
+
+/// @brief Send the ring as binary chunks, then clear it. Events are not recorded while dumping.
+/// @param[in] sink Callable taking a core::span<const uint8_t> chunk, see dump_binary()
+template <class Sink>
+void dump(Sink&& sink)
+{
+    detail::drain([&sink](core::uint8_t number, const auto& events) { dump_binary(number, events, sink); });
+}
+
+/// @brief Send the ring as "trace:" hex lines, then clear it
+/// @param[in] sink Callable taking a core::span<char> line, see dump_hex()
+template <class Sink>
+void dump_text(Sink&& sink)
+{
+    detail::drain([&sink](core::uint8_t number, const auto& events) { dump_hex(number, events, sink); });
+}
+#else
+inline constexpr bool enabled = false;
+
+inline void start() { }
+inline void instant(core::uint8_t) { }
+inline void begin(core::uint8_t) { }
+inline void end(core::uint8_t) { }
+inline core::uint8_t size() { return 0; }
+template <class Sink>
+void dump(Sink&&)
+{
+}
+template <class Sink>
+void dump_text(Sink&&)
+{
+}
+#endif
+
+/// Traces the enclosing block as a begin/end pair
+class scope {
+public:
+    explicit scope(core::uint8_t id)
+        : id_(id)
+    {
+        begin(id_);
+    }
+    ~scope() { end(id_); }
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+private:
+    core::uint8_t id_;
+};
+
+} // namespace core::trace
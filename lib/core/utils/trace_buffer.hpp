@@ -0,0 +1,201 @@
+#pragma once
+
+#include "cobs.hpp"
+#include "crc.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::trace {
+
+/// Event kind, stored in the top two bits of the event tag
+enum class kind : core::uint8_t {
+    instant = 0x00, //< Point in time, e.g. "UART queue drained"
+    begin = 0x40, //< Start of a region, e.g. ISR entry
+    end = 0x80, //< End of the innermost region with the same id
+};
+
+/// Largest event id, ids share the tag byte with the kind
+inline constexpr core::uint8_t max_id = 0x3F;
+
+/// @brief Tag byte of an event (id unchecked)
+constexpr core::uint8_t tag(kind type, core::uint8_t id) noexcept
+{
+    return static_cast<core::uint8_t>(static_cast<core::uint8_t>(type) | id);
+}
+
+constexpr kind kind_of(core::uint8_t tag) noexcept
+{
+    return static_cast<kind>(tag & 0xC0);
+}
+
+constexpr core::uint8_t id_of(core::uint8_t tag) noexcept
+{
+    return static_cast<core::uint8_t>(tag & max_id);
+}
+
+/// One trace event: tag and 16-bit cycle timestamp
+struct event {
+    core::uint8_t tag;
+    core::uint16_t stamp;
+};
+
+/// Ring of the last Capacity events, overwriting the oldest
+///
+/// Tags and stamps are kept in separate arrays so record() is two indexed stores and an index update.
+/// Not synchronized: callers recording from several contexts serialize record() themselves.
+///
+/// @tparam Capacity Power of two up to 128
+template <core::uint8_t Capacity>
+class ring {
+    static_assert(Capacity > 0 && Capacity <= 128 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two up to 128");
+
+public:
+    static constexpr core::uint8_t capacity = Capacity;
+
+    /// @brief Append an event, overwriting the oldest once full
+    constexpr void record(core::uint8_t tag, core::uint16_t stamp) noexcept
+    {
+        const core::uint8_t i = head_;
+        tags_[i] = tag;
+        stamps_[i] = stamp;
+        head_ = static_cast<core::uint8_t>((i + 1) & (Capacity - 1));
+        if (head_ == 0) {
+            full_ = true;
+        }
+    }
+
+    /// @brief Recorded events, at most Capacity
+    constexpr core::uint8_t size() const noexcept { return full_ ? Capacity : head_; }
+
+    constexpr bool full() const noexcept { return full_; }
+
+    /// @brief Event i, oldest first (unchecked)
+    constexpr event operator[](core::uint8_t i) const noexcept
+    {
+        const core::uint8_t slot = static_cast<core::uint8_t>((full_ ? head_ + i : i) & (Capacity - 1));
+        return { tags_[slot], stamps_[slot] };
+    }
+
+    constexpr void clear() noexcept
+    {
+        head_ = 0;
+        full_ = false;
+    }
+
+private:
+    core::uint8_t tags_[Capacity] {};
+    core::uint16_t stamps_[Capacity] {};
+    core::uint8_t head_ {};
+    bool full_ {};
+};
+
+/// Dump wire format
+///
+/// A dump is a series of chunks, each carrying up to chunk_events consecutive events:
+///
+///     | dump u8 | marker u8 | first u8 | total u8 | (tag u8, stamp u16 LE) x n | CRC-16 LE |
+///
+/// total is the number of events of the whole dump and first the index of the chunk's first event, so the
+/// decoder knows when a dump is complete. The marker sits where core::frame keeps its encoding/channel byte
+/// and uses the reserved encoding 0xF, so frame decoders reject chunks instead of reading them as samples.
+/// Binary chunks are COBS-encoded between two delimiters, to resynchronize after text output; hex chunks
+/// are "trace:" text lines of the raw chunk, for consoles that cannot carry binary (simavr).
+namespace wire {
+
+    inline constexpr core::uint8_t marker = 0xF0;
+    inline constexpr core::uint8_t chunk_events = 16;
+    inline constexpr core::size_t header_size = 4;
+    inline constexpr core::size_t event_size = 3;
+    inline constexpr core::size_t trailer_size = 2;
+    inline constexpr core::size_t max_chunk_size = header_size + chunk_events * event_size + trailer_size;
+
+    /// Worst-case binary chunk on the wire, both delimiters included
+    inline constexpr core::size_t max_binary_size = cobs::max_encoded_size(max_chunk_size) + 2;
+
+    /// Hex chunk line prefix
+    inline constexpr char hex_prefix[] = "trace:";
+
+    /// Worst-case hex chunk line, CRLF included
+    inline constexpr core::size_t max_hex_size = sizeof(hex_prefix) - 1 + max_chunk_size * 2 + 2;
+
+} // namespace wire
+
+namespace detail {
+
+    /// @brief Feed the raw bytes of chunk first.. of events to put(byte), CRC included
+    template <core::uint8_t Capacity, class Put>
+    constexpr void put_chunk(core::uint8_t dump, const ring<Capacity>& events, core::uint8_t first, Put&& put)
+    {
+        const core::uint8_t total = events.size();
+        const core::uint8_t left = static_cast<core::uint8_t>(total - first);
+        const core::uint8_t count = left < wire::chunk_events ? left : wire::chunk_events;
+
+        core::uint16_t crc = crc::ccitt_init;
+        const auto put_checked = [&put, &crc](core::uint8_t byte) {
+            crc = crc::ccitt_update(crc, byte);
+            put(byte);
+        };
+        put_checked(dump);
+        put_checked(wire::marker);
+        put_checked(first);
+        put_checked(total);
+        for (core::uint8_t i = 0; i < count; ++i) {
+            const event item = events[static_cast<core::uint8_t>(first + i)];
+            put_checked(item.tag);
+            put_checked(static_cast<core::uint8_t>(item.stamp));
+            put_checked(static_cast<core::uint8_t>(item.stamp >> 8));
+        }
+        const core::uint16_t checksum = crc;
+        put(static_cast<core::uint8_t>(checksum));
+        put(static_cast<core::uint8_t>(checksum >> 8));
+    }
+
+} // namespace detail
+
+/// @brief Emit every event of the ring as binary chunks.
+/// @param[in] dump Dump number, lets the decoder tell consecutive dumps apart
+/// @param[in] sink Callable taking a core::span<const core::uint8_t> chunk (at most wire::max_binary_size)
+template <core::uint8_t Capacity, class Sink>
+void dump_binary(core::uint8_t dump, const ring<Capacity>& events, Sink&& sink)
+{
+    // A dump of an empty ring is one header-only chunk, so the request still gets an answer
+    core::uint8_t first = 0;
+    do {
+        core::uint8_t buffer[wire::max_binary_size];
+        buffer[0] = cobs::delimiter;
+        cobs::encoder stuffing(span<core::uint8_t>(buffer + 1, sizeof(buffer) - 1));
+        detail::put_chunk(dump, events, first, [&stuffing](core::uint8_t byte) { stuffing.put(byte); });
+        const auto encoded = stuffing.finish();
+        sink(span<const core::uint8_t>(buffer, encoded.size() + 1));
+        first = static_cast<core::uint8_t>(first + wire::chunk_events);
+    } while (first < events.size());
+}
+
+/// @brief Emit every event of the ring as hex chunk lines.
+/// @param[in] sink Callable taking a core::span<char> line (CRLF terminated, at most wire::max_hex_size)
+template <core::uint8_t Capacity, class Sink>
+void dump_hex(core::uint8_t dump, const ring<Capacity>& events, Sink&& sink)
+{
+    constexpr char digits[] = "0123456789ABCDEF";
+    core::uint8_t first = 0;
+    do {
+        char line[wire::max_hex_size];
+        core::size_t size = 0;
+        for (const char c : wire::hex_prefix) {
+            if (c != '\0') {
+                line[size++] = c;
+            }
+        }
+        detail::put_chunk(dump, events, first, [&line, &size, &digits](core::uint8_t byte) {
+            line[size++] = digits[byte >> 4];
+            line[size++] = digits[byte & 0x0F];
+        });
+        line[size++] = '\r';
+        line[size++] = '\n';
+        sink(span<char>(line, size));
+        first = static_cast<core::uint8_t>(first + wire::chunk_events);
+    } while (first < events.size());
+}
+
+} // namespace core::trace
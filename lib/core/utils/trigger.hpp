@@ -0,0 +1,272 @@
+#pragma once
+
+#include "atomic.hpp"
+#include "packed.hpp"
+#include "types.hpp"
+
+namespace core::trigger {
+
+/// Trigger condition type, oscilloscope style
+enum class mode : core::uint8_t {
+    above, //< Level: any sample at or above level
+    below, //< Level: any sample at or below level
+    rising, //< Edge: reaches level after having been below level - hysteresis (never with level <= hysteresis)
+    falling, //< Edge: reaches level after having been above level + hysteresis
+    either, //< Edge: rising or falling
+    exit_window, //< Window: leaves [level, high] after having been inside
+    enter_window, //< Window: enters [level, high] after having been outside
+};
+
+/// Trigger condition on raw samples
+struct condition {
+    mode type;
+    core::uint16_t level; //< Threshold, or lower bound of the window
+    core::uint16_t high; //< Upper bound of the window, window modes only
+    core::uint16_t hysteresis; //< Edge modes: how far past level the signal must go to re-arm (noise rejection)
+};
+
+/// Evaluates a trigger condition sample by sample, a few compares per sample
+class detector {
+public:
+    constexpr explicit detector(const condition& when = {}) noexcept { set(when); }
+
+    /// @brief Change the condition, edge and window modes re-arm on the next samples
+    constexpr void set(const condition& when) noexcept
+    {
+        when_ = when;
+        lower_ = when.level > when.hysteresis ? when.level - when.hysteresis : 0;
+        upper_ = when.level < 0xFFFF - when.hysteresis ? when.level + when.hysteresis : 0xFFFF;
+        armed_ = false;
+        armed_falling_ = false;
+    }
+
+    /// @brief Feed the next sample
+    /// @return true if the condition fires on this sample
+    constexpr bool update(core::uint16_t value) noexcept
+    {
+        switch (when_.type) {
+        case mode::above:
+            return value >= when_.level;
+        case mode::below:
+            return value <= when_.level;
+        case mode::rising:
+            return rising(value);
+        case mode::falling:
+            return falling(value);
+        case mode::either: {
+            // Both sides must see the sample, so each keeps its arming state
+            const bool up = rising(value);
+            const bool down = falling(value);
+            return up || down;
+        }
+        case mode::exit_window:
+        case mode::enter_window: {
+            // Armed on the inside for exits, on the outside for entries
+            const bool inside = value >= when_.level && value <= when_.high;
+            const bool exit = when_.type == mode::exit_window;
+            const bool fired = armed_ && inside != exit;
+            armed_ = inside == exit;
+            return fired;
+        }
+        }
+        return false;
+    }
+
+private:
+    constexpr bool rising(core::uint16_t value) noexcept
+    {
+        if (value < lower_) {
+            armed_ = true;
+            return false;
+        }
+        if (armed_ && value >= when_.level) {
+            armed_ = false;
+            return true;
+        }
+        return false;
+    }
+
+    constexpr bool falling(core::uint16_t value) noexcept
+    {
+        if (value > upper_) {
+            armed_falling_ = true;
+            return false;
+        }
+        if (armed_falling_ && value <= when_.level) {
+            armed_falling_ = false;
+            return true;
+        }
+        return false;
+    }
+
+    condition when_ {};
+    core::uint16_t lower_ {}; //< Rising edges arm below it
+    core::uint16_t upper_ {}; //< Falling edges arm above it
+    bool armed_ {}; //< Rising edge or window armed
+    bool armed_falling_ {};
+};
+
+/// Capture window and trigger
+struct settings {
+    condition when;
+    core::uint16_t pre; //< Samples kept before the trigger sample
+    core::uint16_t post; //< Samples from the trigger sample on, at least 1
+    core::uint8_t decimation; //< Keep one sample out of decimation (0 and 1 keep every sample)
+};
+
+/// Capture engine state
+enum class state : core::uint8_t {
+    stopped, //< Not armed, samples ignored
+    filling, //< Collecting the pre-trigger history, triggers ignored
+    armed, //< Waiting for the trigger, the history keeps rolling
+    triggered, //< Collecting the post-trigger samples
+    complete, //< Window ready to be read, samples ignored until rearm()
+};
+
+/// Oscilloscope-style triggered capture, fed from the sampling ISR
+///
+/// Samples roll through a circular buffer while the engine waits for the trigger, so when it fires the last
+/// pre samples before it are already there; post more samples, the trigger sample first, complete the window.
+/// The main loop then reads the window at its own pace and rearm()s: only the interesting part of a signal
+/// crosses the slow link, captured at full ADC rate. The trigger is ignored until the history holds pre
+/// samples, so every window is complete.
+///
+/// on_sample() is the only ISR-side call and costs a store and a few compares. The main loop only reads the
+/// buffer while the state is complete, which the ISR never writes to.
+/// @code
+/// core::trigger::capture<256> capture;
+/// ISR(ADC_vect) { capture.on_sample(ADC); }
+/// ...
+/// capture.arm({ { core::trigger::mode::rising, 512, 0, 8 }, 192, 64, 1 });
+/// if (capture.ready()) { for (uint16_t i = 0; i < capture.size(); ++i) { send(capture[i]); } capture.rearm(); }
+/// @endcode
+///
+/// Samples are kept as 10-bit ADC results in a core::packed_array, four to five bytes; bits above the tenth
+/// are dropped from the window, not from the trigger comparison.
+///
+/// @tparam Capacity Buffer samples, power of two up to 4096 (1.25 bytes of RAM each).
+template <core::uint16_t Capacity>
+class capture {
+    // Packed bit offsets are core::size_t, 16 bits on the AVR
+    static_assert(Capacity >= 2 && Capacity <= 4096 && (Capacity & (Capacity - 1)) == 0,
+        "Capacity must be a power of two in [2, 4096]");
+
+public:
+    /// @brief Wait for a trigger with new settings
+    /// @return false, and stopped, if the window does not fit: post is 0 or pre + post exceeds Capacity
+    bool arm(const settings& config) noexcept
+    {
+        stop();
+        if (config.post == 0 || static_cast<core::uint32_t>(config.pre) + config.post > Capacity) {
+            settings_ = {};
+            return false;
+        }
+        settings_ = config;
+        rearm();
+        return true;
+    }
+
+    /// @brief Wait for the next trigger with the same settings, after the window was read
+    void rearm() noexcept
+    {
+        stop();
+        if (settings_.post == 0) {
+            return; // never armed successfully
+        }
+        detector_.set(settings_.when);
+        head_ = 0;
+        filled_ = 0;
+        countdown_ = 1;
+        state_.store_release(static_cast<core::uint8_t>(state::filling));
+    }
+
+    /// @brief Ignore samples until the next arm() or rearm()
+    void stop() noexcept { state_.store_release(static_cast<core::uint8_t>(state::stopped)); }
+
+    /// @brief Sample handler, called from the sampling ISR
+    void on_sample(core::uint16_t value) noexcept
+    {
+        const auto current = static_cast<state>(state_.load_acquire());
+        if (current == state::stopped || current == state::complete) {
+            return;
+        }
+        if (settings_.decimation > 1) {
+            if (--countdown_ != 0) {
+                return;
+            }
+            countdown_ = settings_.decimation;
+        }
+
+        samples_.set(head_ & mask, value);
+        ++head_;
+        if (current == state::triggered) {
+            if (--remaining_ == 0) {
+                complete();
+            }
+            return;
+        }
+
+        const bool fired = detector_.update(value);
+        if (current == state::filling) {
+            if (++filled_ <= settings_.pre) {
+                return;
+            }
+            state_.store_release(static_cast<core::uint8_t>(state::armed));
+        }
+        if (fired) {
+            start_ = static_cast<core::uint16_t>(head_ - 1 - settings_.pre);
+            remaining_ = settings_.post - 1;
+            if (remaining_ == 0) {
+                complete();
+            } else {
+                state_.store_release(static_cast<core::uint8_t>(state::triggered));
+            }
+        }
+    }
+
+    /// @brief Current state
+    state status() const noexcept { return static_cast<state>(state_.load_acquire()); }
+
+    /// @brief Whether a complete window is ready to be read
+    bool ready() const noexcept { return status() == state::complete; }
+
+    /// @brief Window length, pre + post samples
+    core::uint16_t size() const noexcept { return settings_.pre + settings_.post; }
+
+    /// @brief Index of the trigger sample in the window
+    core::uint16_t trigger_index() const noexcept { return settings_.pre; }
+
+    /// @brief Sample i of the window, oldest first (unchecked, only while ready())
+    core::uint16_t operator[](core::uint16_t i) const noexcept
+    {
+        return samples_.get(static_cast<core::uint16_t>(start_ + i) & mask);
+    }
+
+    /// @brief Settings of the last successful arm()
+    const settings& config() const noexcept { return settings_; }
+
+    /// @brief Windows completed since construction, wraps at 65536
+    core::uint16_t captures() const noexcept { return captures_; }
+
+private:
+    static constexpr core::uint16_t mask = Capacity - 1;
+
+    void complete() noexcept
+    {
+        ++captures_;
+        state_.store_release(static_cast<core::uint8_t>(state::complete));
+    }
+
+    core::packed_array<10, Capacity> samples_ {};
+    settings settings_ {};
+    detector detector_ {};
+    core::uint16_t head_ {}; //< Samples written, the buffer index is head_ & mask
+    core::uint16_t start_ {}; //< Head of the first window sample
+    core::uint16_t filled_ {}; //< History samples so far, up to pre + 1
+    core::uint16_t remaining_ {}; //< Post-trigger samples still to collect
+    core::uint16_t captures_ {};
+    core::uint8_t countdown_ {}; //< Samples until the next kept one
+    core::atomic_u8 state_ {};
+};
+
+} // namespace core::trigger
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "fmt.hpp"
+#include "frame.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::uart {
+
+/// USART baud rate generator setting: UBRR divisor and double speed (U2X) bit
+struct link_setting {
+    core::uint32_t baud; //< Requested rate
+    core::uint16_t ubrr; //< UBRR0, 12 bits
+    bool double_speed; //< U2X0: 8 samples per bit instead of 16
+    core::uint32_t actual_baud; //< Rate the divisor produces, rounded
+    core::int32_t error_bp; //< (actual - requested) / requested in hundredths of a percent, rounded
+};
+
+/// @brief Setting of one speed mode: the divisor closest to baud, clamped to the 12-bit register
+constexpr link_setting divisor(core::uint32_t f_cpu, core::uint32_t baud, bool double_speed) noexcept
+{
+    const core::uint64_t per_bit = double_speed ? 8 : 16;
+    const core::uint64_t rate = per_bit * baud;
+    core::uint64_t divided = (f_cpu + rate / 2) / rate; // ubrr + 1
+    divided = divided < 1 ? 1 : divided > 4096 ? 4096 : divided;
+    const core::uint64_t actual_rate = per_bit * divided;
+    const core::uint64_t actual_baud = (f_cpu + actual_rate / 2) / actual_rate;
+    // f_cpu / (actual_rate * baud) is actual / requested
+    const core::uint64_t ratio_bp = (core::uint64_t { f_cpu } * 10000 + actual_rate * baud / 2) / (actual_rate * baud);
+    return { baud, static_cast<core::uint16_t>(divided - 1), double_speed, static_cast<core::uint32_t>(actual_baud),
+        static_cast<core::int32_t>(static_cast<core::int64_t>(ratio_bp) - 10000) };
+}
+
+/// @brief Setting with the smallest baud error, normal speed on a tie (16 samples per bit tolerate more noise)
+constexpr link_setting best_setting(core::uint32_t f_cpu, core::uint32_t baud) noexcept
+{
+    const link_setting normal = divisor(f_cpu, baud, false);
+    const link_setting fast = divisor(f_cpu, baud, true);
+    const core::int32_t normal_error = normal.error_bp < 0 ? -normal.error_bp : normal.error_bp;
+    const core::int32_t fast_error = fast.error_bp < 0 ? -fast.error_bp : fast.error_bp;
+    return fast_error < normal_error ? fast : normal;
+}
+
+/// @brief Recommended maximum receiver baud error for 8N1 frames (ATmega328P datasheet, asynchronous
+/// operating range): 2.0 % at normal speed, 1.5 % in double speed mode
+constexpr core::int32_t max_error_bp(bool double_speed) noexcept
+{
+    return double_speed ? 150 : 200;
+}
+
+/// Compile-time link configuration: the best setting for Baud at FCpu, rejected if out of tolerance
+///
+/// The firmware passes setting to core::uart::transmitter::begin(). At 16 MHz, 250000, 500000 and
+/// 1000000 baud are exact and 9600, 19200, 38400, 57600 and 76800 within 0.8 %, while 115200 is 2.1 %
+/// off in the better mode, beyond the recommended receiver tolerance.
+/// @code
+/// constexpr auto LINK = core::uart::link_config<F_CPU, 500000>::setting;
+/// uart_tx.begin(LINK);
+/// @endcode
+///
+/// @tparam FCpu CPU clock in Hz
+/// @tparam Baud Requested baud rate
+/// @tparam MaxErrorBp Accepted error in hundredths of a percent, the datasheet recommendation by default
+template <core::uint32_t FCpu, core::uint32_t Baud, core::int32_t MaxErrorBp = -1>
+struct link_config {
+    static_assert(Baud > 0, "Baud rate must be positive");
+
+    static constexpr link_setting setting = best_setting(FCpu, Baud);
+    static constexpr core::int32_t tolerance_bp = MaxErrorBp >= 0 ? MaxErrorBp : max_error_bp(setting.double_speed);
+
+    static_assert(setting.error_bp <= tolerance_bp && setting.error_bp >= -tolerance_bp,
+        "No UBRR/U2X setting reaches this baud rate within tolerance, pick one that divides F_CPU / 8 "
+        "(250000, 500000, 1000000 at 16 MHz) or pass a wider MaxErrorBp");
+};
+
+/// @brief Append a link setting as "link,<baud>,<actual baud>,<error %>,<ubrr>,<u2x>"
+constexpr core::fmt::writer& format(core::fmt::writer& out, const link_setting& setting)
+{
+    return out.append("link,")
+        .append_uint(setting.baud)
+        .append(',')
+        .append_uint(setting.actual_baud)
+        .append(',')
+        .append_fixed(setting.error_bp, 2)
+        .append(',')
+        .append_uint(setting.ubrr)
+        .append(',')
+        .append_uint(setting.double_speed ? 1 : 0);
+}
+
+/// Link throughput self-test stream
+///
+/// A "link,..." line (see format()) followed by back-to-back raw16 core::frame frames on channel 0,
+/// whose samples are a known function of the frame sequence number. The receiver checks every word
+/// without state and counts CRC errors, framing errors and sequence gaps with the usual decoder.
+namespace selftest {
+
+    /// Samples per frame: 37-byte packets, 39 bytes on the wire
+    inline constexpr core::uint8_t frame_samples = 16;
+
+    /// Bytes a self-test frame may take on the wire
+    inline constexpr core::size_t frame_size = core::frame::max_frame_size(frame_samples);
+
+    /// @brief Word index of frame sequence: a multiply by an odd constant, so the 4096 words of the
+    /// 256-frame cycle are all distinct
+    constexpr core::uint16_t pattern(core::uint8_t sequence, core::uint8_t index) noexcept
+    {
+        return static_cast<core::uint16_t>((static_cast<core::uint16_t>(sequence) * frame_samples + index) * 0x9E37U);
+    }
+
+    /// @brief Encode the self-test frame of a sequence number
+    /// @param[out] out Destination, frame_size bytes are always enough
+    /// @return Encoded frame including the delimiter
+    constexpr core::span<core::uint8_t> encode(core::uint8_t sequence, core::span<core::uint8_t> out) noexcept
+    {
+        core::uint16_t values[frame_samples] {};
+        for (core::uint8_t i = 0; i < frame_samples; ++i) {
+            values[i] = pattern(sequence, i);
+        }
+        return core::frame::encode(sequence, 0, values, out);
+    }
+
+} // namespace selftest
+
+} // namespace core::uart
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "ring_buffer.hpp"
+#include "span.hpp"
+#include "types.hpp"
+
+namespace core::uart {
+
+/// @brief What the transmitter does with a record that does not fit in the queue.
+enum class overflow_policy : core::uint8_t {
+    drop_newest, //< Reject the incoming record
+    drop_oldest, //< Discard queued records not yet on the wire until the new one fits
+    decimate, //< Once the queue is half full keep only one record out of `factor`, drop when full
+};
+
+/// @brief Transmit counters, only updated from the main loop.
+struct tx_statistics {
+    core::uint32_t accepted; //< Records queued
+    core::uint32_t dropped; //< Records lost to a full queue (new or old, depending on the policy)
+    core::uint32_t decimated; //< Records skipped by decimation
+};
+
+/// @brief Section that needs no protection from the consumer, for single-threaded use of record_queue.
+struct no_lock { };
+
+/// @brief Hardware-free byte queue of whole records behind core::uart::transmitter.
+///
+/// The producer queues records with write(), which applies the overflow policy; the consumer takes the
+/// bytes one at a time with pop(), a record at a time, so records are never split on the wire. The
+/// transmitter pops from its UDRE interrupt; the native replay (lib/host/replay.hpp) pops at the line
+/// rate of a virtual UART, so both run the same queueing and overflow handling.
+///
+/// @tparam Bytes Byte queue capacity, power of two up to 128
+/// @tparam Records Most records queued at once, power of two up to 128
+/// @tparam Lock Type constructed around the only producer section the consumer must not interrupt:
+///         dropping queued records with overflow_policy::drop_oldest
+template <core::uint8_t Bytes, core::uint8_t Records, class Lock = no_lock>
+class record_queue {
+public:
+    /// @brief Select the overflow policy.
+    /// @param[in] policy Policy applied when the queue is saturated.
+    /// @param[in] factor Decimation factor, only used by overflow_policy::decimate (>= 1).
+    void set_policy(overflow_policy policy, core::uint8_t factor = 2)
+    {
+        policy_ = policy;
+        factor_ = factor ? factor : 1;
+        decimation_count_ = 0;
+    }
+
+    /// @brief Queue a whole record, never blocks.
+    /// @return true if the record was queued.
+    bool write(span<const core::uint8_t> record)
+    {
+        const auto size = static_cast<core::uint8_t>(record.size());
+        if (record.empty() || record.size() > Bytes) {
+            ++stats_.dropped;
+            return false;
+        }
+
+        if (policy_ == overflow_policy::decimate && bytes_.size() >= Bytes / 2) {
+            if (++decimation_count_ < factor_) {
+                ++stats_.decimated;
+                return false;
+            }
+            decimation_count_ = 0;
+        }
+        if (!fits(size) && policy_ == overflow_policy::drop_oldest) {
+            make_room(size);
+        }
+        if (!fits(size)) {
+            ++stats_.dropped;
+            return false;
+        }
+
+        // The queue may wrap: at most two contiguous chunks
+        const core::uint8_t* data = record.data();
+        for (core::uint8_t left = size; left != 0;) {
+            auto region = bytes_.write_reserve();
+            const core::uint8_t chunk = region.size() < left ? region.size() : left;
+            for (core::uint8_t i = 0; i < chunk; ++i) {
+                region[i] = *data++;
+            }
+            bytes_.write_commit(chunk);
+            left -= chunk;
+        }
+        // Publish the length last: the consumer only starts a record once its bytes are queued
+        lengths_.push(size);
+        ++stats_.accepted;
+        return true;
+    }
+
+    /// @brief Take the next byte for the wire. Consumer side only.
+    /// @param[out] byte Next byte, untouched if the queue is empty.
+    /// @return false if no record is queued.
+    bool pop(core::uint8_t& byte)
+    {
+        if (remaining_ == 0 && !lengths_.pop(remaining_)) {
+            return false;
+        }
+        bytes_.pop(byte);
+        --remaining_;
+        return true;
+    }
+
+    /// @brief Bytes queued and not yet popped.
+    core::uint8_t pending() const { return bytes_.size(); }
+
+    /// @brief Transmit counters.
+    const tx_statistics& stats() const { return stats_; }
+
+private:
+    bool fits(core::uint8_t size) const { return bytes_.free() >= size && !lengths_.full(); }
+
+    /// @brief Drop whole queued records until size bytes fit. The unsent tail of the record being popped
+    ///        (its length already taken by the consumer) stays in front and is moved over the dropped bytes.
+    void make_room(core::uint8_t size)
+    {
+        [[maybe_unused]] const Lock lock {};
+        core::uint8_t length = 0;
+        while (!fits(size) && lengths_.pop(length)) {
+            bytes_.erase(remaining_, length);
+            ++stats_.dropped;
+        }
+    }
+
+    core::ring_buffer<core::uint8_t, Bytes> bytes_ {};
+    core::ring_buffer<core::uint8_t, Records> lengths_ {};
+    core::uint8_t remaining_ {}; //< Bytes left of the record being popped, written by the consumer only
+    overflow_policy policy_ { overflow_policy::drop_newest };
+    core::uint8_t factor_ { 2 };
+    core::uint8_t decimation_count_ {};
+    tx_statistics stats_ {};
+};
+
+} // namespace core::uart
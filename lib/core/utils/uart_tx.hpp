@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "span.hpp"
+#include "uart_link.hpp"
+#include "uart_queue.hpp"
+
+namespace core::uart {
+
+/// @brief Interrupts masked for the lifetime of the object, previous state restored (ATOMIC_RESTORESTATE).
+struct interrupt_lock {
+    interrupt_lock()
+        : sreg(SREG)
+    {
+        cli();
+    }
+    ~interrupt_lock()
+    {
+        asm volatile("" ::: "memory");
+        SREG = sreg;
+    }
+
+    uint8_t sreg;
+};
+
+/// @brief Non-blocking, interrupt-driven USART0 transmitter for whole records.
+///
+/// Records (text lines, binary frames) are copied into a static byte queue and fed to the UART from the
+/// USART_UDRE_vect ISR, so write() returns immediately instead of waiting for the wire like
+/// HardwareSerial does once its buffer is full. A saturated queue is handled by an explicit policy, with
+/// counters, so acquisition is never throttled by transmit. Records are never split on the wire. The queue
+/// and its policies are core::uart::record_queue, shared with the native replay.
+///
+/// Replaces Serial for output: the application must not use Serial (its ISR would clash) and forwards
+/// the vector itself:
+/// @code
+/// core::uart::transmitter<128, 16> uart_tx;
+/// ISR(USART_UDRE_vect) { uart_tx.on_data_register_empty(); }
+/// @endcode
+///
+/// @tparam Bytes Byte queue capacity, power of two up to 128
+/// @tparam Records Most records queued at once, power of two up to 128
+template <uint8_t Bytes, uint8_t Records>
+class transmitter {
+public:
+    /// @brief Configure USART0 for 8N1 transmit at baud, same divisor selection as HardwareSerial.
+    void begin(uint32_t baud)
+    {
+        uint16_t setting = (F_CPU / 4 / baud - 1) / 2;
+        UCSR0A = _BV(U2X0);
+        // Hardcoded exception for 57600 for compatibility with the bootloader shipped with the board
+        if (((F_CPU == 16000000UL) && (baud == 57600)) || (setting > 4095)) {
+            UCSR0A = 0;
+            setting = (F_CPU / 8 / baud - 1) / 2;
+        }
+        UBRR0 = setting;
+        UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+        UCSR0B = _BV(TXEN0);
+    }
+
+    /// @brief Configure USART0 for 8N1 transmit with a precomputed divisor setting, see core::uart::link_config.
+    void begin(const link_setting& setting)
+    {
+        UCSR0A = setting.double_speed ? _BV(U2X0) : 0;
+        UBRR0 = setting.ubrr;
+        UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+        UCSR0B = _BV(TXEN0);
+    }
+
+    /// @brief Select the overflow policy.
+    /// @param[in] policy Policy applied when the queue is saturated.
+    /// @param[in] factor Decimation factor, only used by overflow_policy::decimate (>= 1).
+    void set_policy(overflow_policy policy, uint8_t factor = 2) { queue_.set_policy(policy, factor); }
+
+    /// @brief Queue a whole record for transmission, never blocks.
+    /// @return true if the record was queued.
+    bool write(span<const uint8_t> record)
+    {
+        if (!queue_.write(record)) {
+            return false;
+        }
+        started_ = true;
+        UCSR0B |= _BV(UDRIE0);
+        return true;
+    }
+
+    /// @brief Queue a text record.
+    bool write(const char* text, size_t size)
+    {
+        return write(span<const uint8_t>(reinterpret_cast<const uint8_t*>(text), size));
+    }
+
+    /// @brief Block until every queued record has left the UART. Interrupts must be enabled.
+    void flush()
+    {
+        while (!idle()) { }
+    }
+
+    /// @brief Whether every queued record has left the UART, i.e. the wire is quiet.
+    bool idle() const { return !started_ || (bit_is_clear(UCSR0B, UDRIE0) && bit_is_set(UCSR0A, TXC0)); }
+
+    /// @brief Bytes queued and not yet handed to the UART.
+    uint8_t pending() const { return queue_.pending(); }
+
+    /// @brief Transmit counters.
+    const tx_statistics& stats() const { return queue_.stats(); }
+
+    /// @brief Data register empty handler. Must only be called from USART_UDRE_vect.
+    void on_data_register_empty()
+    {
+        uint8_t byte = 0;
+        if (!queue_.pop(byte)) {
+            UCSR0B &= ~_BV(UDRIE0);
+            return;
+        }
+        UDR0 = byte;
+        // Clear TXC0 (write one), keeping U2X0/MPCM0, so flush() can wait for the last byte
+        UCSR0A = (UCSR0A & (_BV(U2X0) | _BV(MPCM0))) | _BV(TXC0);
+    }
+
+private:
+    record_queue<Bytes, Records, interrupt_lock> queue_ {};
+    bool started_ {};
+};
+
+} // namespace core::uart
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <span.hpp>
+#include <types.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace host::capture {
+
+/// Columnar capture file
+///
+/// A capture is preallocated at its full size and memory-mapped, so samples are decoded straight into the
+/// page cache without write() calls and readers can map a live capture. Layout, every region page-aligned:
+///
+///     | header (1 page) | values u16 x capacity | channels u8 x capacity | index entry x index_capacity |
+///
+/// Sample i is (channels[i], values[i]). The index holds one entry per ingested batch (a binary frame or
+/// one read() worth of CSV lines) with its first sample, host timestamp and link sequence number, so time
+/// and sequence lookups never scan the columns. count and index_count are published with release stores
+/// after the data they cover, all integers are little-endian (the host byte order).
+
+inline constexpr char magic[8] = { 'A', 'D', 'C', 'C', 'A', 'P', 0, 1 };
+inline constexpr core::uint32_t version = 1;
+
+/// Channel of index entries covering samples of several channels
+inline constexpr core::uint8_t mixed_channel = 0xFF;
+
+/// Source format of an index entry
+enum class source : core::uint8_t {
+    csv = 0,
+    frame_raw16 = 1,
+    frame_packed10 = 2,
+    frame_delta = 3,
+};
+
+struct header {
+    char magic[8];
+    core::uint32_t version;
+    core::uint32_t header_size; //< Offset of the first column
+    core::uint64_t capacity; //< Sample slots
+    core::uint64_t count; //< Committed samples
+    core::uint64_t index_capacity; //< Index slots
+    core::uint64_t index_count; //< Committed index entries
+    core::uint64_t values_offset;
+    core::uint64_t channels_offset;
+    core::uint64_t index_offset;
+    core::uint64_t file_size;
+    core::uint64_t created_ns; //< CLOCK_REALTIME at creation
+};
+
+struct index_entry {
+    core::uint64_t first_sample;
+    core::uint64_t host_time_ns; //< CLOCK_REALTIME when the batch was read
+    core::uint32_t count; //< Samples in the batch
+    core::uint8_t channel; //< Channel of all samples, or mixed_channel
+    core::uint8_t sequence; //< Frame sequence number, 0 for CSV
+    source format;
+    core::uint8_t reserved;
+};
+static_assert(sizeof(index_entry) == 24, "Index entries are part of the file format");
+
+/// Region sizes and offsets of a capture with the given capacities
+struct layout {
+    core::uint64_t values_offset;
+    core::uint64_t channels_offset;
+    core::uint64_t index_offset;
+    core::uint64_t file_size;
+};
+
+inline constexpr core::uint64_t page_size = 4096;
+
+constexpr core::uint64_t page_align(core::uint64_t size) noexcept
+{
+    return (size + page_size - 1) & ~(page_size - 1);
+}
+
+constexpr layout make_layout(core::uint64_t capacity, core::uint64_t index_capacity) noexcept
+{
+    layout result {};
+    result.values_offset = page_size;
+    result.channels_offset = result.values_offset + page_align(capacity * sizeof(core::uint16_t));
+    result.index_offset = result.channels_offset + page_align(capacity);
+    result.file_size = result.index_offset + page_align(index_capacity * sizeof(index_entry));
+    return result;
+}
+
+namespace detail {
+
+    /// @brief Map a whole file, nullptr on failure
+    inline void* map(int fd, core::uint64_t size, bool writable) noexcept
+    {
+        void* address = ::mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        return address == MAP_FAILED ? nullptr : address;
+    }
+
+    inline core::uint64_t load_acquire(const core::uint64_t& value) noexcept
+    {
+        return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+    }
+
+    inline void store_release(core::uint64_t& value, core::uint64_t desired) noexcept
+    {
+        __atomic_store_n(&value, desired, __ATOMIC_RELEASE);
+    }
+
+} // namespace detail
+
+/// Appends samples to a new capture file
+///
+/// Samples are pushed one at a time into the mapped columns and become visible to readers, together with
+/// an index entry, on commit(). Errors are reported by return values, error() holds the reason.
+class writer {
+public:
+    writer() = default;
+    ~writer() { close(); }
+
+    writer(const writer&) = delete;
+    writer& operator=(const writer&) = delete;
+
+    /// @brief Create (or truncate) path and preallocate it for capacity samples
+    /// @return false on failure, see error()
+    bool open(const char* path, core::uint64_t capacity, core::uint64_t index_capacity, core::uint64_t now_ns)
+    {
+        close();
+        if (capacity == 0 || index_capacity == 0) {
+            return fail("capacity must not be zero", 0);
+        }
+        const layout regions = make_layout(capacity, index_capacity);
+
+        fd_ = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            return fail("open", errno);
+        }
+        // Reserve the blocks up front: no ENOSPC through SIGBUS halfway through a capture
+        if (const int result = ::posix_fallocate(fd_, 0, static_cast<off_t>(regions.file_size)); result != 0) {
+            if (result != EOPNOTSUPP && result != EINVAL) {
+                return fail("posix_fallocate", result);
+            }
+            if (::ftruncate(fd_, static_cast<off_t>(regions.file_size)) != 0) {
+                return fail("ftruncate", errno);
+            }
+        }
+        void* address = detail::map(fd_, regions.file_size, true);
+        if (address == nullptr) {
+            return fail("mmap", errno);
+        }
+        base_ = static_cast<core::uint8_t*>(address);
+        size_ = regions.file_size;
+
+        header_ = reinterpret_cast<header*>(base_);
+        *header_ = {};
+        std::memcpy(header_->magic, magic, sizeof(magic));
+        header_->version = version;
+        header_->header_size = static_cast<core::uint32_t>(regions.values_offset);
+        header_->capacity = capacity;
+        header_->index_capacity = index_capacity;
+        header_->values_offset = regions.values_offset;
+        header_->channels_offset = regions.channels_offset;
+        header_->index_offset = regions.index_offset;
+        header_->file_size = regions.file_size;
+        header_->created_ns = now_ns;
+
+        values_ = reinterpret_cast<core::uint16_t*>(base_ + regions.values_offset);
+        channels_ = base_ + regions.channels_offset;
+        index_ = reinterpret_cast<index_entry*>(base_ + regions.index_offset);
+        ::madvise(base_ + regions.values_offset, regions.index_offset - regions.values_offset, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    /// @brief Stage one sample for the next commit()
+    /// @return false if the capture is full, the sample is dropped
+    bool push(core::uint8_t channel, core::uint16_t value) noexcept
+    {
+        if (pending_ >= header_->capacity) {
+            ++dropped_;
+            return false;
+        }
+        values_[pending_] = value;
+        channels_[pending_] = channel;
+        ++pending_;
+        return true;
+    }
+
+    /// @brief Publish the staged samples as one batch
+    /// @param[in] now_ns Host time of the batch
+    /// @param[in] format Where the samples came from
+    /// @param[in] channel Channel of every sample in the batch, or mixed_channel
+    /// @param[in] sequence Frame sequence number
+    void commit(core::uint64_t now_ns, source format, core::uint8_t channel = mixed_channel,
+        core::uint8_t sequence = 0) noexcept
+    {
+        const core::uint64_t first = header_->count;
+        if (pending_ == first) {
+            return;
+        }
+        const core::uint64_t slot = header_->index_count;
+        if (slot < header_->index_capacity) {
+            index_[slot] = { first, now_ns, static_cast<core::uint32_t>(pending_ - first), channel, sequence, format, 0 };
+        }
+        detail::store_release(header_->count, pending_);
+        if (slot < header_->index_capacity) {
+            detail::store_release(header_->index_count, slot + 1);
+        } else {
+            ++unindexed_;
+        }
+    }
+
+    /// @brief Flush the mapping to disk (blocking)
+    bool sync() noexcept { return base_ == nullptr || ::msync(base_, size_, MS_SYNC) == 0; }
+
+    /// @brief Sync, unmap and close, the file keeps its preallocated size
+    void close() noexcept
+    {
+        if (base_ != nullptr) {
+            sync();
+            ::munmap(base_, size_);
+            base_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        header_ = nullptr;
+        pending_ = 0;
+    }
+
+    bool is_open() const noexcept { return base_ != nullptr; }
+    core::uint64_t count() const noexcept { return header_ != nullptr ? header_->count : 0; }
+    core::uint64_t capacity() const noexcept { return header_ != nullptr ? header_->capacity : 0; }
+    bool full() const noexcept { return header_ != nullptr && pending_ >= header_->capacity; }
+
+    /// @brief Samples rejected because the capture was full
+    core::uint64_t dropped() const noexcept { return dropped_; }
+
+    /// @brief Batches committed after the index filled up
+    core::uint64_t unindexed() const noexcept { return unindexed_; }
+
+    /// @brief Reason of the last failure
+    const char* error() const noexcept { return error_; }
+
+private:
+    bool fail(const char* what, int code) noexcept
+    {
+        std::memset(error_, 0, sizeof(error_));
+        std::strncat(error_, what, sizeof(error_) - 1);
+        if (code != 0) {
+            std::strncat(error_, ": ", sizeof(error_) - std::strlen(error_) - 1);
+            std::strncat(error_, std::strerror(code), sizeof(error_) - std::strlen(error_) - 1);
+        }
+        close();
+        return false;
+    }
+
+    int fd_ { -1 };
+    core::uint8_t* base_ {};
+    core::uint64_t size_ {};
+    header* header_ {};
+    core::uint16_t* values_ {};
+    core::uint8_t* channels_ {};
+    index_entry* index_ {};
+    core::uint64_t pending_ {}; //< Samples written, published up to header_->count
+    core::uint64_t dropped_ {};
+    core::uint64_t unindexed_ {};
+    char error_[128] {};
+};
+
+/// Read-only view of a capture file, also usable on a capture still being written
+class reader {
+public:
+    reader() = default;
+    ~reader() { close(); }
+
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    /// @brief Map path and validate its header
+    /// @return false if the file cannot be mapped or is not a capture
+    bool open(const char* path)
+    {
+        close();
+        fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            return false;
+        }
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0 || static_cast<core::uint64_t>(info.st_size) < page_size) {
+            close();
+            return false;
+        }
+        size_ = static_cast<core::uint64_t>(info.st_size);
+        void* address = detail::map(fd_, size_, false);
+        if (address == nullptr) {
+            close();
+            return false;
+        }
+        base_ = static_cast<const core::uint8_t*>(address);
+        header_ = reinterpret_cast<const header*>(base_);
+
+        const layout regions = make_layout(header_->capacity, header_->index_capacity);
+        if (std::memcmp(header_->magic, magic, sizeof(magic)) != 0 || header_->version != version
+            || header_->file_size != size_ || regions.file_size != size_
+            || header_->values_offset != regions.values_offset || header_->channels_offset != regions.channels_offset
+            || header_->index_offset != regions.index_offset) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() noexcept
+    {
+        if (base_ != nullptr) {
+            ::munmap(const_cast<core::uint8_t*>(base_), size_);
+            base_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+        header_ = nullptr;
+    }
+
+    const header& info() const noexcept { return *header_; }
+
+    /// @brief Committed samples, stable for the lifetime of the returned spans
+    core::uint64_t count() const noexcept { return detail::load_acquire(header_->count); }
+
+    core::span<const core::uint16_t> values() const noexcept
+    {
+        return { reinterpret_cast<const core::uint16_t*>(base_ + header_->values_offset), count() };
+    }
+
+    core::span<const core::uint8_t> channels() const noexcept
+    {
+        return { base_ + header_->channels_offset, count() };
+    }
+
+    core::span<const index_entry> index() const noexcept
+    {
+        return { reinterpret_cast<const index_entry*>(base_ + header_->index_offset),
+            detail::load_acquire(header_->index_count) };
+    }
+
+private:
+    int fd_ { -1 };
+    const core::uint8_t* base_ {};
+    core::uint64_t size_ {};
+    const header* header_ {};
+};
+
+} // namespace host::capture
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <span.hpp>
+#include <types.hpp>
+
+namespace host::csv {
+
+/// Parser statistics
+struct statistics {
+    core::uint64_t lines; //< Complete lines seen
+    core::uint64_t samples; //< Lines parsed into a sample
+    core::uint64_t skipped; //< Headers, reports and malformed or overlong lines
+};
+
+/// Incremental parser of the firmware CSV output
+///
+/// Accepts "channel, raw, mv" lines and the older single-channel "raw, mv" form (channel 0); mv is derived
+/// data and dropped. Lines may be split across reads arbitrarily. Anything else, such as the column header
+/// or profiler reports, is counted as skipped.
+class parser {
+public:
+    /// Longest accepted line, CRLF excluded
+    static constexpr core::size_t max_line = 48;
+
+    /// @brief Consume a chunk of the stream, calling on_sample(channel, raw) for every sample line
+    template <class Callback>
+    void feed(core::span<const core::uint8_t> bytes, Callback&& on_sample)
+    {
+        for (const auto byte : bytes) {
+            if (byte != '\n') {
+                if (size_ < max_line) {
+                    line_[size_] = static_cast<char>(byte);
+                }
+                ++size_; // keeps counting so overlong lines are recognized
+                continue;
+            }
+            ++stats_.lines;
+            core::uint8_t channel = 0;
+            core::uint16_t raw = 0;
+            if (size_ <= max_line && parse(channel, raw)) {
+                ++stats_.samples;
+                on_sample(channel, raw);
+            } else {
+                ++stats_.skipped;
+            }
+            size_ = 0;
+        }
+    }
+
+    const statistics& stats() const noexcept { return stats_; }
+
+    void reset() noexcept
+    {
+        size_ = 0;
+        stats_ = {};
+    }
+
+private:
+    /// @brief Parse the buffered line into up to 3 unsigned fields
+    bool parse(core::uint8_t& channel, core::uint16_t& raw) const noexcept
+    {
+        core::uint32_t fields[3] {};
+        core::size_t count = 0;
+        bool digits = false;
+        core::size_t length = size_;
+        if (length > 0 && line_[length - 1] == '\r') {
+            --length;
+        }
+
+        for (core::size_t i = 0; i <= length; ++i) {
+            const char c = i < length ? line_[i] : ',';
+            if (c >= '0' && c <= '9') {
+                if (count >= 3 || fields[count] > 0xFFFF) {
+                    return false;
+                }
+                fields[count] = fields[count] * 10 + static_cast<core::uint32_t>(c - '0');
+                digits = true;
+            } else if (c == ',') {
+                if (!digits) {
+                    return false;
+                }
+                ++count;
+                digits = false;
+            } else if (c != ' ') {
+                return false;
+            }
+        }
+
+        if (count == 2 && fields[0] <= 0xFFFF) {
+            channel = 0;
+            raw = static_cast<core::uint16_t>(fields[0]);
+            return true;
+        }
+        if (count == 3 && fields[0] <= 0xFF && fields[1] <= 0xFFFF) {
+            channel = static_cast<core::uint8_t>(fields[0]);
+            raw = static_cast<core::uint16_t>(fields[1]);
+            return true;
+        }
+        return false;
+    }
+
+    char line_[max_line] {};
+    core::size_t size_ {};
+    statistics stats_ {};
+};
+
+} // namespace host::csv
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "capture.hpp"
+#include "csv.hpp"
+
+#include <frame.hpp>
+#include <span.hpp>
+#include <types.hpp>
+
+namespace host::ingest {
+
+/// Stream format of the link
+enum class format : core::uint8_t {
+    automatic, //< Decided from the first bytes: a 0x00 means binary frames, a line feed means CSV
+    csv,
+    binary,
+};
+
+/// Decodes a serial byte stream into a capture
+///
+/// Binary frames are committed one index entry per frame, tagged with their channel and sequence number;
+/// CSV lines are committed once per fed chunk. In automatic mode bytes are discarded until the format is
+/// recognized, which at worst loses the partial first line or frame the receiver joined in anyway.
+class session {
+public:
+    session(capture::writer& out, format mode) noexcept
+        : out_(out)
+        , mode_(mode)
+    {
+    }
+
+    /// @brief Decode one chunk read from the link
+    /// @param[in] now_ns Host time the chunk was read
+    void feed(core::span<const core::uint8_t> bytes, core::uint64_t now_ns)
+    {
+        bytes_ += bytes.size();
+        if (mode_ == format::automatic) {
+            bytes = detect(bytes);
+        }
+
+        switch (mode_) {
+        case format::binary:
+            frames_.feed(bytes, [this, now_ns](const core::frame::packet& packet) {
+                for (const auto sample : packet.samples) {
+                    out_.push(packet.channel, sample);
+                }
+                out_.commit(now_ns, to_source(packet.format), packet.channel, packet.sequence);
+            });
+            break;
+        case format::csv:
+            lines_.feed(bytes, [this](core::uint8_t channel, core::uint16_t raw) { out_.push(channel, raw); });
+            out_.commit(now_ns, capture::source::csv);
+            break;
+        case format::automatic:
+        default:
+            break;
+        }
+    }
+
+    /// @brief Format in use, automatic until detected
+    format mode() const noexcept { return mode_; }
+
+    core::uint64_t bytes() const noexcept { return bytes_; }
+    const core::frame::statistics& frame_stats() const noexcept { return frames_.stats(); }
+    const csv::statistics& csv_stats() const noexcept { return lines_.stats(); }
+
+private:
+    /// @brief Look for the first frame delimiter or line feed and set the mode accordingly
+    /// @return Bytes following it, the first complete frame or line starts there
+    core::span<const core::uint8_t> detect(core::span<const core::uint8_t> bytes) noexcept
+    {
+        for (core::size_t i = 0; i < bytes.size(); ++i) {
+            if (bytes[i] == core::cobs::delimiter || bytes[i] == '\n') {
+                mode_ = bytes[i] == '\n' ? format::csv : format::binary;
+                return bytes.subspan(i + 1);
+            }
+        }
+        return {};
+    }
+
+    static capture::source to_source(core::frame::encoding encoding) noexcept
+    {
+        switch (encoding) {
+        case core::frame::encoding::packed10:
+            return capture::source::frame_packed10;
+        case core::frame::encoding::delta:
+            return capture::source::frame_delta;
+        case core::frame::encoding::raw16:
+        default:
+            return capture::source::frame_raw16;
+        }
+    }
+
+    capture::writer& out_;
+    format mode_;
+    core::frame::decoder<> frames_ {};
+    csv::parser lines_ {};
+    core::uint64_t bytes_ {};
+};
+
+} // namespace host::ingest
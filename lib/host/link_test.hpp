@@ -0,0 +1,132 @@
+#pragma once
+
+#include <frame.hpp>
+#include <span.hpp>
+#include <types.hpp>
+#include <utils/uart_link.hpp>
+
+#include <string>
+
+namespace host::link_test {
+
+/// Self-test results
+struct statistics {
+    core::uint64_t bytes; //< Bytes from the first valid frame on
+    core::uint64_t frames; //< Valid frames with the expected pattern
+    core::uint64_t pattern_errors; //< Valid frames carrying other words than the pattern of their sequence
+    core::uint64_t crc_errors;
+    core::uint64_t framing_errors;
+    core::uint64_t dropped_frames; //< Sequence gaps
+    core::uint64_t first_ns; //< Host time of the chunk with the first valid frame
+    core::uint64_t last_ns; //< Host time of the last chunk fed
+
+    /// @brief Frames lost or damaged out of all frames sent
+    double error_rate() const noexcept
+    {
+        const core::uint64_t bad = pattern_errors + crc_errors + framing_errors + dropped_frames;
+        const core::uint64_t total = frames + bad;
+        return total > 0 ? static_cast<double>(bad) / static_cast<double>(total) : 0.0;
+    }
+
+    /// @brief Sustained throughput in bytes per second between the first and the last chunk
+    double bytes_per_second() const noexcept
+    {
+        return last_ns > first_ns ? static_cast<double>(bytes) * 1e9 / static_cast<double>(last_ns - first_ns) : 0.0;
+    }
+};
+
+/// Receiver of the firmware link self-test stream (see core::uart::selftest)
+///
+/// Keeps the "link,..." line if the stream starts with it, then decodes frames and checks every word
+/// against the pattern of its sequence number. Counting starts at the first valid frame, so joining the
+/// stream mid-frame costs nothing; from there any corrupted, truncated or missing frame is an error.
+class checker {
+public:
+    /// @brief Consume one chunk read from the link
+    /// @param[in] now_ns Host time the chunk was read
+    void feed(core::span<const core::uint8_t> bytes, core::uint64_t now_ns)
+    {
+        if (!header_done_) {
+            bytes = read_header(bytes);
+        }
+        if (synced_) {
+            stats_.bytes += bytes.size();
+        }
+        for (core::size_t i = 0; i < bytes.size(); ++i) {
+            if (frames_.feed(bytes[i]) != core::frame::status::packet) {
+                continue;
+            }
+            if (!synced_) {
+                // Baseline: errors of the partial frame the receiver joined in do not count
+                synced_ = true;
+                baseline_ = frames_.stats();
+                stats_.first_ns = now_ns;
+                stats_.bytes += bytes.size() - i - 1;
+                continue;
+            }
+            check(frames_.last());
+        }
+        if (synced_) {
+            stats_.last_ns = now_ns;
+        }
+    }
+
+    /// @brief Results so far
+    statistics stats() const noexcept
+    {
+        statistics result = stats_;
+        const auto& link = frames_.stats();
+        result.crc_errors = link.crc_errors - baseline_.crc_errors;
+        result.framing_errors = link.framing_errors - baseline_.framing_errors;
+        result.dropped_frames = link.dropped_frames - baseline_.dropped_frames;
+        return result;
+    }
+
+    /// @brief "link,<baud>,<actual baud>,<error %>,<ubrr>,<u2x>" line of the firmware, empty if not seen
+    const std::string& header() const noexcept { return header_; }
+
+private:
+    /// @brief Collect the header line if the stream starts with one
+    /// @return Bytes following the header
+    core::span<const core::uint8_t> read_header(core::span<const core::uint8_t> bytes)
+    {
+        static constexpr char prefix[] = "link,";
+        for (core::size_t i = 0; i < bytes.size(); ++i) {
+            const char c = static_cast<char>(bytes[i]);
+            const core::size_t size = header_.size();
+            if (c == '\n' || (size < sizeof(prefix) - 1 && c != prefix[size]) || size >= 64) {
+                // A line feed ends the header, anything else means there is none
+                header_done_ = true;
+                if (c != '\n') {
+                    header_.clear();
+                    return bytes.subspan(i);
+                }
+                if (!header_.empty() && header_.back() == '\r') {
+                    header_.pop_back();
+                }
+                return bytes.subspan(i + 1);
+            }
+            header_.push_back(c);
+        }
+        return {};
+    }
+
+    void check(const core::frame::packet& packet) noexcept
+    {
+        bool expected = packet.channel == 0 && packet.format == core::frame::encoding::raw16
+            && packet.samples.size() == core::uart::selftest::frame_samples;
+        for (core::uint8_t i = 0; expected && i < packet.samples.size(); ++i) {
+            expected = packet.samples[i] == core::uart::selftest::pattern(packet.sequence, i);
+        }
+        ++(expected ? stats_.frames : stats_.pattern_errors);
+    }
+
+    core::frame::decoder<core::uart::selftest::frame_samples> frames_ {};
+    core::frame::statistics baseline_ {};
+    statistics stats_ {};
+    std::string header_;
+    bool header_done_ {};
+    bool synced_ {};
+};
+
+} // namespace host::link_test
@@ -0,0 +1,478 @@
+#pragma once
+
+#include "capture.hpp"
+#include "csv.hpp"
+
+#include <span.hpp>
+#include <types.hpp>
+#include <utils/adc_schedule.hpp>
+#include <utils/uart_queue.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace host::replay {
+
+/// Replay HAL: the firmware drivers backed by traces instead of the ADC and the UART
+///
+/// The firmware acquires through core::adc::scanner and transmits through core::uart::transmitter, and
+/// formats in between with core::output. scanner and link below have the same interfaces and run the same
+/// hardware-free cores, core::adc::scan_sequencer and core::uart::record_queue, with a trace in place of the
+/// ADC data register and a virtual UART in place of USART0. The firmware pipeline thus runs natively at host
+/// speed on recorded or synthetic signals, and verifier checks what comes out of it against the trace.
+
+/// Conversions per second of the firmware scanner: 16 MHz / 128 (ADC prescaler) / 13 ADC clocks
+inline constexpr double conversion_rate_hz = 16e6 / 128 / 13;
+
+/// 10-bit ADC with the 5 V AVcc reference
+inline constexpr double adc_vref = 5.0;
+inline constexpr core::uint16_t adc_max = 1023;
+
+/// Most channels of a trace, the ADC mux has 8 inputs
+inline constexpr core::uint8_t max_channels = 8;
+
+/// Output shape of the SimulIDE WaveGen component
+enum class shape : core::uint8_t {
+    square,
+    sine,
+    triangle,
+    sawtooth,
+};
+
+/// WaveGen settings in the component's units, plus the analog path in front of the ADC
+struct wavegen {
+    shape type;
+    double frequency_hz;
+    double duty; //< High fraction of the period, square only
+    double semi_amplitude_v;
+    double mid_v;
+    double cutoff_hz; //< One-pole low-pass after the generator (RC stages of the circuit), 0 for none
+    core::uint16_t noise_lsb; //< Peak uniform noise added to the codes, deterministic
+};
+
+/// Generator of sim/02-EDO-system.sim1: 1 kHz square at 95 % duty, 0-5 V, straight into the ADC
+inline constexpr wavegen edo_system = { shape::square, 1000.0, 0.95, 2.5, 2.5, 0.0, 0 };
+
+/// @brief Sample a WaveGen signal into 10-bit ADC codes
+/// @param[in] rate_hz Sampling rate, conversion_rate_hz for one channel scanned alone
+/// @param[in] count Samples to generate
+inline std::vector<core::uint16_t> synthesize(const wavegen& wave, double rate_hz, core::size_t count)
+{
+    constexpr double two_pi = 6.283185307179586;
+    const double alpha = wave.cutoff_hz > 0 ? 1.0 - std::exp(-two_pi * wave.cutoff_hz / rate_hz) : 1.0;
+    core::uint32_t noise = 0x2545F491u; // xorshift32 state
+
+    std::vector<core::uint16_t> codes(count);
+    double filtered = 0;
+    for (core::size_t i = 0; i < count; ++i) {
+        double phase = static_cast<double>(i) * wave.frequency_hz / rate_hz;
+        phase -= std::floor(phase);
+        double unit = 0; // -1 to 1
+        switch (wave.type) {
+        case shape::square:
+            unit = phase < wave.duty ? 1.0 : -1.0;
+            break;
+        case shape::sine:
+            unit = std::sin(two_pi * phase);
+            break;
+        case shape::triangle:
+            unit = phase < 0.5 ? 4 * phase - 1 : 3 - 4 * phase;
+            break;
+        case shape::sawtooth:
+            unit = 2 * phase - 1;
+            break;
+        }
+        const double volts = wave.mid_v + wave.semi_amplitude_v * unit;
+        filtered = i == 0 ? volts : filtered + alpha * (volts - filtered);
+
+        long code = std::lround(filtered / adc_vref * adc_max);
+        if (wave.noise_lsb > 0) {
+            noise ^= noise << 13;
+            noise ^= noise >> 17;
+            noise ^= noise << 5;
+            code += static_cast<long>(noise % (2u * wave.noise_lsb + 1)) - wave.noise_lsb;
+        }
+        codes[i] = static_cast<core::uint16_t>(code < 0 ? 0 : code > adc_max ? adc_max : code);
+    }
+    return codes;
+}
+
+/// Per-channel sample sequences to replay
+class trace {
+public:
+    /// @brief Set the samples of a channel (0-7)
+    void assign(core::uint8_t channel, std::vector<core::uint16_t> samples)
+    {
+        if (channel < max_channels) {
+            channels_[channel] = std::move(samples);
+        }
+    }
+
+    /// @brief Samples of a channel, empty if it has none
+    core::span<const core::uint16_t> channel(core::uint8_t channel) const noexcept
+    {
+        return channel < max_channels ? core::span<const core::uint16_t>(channels_[channel])
+                                      : core::span<const core::uint16_t>();
+    }
+
+    /// @brief Samples of all channels
+    core::size_t size() const noexcept
+    {
+        core::size_t total = 0;
+        for (const auto& samples : channels_) {
+            total += samples.size();
+        }
+        return total;
+    }
+
+    /// @brief Load a recording: a capture file written by the ingest tool, or the firmware CSV output
+    /// @return false if the file cannot be read or holds no sample
+    bool load(const char* path)
+    {
+        for (auto& samples : channels_) {
+            samples.clear();
+        }
+
+        capture::reader recording;
+        if (recording.open(path)) {
+            const auto values = recording.values();
+            const auto channels = recording.channels();
+            for (core::size_t i = 0; i < values.size(); ++i) {
+                append(channels[i], values[i]);
+            }
+            return size() > 0;
+        }
+
+        std::FILE* file = std::fopen(path, "rb");
+        if (file == nullptr) {
+            return false;
+        }
+        csv::parser lines;
+        core::uint8_t chunk[4096];
+        core::size_t count = 0;
+        while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            lines.feed(core::span<const core::uint8_t>(chunk, count),
+                [this](core::uint8_t channel, core::uint16_t raw) { append(channel, raw); });
+        }
+        std::fclose(file);
+        return size() > 0;
+    }
+
+private:
+    void append(core::uint8_t channel, core::uint16_t value)
+    {
+        if (channel < max_channels) {
+            channels_[channel].push_back(value);
+        }
+    }
+
+    std::vector<core::uint16_t> channels_[max_channels];
+};
+
+/// core::adc::scanner converting trace samples instead of the ADC
+///
+/// convert() stands for one conversion complete interrupt and feeds the firmware core::adc::scan_sequencer:
+/// the scheduled channel takes its next trace sample, wrapping around (channels without samples read 0).
+/// Traces hold kept samples as recorded, so the settling conversion after a mux switch consumes none, it is
+/// only counted in conversions() to keep the virtual time right.
+///
+/// @tparam Capacity Buffer slots, power of two up to 128.
+/// @tparam Channels Number of scanned channels.
+template <core::uint8_t Capacity, core::uint8_t Channels>
+class scanner {
+public:
+    scanner(const core::adc::channel_config (&config)[Channels], const replay::trace& source)
+        : sequencer_(config)
+        , trace_(source)
+    {
+    }
+
+    /// @brief Start scanning from the first channel and from the start of every trace
+    void start()
+    {
+        sequencer_.restart();
+        conversions_ = 0;
+        kept_ = 0;
+        overruns_ = 0;
+        for (auto& cursor : cursors_) {
+            cursor = 0;
+        }
+    }
+
+    /// @brief Convert the next scheduled sample, as the conversion complete interrupt does
+    /// @return false if the buffer was full and the sample was dropped
+    bool convert()
+    {
+        if (sequencer_.settling()) {
+            ++conversions_;
+            sequencer_.on_conversion(0);
+        }
+        ++conversions_;
+        ++kept_;
+
+        const bool stored = !sequencer_.full();
+        if (!stored) {
+            ++overruns_;
+        }
+        sequencer_.on_conversion(next_value(sequencer_.channel()));
+        return stored;
+    }
+
+    bool pop(core::adc::tagged_sample& sample) { return sequencer_.pop(sample); }
+    core::span<core::adc::tagged_sample> peek() { return sequencer_.peek(); }
+    void release(core::uint8_t count) { sequencer_.release(count); }
+    core::uint8_t available() const { return sequencer_.available(); }
+    core::uint64_t overruns() const noexcept { return overruns_; }
+
+    /// @brief Conversions the ADC would have run so far, settling conversions included
+    core::uint64_t conversions() const noexcept { return conversions_; }
+
+    /// @brief Samples taken from the trace so far, dropped ones included
+    core::uint64_t samples() const noexcept { return kept_; }
+
+private:
+    core::uint16_t next_value(core::uint8_t channel) noexcept
+    {
+        const auto samples = trace_.channel(channel);
+        if (samples.empty()) {
+            return 0;
+        }
+        auto& cursor = cursors_[channel & (max_channels - 1)];
+        const core::uint16_t value = samples[cursor];
+        if (++cursor == samples.size()) {
+            cursor = 0;
+        }
+        return value;
+    }
+
+    core::adc::scan_sequencer<Capacity, Channels> sequencer_;
+    const replay::trace& trace_;
+    core::size_t cursors_[max_channels] {};
+    core::uint64_t conversions_ {};
+    core::uint64_t kept_ {};
+    core::uint64_t overruns_ {}; //< 64-bit count, the sequencer one wraps at 65536
+};
+
+/// What became of a record written to the link
+enum class record_fate : core::uint8_t {
+    queued, //< Still in the transmit queue or on its way out
+    sent, //< Went out on the wire
+    rejected, //< Refused by write() (queue full or decimated), the writer saw false
+    evicted, //< Queued, then dropped for a newer record (core::uart::overflow_policy::drop_oldest)
+};
+
+/// core::uart::transmitter with the firmware queue drained by a virtual UART
+///
+/// write() goes through the firmware core::uart::record_queue and overflow policy, and advance() pops what an
+/// 8N1 UART at baud sends in the elapsed time, so a stream faster than the link saturates the queue and loses
+/// records as on the board. Every record written is kept until deliver() hands it over in write order with
+/// its fate: the bytes popped off the queue for sent records, the written ones for lost records, so the
+/// replay can tell samples lost to the link from samples corrupted on their way.
+///
+/// @tparam Bytes Byte queue capacity of the firmware transmitter
+/// @tparam Records Most records queued at once
+template <core::uint8_t Bytes, core::uint8_t Records>
+class link {
+public:
+    /// @param[in] baud Line rate, 0 for a UART that sends every record as soon as it is queued
+    /// @param[in] policy Overflow policy of the firmware transmitter
+    explicit link(core::uint32_t baud = 0,
+        core::uart::overflow_policy policy = core::uart::overflow_policy::drop_newest) noexcept
+        : baud_(baud)
+    {
+        queue_.set_policy(policy);
+    }
+
+    bool write(core::span<const core::uint8_t> record)
+    {
+        const auto before = queue_.stats();
+        const bool queued = queue_.write(record);
+        const auto& after = queue_.stats();
+
+        entries_.push_back({ data_.size(), static_cast<core::uint8_t>(record.size()), 0,
+            queued ? record_fate::queued : record_fate::rejected });
+        data_.insert(data_.end(), record.begin(), record.end());
+        ++records_;
+
+        // drop_oldest makes room by dropping queued records that have not started, oldest first
+        core::uint32_t evicted = after.dropped - before.dropped;
+        if (!queued && after.decimated == before.decimated) {
+            --evicted; // The rejected record itself
+        }
+        for (core::size_t i = next_; evicted > 0 && i + 1 < entries_.size(); ++i) {
+            auto& entry = entries_[i];
+            if (entry.fate == record_fate::queued && entry.popped == 0) {
+                entry.fate = record_fate::evicted;
+                --evicted;
+            }
+        }
+        if (baud_ == 0) {
+            flush();
+        }
+        return queued;
+    }
+
+    bool write(const char* text, core::size_t size)
+    {
+        return write(core::span<const core::uint8_t>(reinterpret_cast<const core::uint8_t*>(text), size));
+    }
+
+    /// @brief Whether everything queued is on the wire
+    bool idle() const noexcept { return queue_.pending() == 0; }
+
+    /// @brief Send what the UART sends in seconds, nothing carries over while the queue is empty
+    void advance(double seconds) noexcept
+    {
+        if (baud_ == 0) {
+            flush();
+            return;
+        }
+        credit_ += seconds * baud_ / 10;
+        while (credit_ >= 1 && pop()) {
+            credit_ -= 1;
+        }
+        if (queue_.pending() == 0) {
+            credit_ = 0;
+        }
+    }
+
+    /// @brief Send everything queued
+    void flush() noexcept
+    {
+        while (pop()) { }
+    }
+
+    /// @brief Hand over the records whose fate is settled, in write order
+    /// @param[in] on_record Callable taking the record_fate and the record bytes
+    template <class Callback>
+    void deliver(Callback&& on_record)
+    {
+        while (!entries_.empty() && entries_.front().fate != record_fate::queued) {
+            const auto& entry = entries_.front();
+            on_record(entry.fate, core::span<const core::uint8_t>(data_.data() + entry.offset, entry.size));
+            entries_.pop_front();
+            next_ = next_ > 0 ? next_ - 1 : 0;
+        }
+        if (entries_.empty()) {
+            data_.clear();
+        } else if (const core::size_t offset = entries_.front().offset; offset >= 65536) {
+            data_.erase(data_.begin(), data_.begin() + static_cast<long>(offset));
+            for (auto& entry : entries_) {
+                entry.offset -= offset;
+            }
+        }
+    }
+
+    /// @brief Records written, whatever their fate
+    core::uint64_t records() const noexcept { return records_; }
+
+    /// @brief Bytes sent on the wire
+    core::uint64_t bytes() const noexcept { return bytes_; }
+
+    /// @brief Counters of the firmware queue
+    const core::uart::tx_statistics& stats() const noexcept { return queue_.stats(); }
+
+private:
+    struct entry {
+        core::size_t offset; //< Into data_
+        core::uint8_t size;
+        core::uint8_t popped; //< Bytes already sent
+        record_fate fate;
+    };
+
+    /// @brief Send one byte, it belongs to the oldest queued record
+    bool pop() noexcept
+    {
+        core::uint8_t byte = 0;
+        if (!queue_.pop(byte)) {
+            return false;
+        }
+        while (entries_[next_].fate != record_fate::queued) {
+            ++next_;
+        }
+        auto& entry = entries_[next_];
+        data_[entry.offset + entry.popped] = byte;
+        if (++entry.popped == entry.size) {
+            entry.fate = record_fate::sent;
+            ++next_;
+        }
+        ++bytes_;
+        return true;
+    }
+
+    core::uart::record_queue<Bytes, Records> queue_ {};
+    std::deque<entry> entries_;
+    std::vector<core::uint8_t> data_;
+    core::size_t next_ {}; //< Entry the next byte sent belongs to, or an earlier one
+    double credit_ {}; //< Bytes the UART may still send in the current interval
+    core::uint32_t baud_;
+    core::uint64_t records_ {};
+    core::uint64_t bytes_ {};
+};
+
+/// Verification statistics
+struct verification {
+    core::uint64_t samples; //< Decoded samples checked
+    core::uint64_t lost; //< Samples of records the link did not send, checked as well
+    core::uint64_t mismatches; //< Samples differing from the trace, or on a channel without one
+    core::uint64_t first_mismatch; //< Index of the first mismatching sample, valid if mismatches > 0
+};
+
+/// Checks decoded output against the trace it was produced from
+///
+/// Every decoded sample of a channel must be that channel's next trace sample, wrapping around like the
+/// scanner, so any loss, duplication, reordering or corruption between the trace and the decoder shows.
+/// Samples of records the link dropped (see link::deliver()) are checked in their place with lost(), any
+/// other missing sample desynchronizes its channel: every later sample of it mismatches.
+class verifier {
+public:
+    explicit verifier(const replay::trace& expected) noexcept
+        : trace_(expected)
+    {
+    }
+
+    /// @brief Check the next decoded sample
+    /// @return false on a mismatch
+    bool check(core::uint8_t channel, core::uint16_t value) noexcept
+    {
+        ++stats_.samples;
+        return expect(channel, value);
+    }
+
+    /// @brief Check the next sample of a record the link dropped
+    /// @return false on a mismatch
+    bool lost(core::uint8_t channel, core::uint16_t value) noexcept
+    {
+        ++stats_.lost;
+        return expect(channel, value);
+    }
+
+    const verification& stats() const noexcept { return stats_; }
+
+private:
+    bool expect(core::uint8_t channel, core::uint16_t value) noexcept
+    {
+        const auto samples = trace_.channel(channel);
+        bool match = false;
+        if (!samples.empty()) {
+            auto& cursor = cursors_[channel];
+            match = samples[cursor] == value;
+            if (++cursor == samples.size()) {
+                cursor = 0;
+            }
+        }
+        if (!match && stats_.mismatches++ == 0) {
+            stats_.first_mismatch = stats_.samples + stats_.lost - 1;
+        }
+        return match;
+    }
+
+    const replay::trace& trace_;
+    core::size_t cursors_[max_channels] {};
+    verification stats_ {};
+};
+
+} // namespace host::replay
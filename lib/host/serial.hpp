@@ -0,0 +1,103 @@
+#pragma once
+
+#include <span.hpp>
+#include <types.hpp>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace host::serial {
+
+/// @brief termios speed constant of a baud rate, B0 if unsupported
+inline speed_t to_speed(core::uint32_t baud) noexcept
+{
+    switch (baud) {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 500000:
+        return B500000;
+    case 1000000:
+        return B1000000;
+    case 2000000:
+        return B2000000;
+    default:
+        return B0;
+    }
+}
+
+/// @brief Open a serial device, pty, FIFO or file for non-blocking I/O
+///
+/// Terminals are switched to raw 8N1 at baud (ignored by ptys, which run at memory speed).
+/// @return File descriptor, -1 with errno set on failure
+inline int open(const char* path, core::uint32_t baud, bool writable = false) noexcept
+{
+    const int fd = ::open(path, (writable ? O_RDWR : O_RDONLY) | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0 || !::isatty(fd)) {
+        return fd;
+    }
+
+    termios options {};
+    if (::tcgetattr(fd, &options) != 0) {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        return -1;
+    }
+    ::cfmakeraw(&options);
+    options.c_cflag |= CLOCAL | CREAD;
+    // VMIN 1: an empty non-blocking read fails with EAGAIN instead of returning 0, which means end of stream
+    options.c_cc[VMIN] = 1;
+    options.c_cc[VTIME] = 0;
+    if (const speed_t speed = to_speed(baud); speed != B0) {
+        ::cfsetispeed(&options, speed);
+        ::cfsetospeed(&options, speed);
+    }
+    if (::tcsetattr(fd, TCSANOW, &options) != 0) {
+        const int error = errno;
+        ::close(fd);
+        errno = error;
+        return -1;
+    }
+    return fd;
+}
+
+/// @brief Write all bytes to a non-blocking descriptor, waiting for room as needed
+/// @return false on error, errno is set
+inline bool write_all(int fd, core::span<const core::uint8_t> bytes) noexcept
+{
+    core::size_t written = 0;
+    while (written < bytes.size()) {
+        const ssize_t result = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (result > 0) {
+            written += static_cast<core::size_t>(result);
+            continue;
+        }
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            return false;
+        }
+        pollfd ready { fd, POLLOUT, 0 };
+        ::poll(&ready, 1, 100);
+    }
+    return true;
+}
+
+} // namespace host::serial
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <cobs.hpp>
+#include <crc.hpp>
+#include <span.hpp>
+#include <types.hpp>
+#include <utils/trace_buffer.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace host::trace {
+
+/// Decoded event, stamp unwrapped to cycles since the first event of its dump
+struct event {
+    core::uint8_t id;
+    core::trace::kind type;
+    core::uint64_t cycle;
+};
+
+/// One complete dump of the firmware trace ring
+struct dump {
+    core::uint8_t number;
+    std::vector<event> events;
+};
+
+/// Parser statistics
+struct statistics {
+    core::uint64_t chunks; //< Valid chunks
+    core::uint64_t crc_errors; //< Chunks with a trace marker and a bad CRC
+    core::uint64_t incomplete; //< Dumps abandoned with chunks missing
+};
+
+/// @brief Unwrap 16-bit stamps into cycles, assuming consecutive events are less than 65536 cycles apart
+inline std::vector<event> unwrap(core::span<const core::trace::event> raw)
+{
+    std::vector<event> events;
+    events.reserve(raw.size());
+    core::uint64_t cycle = 0;
+    for (core::size_t i = 0; i < raw.size(); ++i) {
+        if (i > 0) {
+            cycle += static_cast<core::uint16_t>(raw[i].stamp - raw[i - 1].stamp);
+        }
+        events.push_back({ core::trace::id_of(raw[i].tag), core::trace::kind_of(raw[i].tag), cycle });
+    }
+    return events;
+}
+
+/// Extracts trace dumps from a serial stream
+///
+/// Binary chunks and "trace:" hex lines are both recognized, interleaved with any other output (CSV lines,
+/// sample frames), so a whole session log can be fed as is.
+class parser {
+public:
+    /// @brief Consume a chunk of the stream, calling on_dump(const dump&) for every complete dump
+    template <class Callback>
+    void feed(core::span<const core::uint8_t> bytes, Callback&& on_dump)
+    {
+        for (const auto byte : bytes) {
+            if (byte == core::cobs::delimiter) {
+                binary_chunk(on_dump);
+                frame_.clear();
+            } else if (frame_.size() <= max_frame) {
+                frame_.push_back(byte);
+            }
+
+            if (byte == '\n') {
+                hex_chunk(on_dump);
+                line_.clear();
+            } else if (line_.size() < max_line) {
+                line_.push_back(static_cast<char>(byte));
+            }
+        }
+    }
+
+    const statistics& stats() const noexcept { return stats_; }
+
+private:
+    static constexpr core::size_t max_frame = core::cobs::max_encoded_size(core::trace::wire::max_chunk_size);
+    static constexpr core::size_t max_line = 512;
+
+    template <class Callback>
+    void binary_chunk(Callback& on_dump)
+    {
+        if (frame_.empty() || frame_.size() > max_frame) {
+            return;
+        }
+        std::vector<core::uint8_t> decoded(frame_.size());
+        const auto raw = core::cobs::decode(frame_, decoded);
+        chunk(raw, on_dump);
+    }
+
+    template <class Callback>
+    void hex_chunk(Callback& on_dump)
+    {
+        // Consoles may decorate lines (simavr colors them), look for the prefix anywhere
+        const auto start = line_.find(core::trace::wire::hex_prefix);
+        if (start == std::string::npos) {
+            return;
+        }
+        std::vector<core::uint8_t> raw;
+        for (auto i = start + sizeof(core::trace::wire::hex_prefix) - 1; i + 1 < line_.size(); i += 2) {
+            const int high = nibble(line_[i]);
+            const int low = nibble(line_[i + 1]);
+            if (high < 0 || low < 0) {
+                break;
+            }
+            raw.push_back(static_cast<core::uint8_t>(high << 4 | low));
+        }
+        chunk(raw, on_dump);
+    }
+
+    static int nibble(char c) noexcept
+    {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        return -1;
+    }
+
+    template <class Callback>
+    void chunk(core::span<const core::uint8_t> raw, Callback& on_dump)
+    {
+        namespace wire = core::trace::wire;
+        if (raw.size() < wire::header_size + wire::trailer_size || raw[1] != wire::marker) {
+            return;
+        }
+        const auto body = raw.first(raw.size() - wire::trailer_size);
+        const core::uint16_t expected = static_cast<core::uint16_t>(raw[raw.size() - 2] | raw[raw.size() - 1] << 8);
+        if (core::crc::ccitt(body) != expected || (body.size() - wire::header_size) % wire::event_size != 0) {
+            ++stats_.crc_errors;
+            return;
+        }
+        ++stats_.chunks;
+
+        const core::uint8_t number = body[0];
+        const core::uint8_t first = body[2];
+        const core::uint8_t total = body[3];
+        if (pending_ && (number != current_.number || total != events_.size())) {
+            ++stats_.incomplete;
+            pending_ = false;
+        }
+        if (!pending_) {
+            current_.number = number;
+            events_.assign(total, {});
+            present_.assign(total, false);
+            received_ = 0;
+            pending_ = true;
+        }
+
+        for (core::size_t offset = wire::header_size; offset < body.size(); offset += wire::event_size) {
+            const core::size_t index = first + (offset - wire::header_size) / wire::event_size;
+            if (index >= total || present_[index]) {
+                continue;
+            }
+            events_[index] = { body[offset], static_cast<core::uint16_t>(body[offset + 1] | body[offset + 2] << 8) };
+            present_[index] = true;
+            ++received_;
+        }
+
+        if (received_ == total) {
+            current_.events = unwrap(events_);
+            pending_ = false;
+            on_dump(static_cast<const dump&>(current_));
+        }
+    }
+
+    std::vector<core::uint8_t> frame_;
+    std::string line_;
+    dump current_ {};
+    std::vector<core::trace::event> events_;
+    std::vector<bool> present_;
+    core::size_t received_ {};
+    bool pending_ {};
+    statistics stats_ {};
+};
+
+/// @brief Cycles between each begin and the matching end of id (regions of one id do not nest)
+inline std::vector<core::uint64_t> durations(const std::vector<event>& events, core::uint8_t id)
+{
+    std::vector<core::uint64_t> result;
+    bool open = false;
+    core::uint64_t start = 0;
+    for (const auto& item : events) {
+        if (item.id != id) {
+            continue;
+        }
+        if (item.type == core::trace::kind::begin) {
+            open = true;
+            start = item.cycle;
+        } else if (item.type == core::trace::kind::end && open) {
+            result.push_back(item.cycle - start);
+            open = false;
+        }
+    }
+    return result;
+}
+
+/// @brief Cycles from the last begin/instant of from to each following end/instant of to
+///
+/// Events of from are matched once: a to event without a new from event since the previous match is ignored.
+inline std::vector<core::uint64_t> latencies(const std::vector<event>& events, core::uint8_t from, core::uint8_t to)
+{
+    std::vector<core::uint64_t> result;
+    bool armed = false;
+    core::uint64_t start = 0;
+    for (const auto& item : events) {
+        if (item.id == from && item.type != core::trace::kind::end) {
+            armed = true;
+            start = item.cycle;
+        } else if (item.id == to && item.type != core::trace::kind::begin && armed) {
+            result.push_back(item.cycle - start);
+            armed = false;
+        }
+    }
+    return result;
+}
+
+/// Distribution summary of cycle counts
+struct summary {
+    core::size_t count;
+    core::uint64_t min;
+    core::uint64_t p50;
+    core::uint64_t p99;
+    core::uint64_t max;
+    double mean;
+};
+
+inline summary summarize(std::vector<core::uint64_t> values)
+{
+    if (values.empty()) {
+        return {};
+    }
+    std::sort(values.begin(), values.end());
+    const auto rank = [&values](double p) {
+        const auto index = static_cast<core::size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+        return values[index];
+    };
+    double total = 0;
+    for (const auto value : values) {
+        total += static_cast<double>(value);
+    }
+    return { values.size(), values.front(), rank(0.5), rank(0.99), values.back(),
+        total / static_cast<double>(values.size()) };
+}
+
+/// @brief Text histogram with power-of-two cycle buckets, one line per non-empty bucket
+inline std::string histogram(const std::vector<core::uint64_t>& values, double cycles_per_us)
+{
+    std::map<unsigned, core::size_t> buckets;
+    core::size_t largest = 0;
+    for (const auto value : values) {
+        // Bucket b holds [2^(b-1), 2^b), bucket 0 the zeros
+        unsigned bucket = 0;
+        while (bucket < 64 && (value >> bucket) != 0) {
+            ++bucket;
+        }
+        largest = std::max(largest, ++buckets[bucket]);
+    }
+
+    std::string out;
+    char line[160];
+    for (const auto& [bucket, count] : buckets) {
+        const core::uint64_t low = bucket == 0 ? 0 : core::uint64_t { 1 } << (bucket - 1);
+        const core::uint64_t high = core::uint64_t { 1 } << bucket;
+        const int width = static_cast<int>(40 * count / largest);
+        std::snprintf(line, sizeof(line), "  [%8llu, %8llu) cycles %9.2f us %8zu %.*s\n",
+            static_cast<unsigned long long>(low), static_cast<unsigned long long>(high),
+            static_cast<double>(low) / cycles_per_us, count, width == 0 ? 1 : width,
+            "########################################");
+        out += line;
+    }
+    return out;
+}
+
+namespace detail {
+
+    /// @brief Chrome trace phase of an event kind, instants are thread-scoped
+    inline const char* phase(core::trace::kind type) noexcept
+    {
+        switch (type) {
+        case core::trace::kind::begin:
+            return "B";
+        case core::trace::kind::end:
+            return "E";
+        case core::trace::kind::instant:
+        default:
+            return "i\",\"s\":\"t";
+        }
+    }
+
+} // namespace detail
+
+/// @brief Chrome trace event format (chrome://tracing, ui.perfetto.dev) of a series of dumps
+///
+/// Dumps are laid out one after the other on a single track, separated by a gap: the cycle count does not
+/// relate dumps to each other. Regions become B/E duration events, instants thread-scoped i events.
+/// @param[in] names Event names by id, "id<n>" when missing
+/// @param[in] cycles_per_us CPU clock in MHz
+inline std::string chrome_json(const std::vector<dump>& dumps, const std::vector<std::string>& names,
+    double cycles_per_us)
+{
+    const auto name = [&names](core::uint8_t id) {
+        return id < names.size() && !names[id].empty() ? names[id] : "id" + std::to_string(id);
+    };
+
+    std::string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    char entry[256];
+    core::uint64_t base = 0;
+    for (const auto& item : dumps) {
+        for (const auto& e : item.events) {
+            std::snprintf(entry, sizeof(entry),
+                "%s\n{\"name\":\"%s\",\"ph\":\"%s\",\"ts\":%.4f,\"pid\":1,\"tid\":1,\"args\":{\"dump\":%u}}",
+                first ? "" : ",", name(e.id).c_str(), detail::phase(e.type), static_cast<double>(base + e.cycle) / cycles_per_us,
+                item.number);
+            out += entry;
+            first = false;
+        }
+        const core::uint64_t length = item.events.empty() ? 0 : item.events.back().cycle;
+        base += length + static_cast<core::uint64_t>(100 * cycles_per_us);
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+} // namespace host::trace
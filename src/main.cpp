@@ -1,19 +1,198 @@
 #include <Arduino.h>
 
+#include "firmware_config.hpp"
+
+#include <fmt.hpp>
+#include <frame.hpp>
+#include <stats.hpp>
 #include <utils/adc.hpp>
+#include <utils/adc_quiet.hpp>
+#include <utils/adc_scanner.hpp>
+#include <utils/mem.hpp>
+#include <utils/output.hpp>
+#include <utils/sched.hpp>
+#include <utils/trace.hpp>
+#include <utils/trigger.hpp>
+#include <utils/uart_link.hpp>
+#include <utils/uart_tx.hpp>
+
+/// Scanner of the selected acquisition mode (see firmware_config.hpp)
+#ifdef ACQUISITION_NOISE_REDUCTION
+using sensor_scanner = core::adc::quiet_scanner<SAMPLE_BUFFER_SLOTS, SENSOR_CHANNEL_COUNT>;
+#else
+using sensor_scanner = core::adc::scanner<SAMPLE_BUFFER_SLOTS, SENSOR_CHANNEL_COUNT>;
+#endif
+
+/// UBRR/U2X setting of LINK_BAUD, rejected at compile time if out of tolerance
+constexpr core::uart::link_setting LINK = core::uart::link_config<F_CPU, LINK_BAUD>::setting;
+
+CORE_MEM_PAINT_STACK_AT_BOOT()
+
+/// Trace point ids (see core::trace, compiled in with -D CORE_TRACE)
+enum trace_id : uint8_t {
+    TRACE_ADC_ISR, //< ADC conversion complete handler
+    TRACE_UART_ISR, //< UART data register empty handler
+    TRACE_UART_IDLE, //< Last queued byte handed to the UART
+    TRACE_OUTPUT, //< Formatting and queuing one record or summarized sample, or a capture burst
+};
+
+/// Byte to send to the board to get the trace ring dumped
+constexpr uint8_t TRACE_DUMP_REQUEST = 'T';
+
+sensor_scanner adc_scanner(SENSOR_CHANNELS);
+core::uart::transmitter<UART_QUEUE_BYTES, UART_QUEUE_RECORDS> uart_tx;
+core::mem::monitor mem_monitor(MEM_REPORT_PERIOD);
+core::trigger::capture<CAPTURE_MODE ? CAPTURE_CAPACITY : 2> capture;
+core::output::stage<OUTPUT_MODE, FRAME_MAX_SAMPLES, FRAME_ENCODING> output;
+summary_window summaries[SENSOR_CHANNEL_COUNT];
+
+ISR(ADC_vect)
+{
+    const core::trace::scope traced(TRACE_ADC_ISR);
+    if constexpr (CAPTURE_MODE) {
+        capture.on_sample(ADC);
+    } else {
+        adc_scanner.on_conversion();
+    }
+}
+
+ISR(TIMER2_COMPA_vect)
+{
+    core::sched::timer2::on_tick();
+}
 
-constexpr uint8_t SENSOR_INPUT_PIN = A0;
+ISR(USART_UDRE_vect)
+{
+    const core::trace::scope traced(TRACE_UART_ISR);
+    uart_tx.on_data_register_empty();
+    if (bit_is_clear(UCSR0B, UDRIE0)) {
+        core::trace::instant(TRACE_UART_IDLE);
+    }
+}
+
+/// @brief Hand the buffered samples, their window summaries or the capture window to the UART in the selected
+/// output format
+void transmit_samples()
+{
+#ifdef ACQUISITION_NOISE_REDUCTION
+    // Sleeping halts the UART clock, convert only once the previous burst is on the wire
+    if (uart_tx.idle()) {
+        adc_scanner.acquire(QUIET_BURST);
+    }
+#endif
+    if constexpr (CAPTURE_MODE) {
+        const core::trace::scope traced(TRACE_OUTPUT);
+        output.send_capture(capture, uart_tx, CAPTURE_CHANNEL);
+    } else if constexpr (SUMMARY_MODE) {
+        while (adc_scanner.available() != 0) {
+            const core::trace::scope traced(TRACE_OUTPUT);
+            output.summarize_next(adc_scanner, SENSOR_CHANNELS, summaries, uart_tx);
+        }
+    } else {
+        while (adc_scanner.available() != 0) {
+            const core::trace::scope traced(TRACE_OUTPUT);
+            output.send_next(adc_scanner, uart_tx);
+        }
+    }
+}
+
+/// @brief Keep the transmit queue topped up with self-test frames
+void send_selftest_frames()
+{
+    static uint8_t sequence = 0;
+    while (uart_tx.pending() <= UART_QUEUE_BYTES - core::uart::selftest::frame_size) {
+        uint8_t wire[core::uart::selftest::frame_size];
+        uart_tx.write(core::uart::selftest::encode(sequence++, wire));
+    }
+}
+
+/// @brief Dump the trace ring as binary chunks when TRACE_DUMP_REQUEST is received
+void serve_trace_requests()
+{
+    if (bit_is_clear(UCSR0A, RXC0)) {
+        return;
+    }
+    if (UDR0 == TRACE_DUMP_REQUEST) {
+        core::trace::dump([](core::span<const uint8_t> chunk) {
+            while (!uart_tx.write(chunk)) { }
+        });
+    }
+}
+
+void housekeeping();
+
+/// Tasks in priority order, periods and deadlines in 1 ms ticks (see core::sched)
+constexpr core::sched::task TASKS[] = {
+    { transmit_samples, TRANSMIT_PERIOD_MS, 0, 0 },
+    { serve_trace_requests, 20, 0, 1 },
+    { housekeeping, 100, 0, 3 },
+};
+
+core::sched::scheduler<sizeof(TASKS) / sizeof(TASKS[0]), core::sched::timer2> scheduler(TASKS);
+
+/// @brief Periodic RAM usage and task timing reports
+void housekeeping()
+{
+    if constexpr (OUTPUT_MODE == core::output::mode::csv) {
+        const auto sink = [](core::span<char> line) { uart_tx.write(line.data(), line.size()); };
+        const uint32_t now = millis();
+        if constexpr (MEM_REPORT_PERIOD > 0) {
+            mem_monitor.poll(now, sink);
+        }
+        if constexpr (SCHED_REPORT_PERIOD > 0) {
+            static uint32_t last_report = 0;
+            if (now - last_report >= SCHED_REPORT_PERIOD) {
+                last_report = now;
+                core::sched::report(scheduler, sink);
+            }
+        }
+    }
+}
 
 void setup()
 {
-    Serial.begin(9600);
-    pinMode(SENSOR_INPUT_PIN, INPUT);
+    uart_tx.begin(LINK);
+    uart_tx.set_policy(UART_OVERFLOW_POLICY);
+    if constexpr (SELFTEST_MODE) {
+        char line[48];
+        core::fmt::writer out(line);
+        core::uart::format(out, LINK).append("\r\n");
+        uart_tx.write(out.written().data(), out.size());
+        return;
+    }
+    if constexpr (core::trace::enabled) {
+        core::trace::start();
+        UCSR0B |= _BV(RXEN0);
+    }
+    for (const auto& input : SENSOR_CHANNELS) {
+        pinMode(A0 + input.channel, INPUT);
+    }
+
+    if constexpr (SUMMARY_MODE) {
+        constexpr char header[] = "stats; Channel; Count; Mean; Min; Max; RMS; Variance;\r\n";
+        uart_tx.write(header, sizeof(header) - 1);
+    } else if constexpr (OUTPUT_MODE == core::output::mode::csv) {
+        constexpr char header[] = "Channel; ADC; Voltage;\r\n";
+        uart_tx.write(header, sizeof(header) - 1);
+    }
 
-    Serial.println("ADC; Voltage;");
+    if constexpr (CAPTURE_MODE) {
+        capture.arm(CAPTURE_SETTINGS);
+        core::adc::start_free_running(CAPTURE_CHANNEL);
+    } else {
+        adc_scanner.start();
+    }
+    core::sched::timer2::start();
+    scheduler.start();
 }
 
 void loop()
 {
-    const auto adc_raw_value = core::adc::read_raw(SENSOR_INPUT_PIN);
-    Serial.println(core::adc::to_string(adc_raw_value));
+    if constexpr (SELFTEST_MODE) {
+        send_selftest_frames();
+        return;
+    }
+    if (!scheduler.dispatch()) {
+        core::sched::idle(scheduler);
+    }
 }
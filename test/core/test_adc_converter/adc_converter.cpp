@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <utils/adc_converter.hpp>
+
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+/// Checks every code against the exact division and a double precision reference
+template <class Converter>
+void expect_exact_for_all_codes(core::adc::rounding round)
+{
+    for (uint32_t raw = 0; raw <= Converter::max_raw; ++raw) {
+        const double real = static_cast<double>(raw) * Converter::vref_mv / Converter::max_raw;
+        const auto expected = static_cast<uint16_t>(
+            round == core::adc::rounding::nearest ? std::floor(real + 0.5) : std::floor(real));
+        const auto code = static_cast<uint16_t>(raw);
+
+        ASSERT_EQ(Converter::to_mv_exact(code), expected) << "raw=" << raw;
+        ASSERT_EQ(Converter::to_mv(code), expected) << "raw=" << raw;
+    }
+}
+
+} // namespace
+
+TEST(AdcConverterTest, test_endpoints)
+{
+    using converter = core::adc::converter<10, 5000>;
+    static_assert(converter::max_raw == 1023);
+    static_assert(converter::to_mv(0) == 0);
+    static_assert(converter::to_mv(1023) == 5000);
+    static_assert(converter::to_mv(512) == 2502);
+    static_assert(converter::uses_reciprocal);
+
+    using converter_3v3 = core::adc::converter<12, 3300>;
+    static_assert(converter_3v3::to_mv(0) == 0);
+    static_assert(converter_3v3::to_mv(4095) == 3300);
+
+    SUCCEED();
+}
+
+TEST(AdcConverterTest, test_nearest_all_codes)
+{
+    using core::adc::rounding;
+    expect_exact_for_all_codes<core::adc::converter<8, 5000>>(rounding::nearest);
+    expect_exact_for_all_codes<core::adc::converter<10, 5000>>(rounding::nearest);
+    expect_exact_for_all_codes<core::adc::converter<10, 3300>>(rounding::nearest);
+    expect_exact_for_all_codes<core::adc::converter<10, 1100>>(rounding::nearest);
+    expect_exact_for_all_codes<core::adc::converter<11, 5000>>(rounding::nearest);
+    expect_exact_for_all_codes<core::adc::converter<12, 5000>>(rounding::nearest);
+    expect_exact_for_all_codes<core::adc::converter<13, 5000>>(rounding::nearest);
+}
+
+TEST(AdcConverterTest, test_toward_zero_all_codes)
+{
+    using core::adc::rounding;
+    expect_exact_for_all_codes<core::adc::converter<10, 5000, rounding::toward_zero>>(rounding::toward_zero);
+    expect_exact_for_all_codes<core::adc::converter<12, 5000, rounding::toward_zero>>(rounding::toward_zero);
+}
+
+TEST(AdcConverterTest, test_division_fallback)
+{
+    // No 32-bit reciprocal is exact for every 12-bit code at 5V, to_mv() must still be exact
+    static_assert(!core::adc::converter<12, 5000>::uses_reciprocal);
+    static_assert(core::adc::converter<12, 5000>::to_mv(4095) == 5000);
+    static_assert(core::adc::converter<13, 5000>::uses_reciprocal);
+
+    SUCCEED();
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
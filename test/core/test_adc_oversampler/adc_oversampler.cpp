@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <utils/adc_oversampler.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+TEST(AdcOversamplerTest, test_parameters)
+{
+    using os1 = core::adc::oversampler<1>;
+    using os3 = core::adc::oversampler<3>;
+    using os4 = core::adc::oversampler<4>;
+
+    static_assert(os1::window == 4 && os1::output_bits == 11 && os1::full_scale == 2046);
+    static_assert(os3::window == 64 && os3::output_bits == 13 && os3::full_scale == 8184);
+    static_assert(os4::window == 256 && os4::output_bits == 14 && os4::full_scale == 16368);
+
+    // 64 * 1023 + 4 fits 16 bits, 256 * 1023 does not
+    static_assert(std::is_same_v<os3::accumulator_type, uint16_t>);
+    static_assert(std::is_same_v<os4::accumulator_type, uint32_t>);
+
+    SUCCEED();
+}
+
+TEST(AdcOversamplerTest, test_window_and_reset)
+{
+    core::adc::oversampler<2> os {};
+
+    for (int i = 0; i < 15; ++i) {
+        EXPECT_FALSE(os.push(100));
+    }
+    EXPECT_EQ(os.pending(), 15u);
+    EXPECT_TRUE(os.push(100));
+    EXPECT_EQ(os.pending(), 0u);
+    EXPECT_EQ(os.value(), 400u); // 100 << 2
+
+    os.push(1023);
+    os.reset();
+    EXPECT_EQ(os.pending(), 0u);
+    for (int i = 0; i < 16; ++i) {
+        os.push(1023);
+    }
+    EXPECT_EQ(os.value(), core::adc::oversampler<2>::full_scale);
+}
+
+TEST(AdcOversamplerTest, test_resolves_sub_lsb_level)
+{
+    // A level of 512.25 LSB dithered by noise: 1 in 4 samples reads 513
+    core::adc::oversampler<2> os {};
+    bool ready = false;
+    for (int i = 0; i < 16; ++i) {
+        ready = os.push(i % 4 == 0 ? 513 : 512);
+    }
+    ASSERT_TRUE(ready);
+    EXPECT_EQ(os.value(), 2049u); // 512.25 * 4
+}
+
+TEST(AdcOversamplerTest, test_rounding)
+{
+    core::adc::oversampler<1> os {};
+    // Sum 1 + 0 + 0 + 0 = 1, / 2 = 0.5 rounds up
+    os.push(1);
+    os.push(0);
+    os.push(0);
+    EXPECT_TRUE(os.push(0));
+    EXPECT_EQ(os.value(), 1u);
+}
+
+TEST(AdcOversamplerTest, test_mv_conversion)
+{
+    using os3 = core::adc::oversampler<3>;
+    using converter = os3::mv_converter<5000>;
+
+    static_assert(converter::to_mv(0) == 0);
+    static_assert(converter::to_mv(os3::full_scale) == 5000);
+    // Mid-scale 10-bit code 512 maps to the same voltage once oversampled
+    static_assert(converter::to_mv(512 << 3) == 2502);
+
+    for (uint32_t value = 0; value <= os3::full_scale; ++value) {
+        const auto expected = static_cast<uint16_t>((value * 5000 + os3::full_scale / 2) / os3::full_scale);
+        ASSERT_EQ(converter::to_mv(static_cast<uint16_t>(value)), expected) << "value=" << value;
+    }
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
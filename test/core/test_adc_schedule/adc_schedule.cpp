@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <utils/adc_schedule.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+template <uint8_t Channels>
+std::vector<uint8_t> take(core::adc::scan_schedule<Channels>& schedule, size_t count)
+{
+    std::vector<uint8_t> sequence;
+    for (size_t i = 0; i < count; ++i) {
+        sequence.push_back(schedule.next());
+    }
+    return sequence;
+}
+
+} // namespace
+
+TEST(AdcScheduleTest, test_round_robin)
+{
+    constexpr core::adc::channel_config config[] = { { 0, 1 }, { 3, 1 }, { 7, 1 } };
+    core::adc::scan_schedule<3> schedule(config);
+
+    EXPECT_EQ(take(schedule, 7), (std::vector<uint8_t> { 0, 3, 7, 0, 3, 7, 0 }));
+}
+
+TEST(AdcScheduleTest, test_rate_divisors)
+{
+    constexpr core::adc::channel_config config[] = { { 0, 1 }, { 1, 4 }, { 2, 2 } };
+    core::adc::scan_schedule<3> schedule(config);
+
+    EXPECT_EQ(take(schedule, 10), (std::vector<uint8_t> { 0, 1, 2, 0, 0, 2, 0, 0, 1, 2 }));
+
+    // Over any whole number of 4-round periods the rates are exactly 4:1:2
+    schedule.reset();
+    unsigned counts[3] = {};
+    for (const auto channel : take(schedule, 7 * 100)) {
+        ++counts[channel];
+    }
+    EXPECT_EQ(counts[0], 400u);
+    EXPECT_EQ(counts[1], 100u);
+    EXPECT_EQ(counts[2], 200u);
+}
+
+TEST(AdcScheduleTest, test_skips_empty_rounds)
+{
+    // No channel at divisor 1: idle rounds are skipped, rates stay 2:1
+    constexpr core::adc::channel_config config[] = { { 4, 2 }, { 5, 4 } };
+    core::adc::scan_schedule<2> schedule(config);
+
+    EXPECT_EQ(take(schedule, 6), (std::vector<uint8_t> { 4, 5, 4, 4, 5, 4 }));
+}
+
+TEST(AdcScheduleTest, test_reset_and_zero_divisor)
+{
+    constexpr core::adc::channel_config config[] = { { 1, 0 }, { 2, 3 } };
+    core::adc::scan_schedule<2> schedule(config);
+    static_assert(core::adc::scan_schedule<2>::size() == 2);
+
+    // Divisor 0 is treated as 1
+    EXPECT_EQ(take(schedule, 4), (std::vector<uint8_t> { 1, 2, 1, 1 }));
+    schedule.reset();
+    EXPECT_EQ(take(schedule, 2), (std::vector<uint8_t> { 1, 2 }));
+}
+
+TEST(AdcScheduleTest, test_sequencer_settles_after_mux_switch)
+{
+    constexpr core::adc::channel_config config[] = { { 0, 1 }, { 1, 2 } };
+    core::adc::scan_sequencer<4, 2> sequencer(config);
+
+    // Every conversion after a mux switch, the first one included, is discarded
+    EXPECT_EQ(sequencer.restart(), 0u);
+    EXPECT_TRUE(sequencer.settling());
+    EXPECT_FALSE(sequencer.on_conversion(999));
+    EXPECT_TRUE(sequencer.on_conversion(100)); // 0 -> 1
+    EXPECT_EQ(sequencer.channel(), 1u);
+    EXPECT_FALSE(sequencer.on_conversion(999));
+    EXPECT_TRUE(sequencer.on_conversion(200)); // 1 -> 0
+    EXPECT_FALSE(sequencer.on_conversion(999));
+    EXPECT_FALSE(sequencer.on_conversion(101)); // 0 -> 0, no switch and no settling
+    EXPECT_FALSE(sequencer.settling());
+    EXPECT_TRUE(sequencer.on_conversion(102)); // 0 -> 1
+
+    core::adc::tagged_sample sample;
+    std::vector<uint16_t> values;
+    while (sequencer.pop(sample)) {
+        values.push_back(static_cast<uint16_t>(sample.channel() << 12 | sample.value()));
+    }
+    EXPECT_EQ(values, (std::vector<uint16_t> { 100, 1 << 12 | 200, 101, 102 }));
+
+    // A full buffer drops and counts, restart() empties it
+    sequencer.on_conversion(999);
+    for (uint16_t value = 0; value < 6; ++value) {
+        sequencer.on_conversion(value);
+        if (sequencer.settling()) {
+            sequencer.on_conversion(999);
+        }
+    }
+    EXPECT_TRUE(sequencer.full());
+    EXPECT_EQ(sequencer.overruns(), 2u);
+    EXPECT_EQ(sequencer.restart(), 0u);
+    EXPECT_EQ(sequencer.available(), 0u);
+    EXPECT_EQ(sequencer.overruns(), 0u);
+}
+
+TEST(AdcScheduleTest, test_tagged_sample)
+{
+    constexpr auto sample = core::adc::tagged_sample::make(7, 1023);
+    static_assert(sample.channel() == 7 && sample.value() == 1023);
+    static_assert(sizeof(core::adc::tagged_sample) == 2);
+
+    for (uint8_t channel = 0; channel < 8; ++channel) {
+        for (uint16_t value = 0; value < 1024; value += 31) {
+            const auto tagged = core::adc::tagged_sample::make(channel, value);
+            ASSERT_EQ(tagged.channel(), channel);
+            ASSERT_EQ(tagged.value(), value);
+        }
+    }
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
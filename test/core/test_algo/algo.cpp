@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <algo.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+TEST(AlgoTest, test_widened_types)
+{
+    static_assert(std::is_same_v<core::algo::widened_t<uint8_t>, uint16_t>);
+    static_assert(std::is_same_v<core::algo::widened_t<const uint16_t>, uint32_t>);
+    static_assert(std::is_same_v<core::algo::widened_t<int16_t>, int32_t>);
+    static_assert(std::is_same_v<core::algo::widened_t<uint32_t>, uint64_t>);
+    SUCCEED();
+}
+
+TEST(AlgoTest, test_min_max)
+{
+    static constexpr uint16_t samples[] = { 512, 3, 1023, 700, 3, 1000 };
+    const core::span<const uint16_t> view(samples);
+
+    EXPECT_EQ(core::algo::min(view), 3u);
+    EXPECT_EQ(core::algo::max(view), 1023u);
+    const auto range = core::algo::minmax(view);
+    EXPECT_EQ(range.min, 3u);
+    EXPECT_EQ(range.max, 1023u);
+
+    const int16_t signed_samples[] = { -5, 7, -300, 2 };
+    const auto signed_range = core::algo::minmax(core::span<const int16_t>(signed_samples));
+    EXPECT_EQ(signed_range.min, -300);
+    EXPECT_EQ(signed_range.max, 7);
+
+    // Single element and decreasing sequences
+    const uint8_t single[] = { 42 };
+    EXPECT_EQ(core::algo::minmax(core::span<const uint8_t>(single)).min, 42);
+    EXPECT_EQ(core::algo::minmax(core::span<const uint8_t>(single)).max, 42);
+    const uint8_t decreasing[] = { 9, 8, 7, 1 };
+    EXPECT_EQ(core::algo::minmax(core::span<const uint8_t>(decreasing)).max, 9);
+    EXPECT_EQ(core::algo::minmax(core::span<const uint8_t>(decreasing)).min, 1);
+
+    static_assert(core::algo::max(core::span<const uint16_t>(samples)) == 1023);
+}
+
+TEST(AlgoTest, test_sum_widens)
+{
+    std::vector<uint16_t> samples(1000, 0xFFFF);
+    const auto total = core::algo::sum(core::span<uint16_t>(samples.data(), samples.size()));
+    static_assert(std::is_same_v<decltype(total), const uint32_t>);
+    EXPECT_EQ(total, 1000u * 0xFFFF);
+
+    std::vector<uint8_t> bytes(257, 0xFF);
+    EXPECT_EQ(core::algo::sum(core::span<const uint8_t>(bytes.data(), bytes.size())), 257u * 0xFF);
+
+    // Longer 8-bit spans need an explicit accumulator
+    bytes.resize(1000, 0xFF);
+    EXPECT_EQ((core::algo::sum<const uint8_t, uint32_t>({ bytes.data(), bytes.size() })), 1000u * 0xFF);
+
+    const int16_t signed_samples[] = { -32768, -32768, 100 };
+    EXPECT_EQ(core::algo::sum(core::span<const int16_t>(signed_samples)), -65436);
+}
+
+TEST(AlgoTest, test_sum_bounded)
+{
+    std::vector<uint16_t> samples(4000);
+    uint32_t expected = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<uint16_t>((i * 37) & 0x3FF);
+        expected += samples[i];
+    }
+    EXPECT_EQ(core::algo::sum_bounded<1023>({ samples.data(), samples.size() }), expected);
+    EXPECT_EQ(core::algo::sum_bounded<1023>({ samples.data(), 0 }), 0u);
+}
+
+TEST(AlgoTest, test_mean_rounding)
+{
+    const uint16_t samples[] = { 1, 2 };
+    EXPECT_EQ(core::algo::mean(core::span<const uint16_t>(samples)), 2u); // 1.5 rounds up
+    const uint16_t thirds[] = { 1, 1, 2 };
+    EXPECT_EQ(core::algo::mean(core::span<const uint16_t>(thirds)), 1u);
+
+    const int16_t negative[] = { -1, -2 };
+    EXPECT_EQ(core::algo::mean(core::span<const int16_t>(negative)), -2); // -1.5 rounds away from zero
+    const int16_t mixed[] = { -32768, 32767, 32767 };
+    EXPECT_EQ(core::algo::mean(core::span<const int16_t>(mixed)), 10922);
+
+    std::vector<uint16_t> full(300, 0xFFFF);
+    EXPECT_EQ(core::algo::mean(core::span<const uint16_t>(full.data(), full.size())), 0xFFFFu);
+}
+
+TEST(AlgoTest, test_fill_copy)
+{
+    uint16_t block[16] {};
+    core::algo::fill(core::span<uint16_t>(block), 512);
+    for (const auto value : block) {
+        EXPECT_EQ(value, 512u);
+    }
+
+    const uint16_t source[] = { 1, 2, 3, 4 };
+    uint16_t destination[3] {};
+    const auto written = core::algo::copy(core::span<const uint16_t>(source), core::span<uint16_t>(destination));
+    EXPECT_EQ(written.size(), 3u);
+    EXPECT_EQ(written.data(), destination);
+    EXPECT_EQ(destination[2], 3u);
+
+    // Non-const source spans are accepted too
+    uint16_t larger[8] {};
+    EXPECT_EQ(core::algo::copy(core::span<uint16_t>(destination), core::span<uint16_t>(larger)).size(), 3u);
+    EXPECT_EQ(larger[0], 1u);
+    EXPECT_EQ(larger[3], 0u);
+
+    constexpr auto copied = [] {
+        const uint8_t in[] = { 4, 5 };
+        uint8_t out[2] {};
+        core::algo::copy(core::span<const uint8_t>(in), core::span<uint8_t>(out));
+        return out[0] + out[1];
+    }();
+    static_assert(copied == 9);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
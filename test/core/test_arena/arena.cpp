@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <arena.hpp>
+
+#include <cstdint>
+
+TEST(ArenaTest, test_bump_allocation)
+{
+    core::static_arena<64> arena {};
+    EXPECT_EQ(arena.capacity(), 64u);
+    EXPECT_EQ(arena.used(), 0u);
+
+    auto bytes = arena.allocate<uint8_t>(3);
+    ASSERT_EQ(bytes.size(), 3u);
+    EXPECT_EQ(arena.used(), 3u);
+
+    // Aligned to the element type, consecutive allocations do not overlap
+    auto words = arena.allocate<uint32_t>(4);
+    ASSERT_EQ(words.size(), 4u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(words.data()) % alignof(uint32_t), 0u);
+    EXPECT_GE(reinterpret_cast<const uint8_t*>(words.data()), bytes.data() + bytes.size());
+    EXPECT_EQ(arena.used(), 4u + 16u);
+    EXPECT_EQ(arena.remaining(), 64u - 20u);
+
+    for (auto& word : words) {
+        word = 0xDEADBEEF;
+    }
+    bytes[2] = 0x42;
+    EXPECT_EQ(bytes[2], 0x42);
+    EXPECT_EQ(words[0], 0xDEADBEEFu);
+}
+
+TEST(ArenaTest, test_exhaustion)
+{
+    core::static_arena<32> arena {};
+    EXPECT_EQ(arena.allocate<uint16_t>(16).size(), 16u);
+    EXPECT_TRUE(arena.allocate<uint8_t>(1).empty());
+    EXPECT_EQ(arena.used(), 32u);
+
+    arena.reset();
+    EXPECT_TRUE(arena.allocate<uint8_t>(33).empty());
+    EXPECT_TRUE(arena.allocate<uint8_t>(0).empty());
+    // Multiplication must not wrap around
+    EXPECT_TRUE(arena.allocate<uint32_t>(static_cast<size_t>(-1) / 2).empty());
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(ArenaTest, test_markers_and_scopes)
+{
+    core::static_arena<128> arena {};
+    arena.allocate<uint8_t>(10);
+    const auto marker = arena.mark();
+    {
+        const auto scope = arena.make_scope();
+        arena.allocate<uint8_t>(50);
+        {
+            const auto inner = arena.make_scope();
+            arena.allocate<uint8_t>(40);
+            EXPECT_EQ(arena.used(), 100u);
+        }
+        EXPECT_EQ(arena.used(), 60u);
+    }
+    EXPECT_EQ(arena.used(), marker);
+    EXPECT_EQ(arena.high_water(), 100u);
+
+    // Releasing to a newer marker than the current state is a no-op
+    arena.release(120);
+    EXPECT_EQ(arena.used(), 10u);
+    arena.release(0);
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.high_water(), 100u);
+}
+
+TEST(ArenaTest, test_allocate_bytes_alignment)
+{
+    core::static_arena<64> arena {};
+    arena.allocate_bytes(1);
+    const auto aligned = arena.allocate_bytes(8, 8);
+    ASSERT_EQ(aligned.size(), 8u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned.data()) % 8, 0u);
+    EXPECT_EQ(arena.used(), 16u);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
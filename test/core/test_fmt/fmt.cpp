@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <fmt.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace {
+
+std::string to_std_string(core::span<char> text)
+{
+    return std::string(text.data(), text.size());
+}
+
+constexpr bool equals(core::span<char> text, const char* expected)
+{
+    core::size_t i = 0;
+    for (; i < text.size(); ++i) {
+        if (expected[i] != text[i]) {
+            return false;
+        }
+    }
+    return expected[i] == '\0';
+}
+
+} // namespace
+
+TEST(FmtTest, test_div10_all_16bit_values)
+{
+    for (uint32_t x = 0; x <= 0xFFFF; ++x) {
+        ASSERT_EQ(core::fmt::detail::div10(static_cast<uint16_t>(x)), x / 10) << "x=" << x;
+    }
+}
+
+TEST(FmtTest, test_append_uint)
+{
+    char buffer[32] {};
+    core::fmt::writer out(buffer);
+
+    for (const uint32_t value : { 0U, 7U, 10U, 1023U, 65535U, 65536U, 99999U, 100000U, 1234567890U, 4294967295U }) {
+        out.clear();
+        out.append_uint(value);
+        EXPECT_TRUE(out.ok());
+        EXPECT_EQ(to_std_string(out.written()), std::to_string(value));
+    }
+}
+
+TEST(FmtTest, test_append_int)
+{
+    char buffer[32] {};
+    core::fmt::writer out(buffer);
+
+    for (const int32_t value : { 0, 1, -1, 42, -42, 32767, -32768, 70000, -70000,
+             std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min() }) {
+        out.clear();
+        out.append_int(value);
+        EXPECT_TRUE(out.ok());
+        EXPECT_EQ(to_std_string(out.written()), std::to_string(value));
+    }
+}
+
+TEST(FmtTest, test_append_fixed)
+{
+    char buffer[32] {};
+    core::fmt::writer out(buffer);
+
+    const struct {
+        int32_t value;
+        uint8_t decimals;
+        const char* expected;
+    } cases[] = {
+        { 2502, 3, "2.502" },
+        { 5000, 3, "5.000" },
+        { 5, 3, "0.005" },
+        { 0, 2, "0.00" },
+        { -25, 1, "-2.5" },
+        { -5, 3, "-0.005" },
+        { 1234, 0, "1234" },
+        { 123456789, 9, "0.123456789" },
+        { std::numeric_limits<int32_t>::min(), 9, "-2.147483648" },
+        // More than 9 decimals are clamped, the padding stays within the digit buffer
+        { -5, 14, "-0.000000005" },
+        { 1, 255, "0.000000001" },
+    };
+    for (const auto& c : cases) {
+        out.clear();
+        out.append_fixed(c.value, c.decimals);
+        EXPECT_TRUE(out.ok());
+        EXPECT_EQ(to_std_string(out.written()), c.expected);
+    }
+}
+
+TEST(FmtTest, test_chaining_and_literals)
+{
+    char buffer[16] {};
+    core::fmt::writer out(buffer);
+    out.append_uint(512).append(", ").append_uint(2502).append('\n');
+
+    EXPECT_TRUE(out.ok());
+    EXPECT_EQ(out.size(), 10u);
+    EXPECT_EQ(out.remaining(), 6u);
+    EXPECT_EQ(out.written().data(), buffer);
+    EXPECT_EQ(to_std_string(out.written()), "512, 2502\n");
+}
+
+TEST(FmtTest, test_overflow)
+{
+    char buffer[5] {};
+    core::fmt::writer out(buffer);
+    out.append_uint(1023).append(", ");
+
+    // The separator does not fit: nothing of it is written and later appends are ignored
+    EXPECT_FALSE(out.ok());
+    EXPECT_EQ(to_std_string(out.written()), "1023");
+    out.append('x');
+    EXPECT_EQ(out.size(), 4u);
+
+    out.clear();
+    EXPECT_TRUE(out.ok());
+    EXPECT_EQ(out.size(), 0u);
+}
+
+TEST(FmtTest, test_constexpr)
+{
+    constexpr auto formatted = [] {
+        char buffer[16] {};
+        core::fmt::writer out(buffer);
+        out.append_int(-1023).append(';').append_fixed(2502, 3);
+        return equals(out.written(), "-1023;2.502");
+    }();
+    static_assert(formatted);
+
+    SUCCEED();
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
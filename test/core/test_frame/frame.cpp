@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include <cobs.hpp>
+#include <crc.hpp>
+#include <frame.hpp>
+
+#include <cstdint>
+#include <vector>
+
+TEST(FrameTest, test_crc_check_value)
+{
+    // Standard CRC-16/CCITT-FALSE check value
+    constexpr uint8_t input[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    static_assert(core::crc::ccitt(input) == 0x29B1);
+    SUCCEED();
+}
+
+TEST(FrameTest, test_cobs_known_vectors)
+{
+    const std::vector<std::vector<uint8_t>> inputs = {
+        { 0x00 },
+        { 0x00, 0x00 },
+        { 0x11, 0x22, 0x00, 0x33 },
+        { 0x11, 0x22, 0x33, 0x44 },
+    };
+    const std::vector<std::vector<uint8_t>> expected = {
+        { 0x01, 0x01 },
+        { 0x01, 0x01, 0x01 },
+        { 0x03, 0x11, 0x22, 0x02, 0x33 },
+        { 0x05, 0x11, 0x22, 0x33, 0x44 },
+    };
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        uint8_t out[16] {};
+        const auto encoded = core::cobs::encode({ inputs[i].data(), inputs[i].size() }, out);
+        EXPECT_EQ(std::vector<uint8_t>(encoded.begin(), encoded.end()), expected[i]);
+    }
+}
+
+TEST(FrameTest, test_cobs_roundtrip_long_runs)
+{
+    for (const size_t size : { 0u, 1u, 253u, 254u, 255u, 508u, 600u }) {
+        std::vector<uint8_t> input(size);
+        for (size_t i = 0; i < size; ++i) {
+            input[i] = static_cast<uint8_t>(i % 300 == 299 ? 0 : (i % 255) + 1);
+        }
+
+        std::vector<uint8_t> encoded(core::cobs::max_encoded_size(size));
+        const auto stuffed = core::cobs::encode({ input.data(), input.size() }, { encoded.data(), encoded.size() });
+        ASSERT_FALSE(stuffed.empty());
+        for (const auto byte : stuffed) {
+            ASSERT_NE(byte, core::cobs::delimiter);
+        }
+
+        // Decode in place
+        const auto decoded = core::cobs::decode({ stuffed.data(), stuffed.size() }, stuffed);
+        EXPECT_EQ(std::vector<uint8_t>(decoded.begin(), decoded.end()), input) << "size=" << size;
+    }
+}
+
+TEST(FrameTest, test_cobs_overflow)
+{
+    const uint8_t input[] = { 1, 2, 3, 4 };
+    uint8_t out[4] {};
+    EXPECT_TRUE(core::cobs::encode(input, out).empty());
+}
+
+TEST(FrameTest, test_frame_roundtrip)
+{
+    const uint16_t samples[] = { 0, 1, 255, 256, 512, 1023, 0xABCD };
+    uint8_t wire[core::frame::max_frame_size(7)] {};
+    const auto frame = core::frame::encode(42, 3, samples, wire);
+    ASSERT_FALSE(frame.empty());
+    EXPECT_EQ(frame.back(), core::cobs::delimiter);
+
+    core::frame::decoder<16> decoder {};
+    for (size_t i = 0; i + 1 < frame.size(); ++i) {
+        EXPECT_EQ(decoder.feed(frame[i]), core::frame::status::pending);
+    }
+    ASSERT_EQ(decoder.feed(frame.back()), core::frame::status::packet);
+
+    const auto& packet = decoder.last();
+    EXPECT_EQ(packet.sequence, 42);
+    EXPECT_EQ(packet.channel, 3);
+    ASSERT_EQ(packet.samples.size(), 7u);
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_EQ(packet.samples[i], samples[i]);
+    }
+    EXPECT_EQ(decoder.stats().frames, 1u);
+    EXPECT_EQ(decoder.stats().samples, 7u);
+}
+
+TEST(FrameTest, test_stream_drop_and_error_detection)
+{
+    std::vector<uint8_t> stream;
+    const auto append_frame = [&stream](uint8_t sequence, uint16_t value) {
+        const uint16_t samples[] = { value, value };
+        uint8_t wire[core::frame::max_frame_size(2)] {};
+        const auto frame = core::frame::encode(sequence, 0, samples, wire);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    };
+
+    // Join mid-frame, then 254, 255, 0 (wraps), gap of 2, corrupted frame, back-to-back delimiters
+    stream.insert(stream.end(), { 0x12, 0x34 });
+    stream.push_back(core::cobs::delimiter);
+    append_frame(254, 10);
+    append_frame(255, 11);
+    append_frame(0, 12);
+    append_frame(3, 13);
+    const size_t corrupted = stream.size() + 2;
+    append_frame(4, 14);
+    stream[corrupted] ^= 0x40;
+    stream.push_back(core::cobs::delimiter);
+    append_frame(5, 15);
+
+    core::frame::decoder<> decoder {};
+    std::vector<uint16_t> received;
+    decoder.feed({ stream.data(), stream.size() }, [&received](const core::frame::packet& packet) {
+        received.push_back(packet.samples[0]);
+    });
+
+    EXPECT_EQ(received, (std::vector<uint16_t> { 10, 11, 12, 13, 15 }));
+    const auto& stats = decoder.stats();
+    EXPECT_EQ(stats.frames, 5u);
+    EXPECT_EQ(stats.samples, 10u);
+    EXPECT_EQ(stats.dropped_frames, 3u); // 1, 2 and the corrupted 4
+    EXPECT_EQ(stats.crc_errors + stats.framing_errors, 2u);
+}
+
+TEST(FrameTest, test_oversized_frame_rejected)
+{
+    uint16_t samples[32] {};
+    uint8_t wire[core::frame::max_frame_size(32)] {};
+    const auto frame = core::frame::encode(0, 0, samples, wire);
+
+    core::frame::decoder<8> decoder {};
+    core::frame::status last = core::frame::status::pending;
+    for (const auto byte : frame) {
+        last = decoder.feed(byte);
+    }
+    EXPECT_EQ(last, core::frame::status::error);
+    EXPECT_EQ(decoder.stats().framing_errors, 1u);
+}
+
+TEST(FrameTest, test_frame_encodings_roundtrip)
+{
+    // Slowly rising 10-bit signal with a full-scale step
+    uint16_t samples[37] {};
+    for (size_t i = 0; i < 37; ++i) {
+        samples[i] = static_cast<uint16_t>(i < 30 ? 500 + i * 3 : 1023 - i);
+    }
+
+    for (const auto format : { core::frame::encoding::raw16, core::frame::encoding::packed10,
+             core::frame::encoding::delta }) {
+        uint8_t wire[core::frame::max_frame_size(37, core::frame::encoding::delta)] {};
+        const auto frame = core::frame::encode(7, 15, samples, wire, format);
+        ASSERT_FALSE(frame.empty());
+        EXPECT_LE(frame.size(), core::frame::max_frame_size(37, format));
+
+        core::frame::decoder<> decoder {};
+        std::vector<uint16_t> received;
+        decoder.feed({ frame.data(), frame.size() }, [&](const core::frame::packet& packet) {
+            EXPECT_EQ(packet.sequence, 7);
+            EXPECT_EQ(packet.channel, 15);
+            EXPECT_EQ(packet.format, format);
+            received.assign(packet.samples.begin(), packet.samples.end());
+        });
+        EXPECT_EQ(received, std::vector<uint16_t>(std::begin(samples), std::end(samples)))
+            << "format=" << static_cast<int>(format);
+    }
+
+    static_assert(core::frame::max_payload_size(37, core::frame::encoding::packed10) == 47);
+    static_assert(core::frame::max_payload_size(37, core::frame::encoding::raw16) == 74);
+}
+
+TEST(FrameTest, test_frame_encoding_sizes)
+{
+    // Smooth signal: delta takes about one byte per sample, packed10 1.25, raw16 2
+    uint16_t samples[64] {};
+    for (size_t i = 0; i < 64; ++i) {
+        samples[i] = static_cast<uint16_t>(512 + (i % 16) * 2);
+    }
+
+    uint8_t raw16[core::frame::max_frame_size(64)] {};
+    uint8_t packed10[core::frame::max_frame_size(64)] {};
+    uint8_t delta[core::frame::max_frame_size(64, core::frame::encoding::delta)] {};
+    const auto raw16_size = core::frame::encode(0, 0, samples, raw16).size();
+    const auto packed10_size = core::frame::encode(0, 0, samples, packed10, core::frame::encoding::packed10).size();
+    const auto delta_size = core::frame::encode(0, 0, samples, delta, core::frame::encoding::delta).size();
+
+    EXPECT_GE(raw16_size, core::frame::packet_size(64) + 1);
+    EXPECT_LE(packed10_size, core::frame::max_frame_size(64, core::frame::encoding::packed10));
+    EXPECT_LT(packed10_size, raw16_size);
+    EXPECT_LT(delta_size, packed10_size);
+}
+
+TEST(FrameTest, test_frame_bad_payload_rejected)
+{
+    const uint16_t samples[] = { 1, 2, 3, 4 };
+    uint8_t wire[32] {};
+    core::frame::decoder<> decoder {};
+
+    // Unknown encoding
+    auto frame = core::frame::encode(0, 0, samples, wire, static_cast<core::frame::encoding>(5));
+    ASSERT_FALSE(frame.empty());
+    for (const auto byte : frame) {
+        decoder.feed(byte);
+    }
+    EXPECT_EQ(decoder.stats().framing_errors, 1u);
+
+    // Delta payload whose varints end mid-sample: 4 samples announced, last byte has the continuation bit
+    uint8_t packet[] = { 0, static_cast<uint8_t>(2 << 4), 4, 0x01, 0x01, 0x01, 0x81, 0, 0 };
+    const auto crc = core::crc::ccitt({ packet, sizeof(packet) - 2 });
+    packet[sizeof(packet) - 2] = static_cast<uint8_t>(crc);
+    packet[sizeof(packet) - 1] = static_cast<uint8_t>(crc >> 8);
+    frame = core::cobs::encode(packet, wire);
+    for (const auto byte : frame) {
+        decoder.feed(byte);
+    }
+    EXPECT_EQ(decoder.feed(core::cobs::delimiter), core::frame::status::error);
+    EXPECT_EQ(decoder.stats().framing_errors, 2u);
+    EXPECT_EQ(decoder.stats().frames, 0u);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <lut.hpp>
+#include <progmem.hpp>
+#include <utils/thermistor.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+constexpr uint16_t gains[] CORE_PROGMEM = { 1, 2, 4, 8, 16 };
+
+using ramp_grid = core::lut::grid<10, 5>;
+constexpr auto ramp CORE_PROGMEM = ramp_grid::generate<uint16_t>([](double x) { return x * 4; });
+
+using sensor = core::thermistor::divider<10000, 10000, 3950>;
+constexpr auto sensor_table CORE_PROGMEM = sensor::make_table();
+
+/// Largest deviation in hundredths of a degree from the beta equation over [margin, 1023 - margin]
+template <class Sensor, class Table>
+int worst_error(const Table& table, uint16_t margin)
+{
+    int worst = 0;
+    for (uint16_t raw = margin; raw <= 1023 - margin; ++raw) {
+        const auto exact = static_cast<int>(std::lround(Sensor::celsius(raw) * 100));
+        const int error = std::abs(Sensor::centi_celsius(table, raw) - exact);
+        worst = error > worst ? error : worst;
+    }
+    return worst;
+}
+
+} // namespace
+
+TEST(LutTest, test_progmem_span_reads_and_views)
+{
+    const core::progmem_span table(gains);
+    static_assert(core::is_same_v<decltype(table), const core::progmem_span<uint16_t>>);
+    ASSERT_EQ(table.size(), 5u);
+    EXPECT_EQ(table.size_bytes(), 10u);
+    EXPECT_EQ(table[2], 4u);
+    EXPECT_EQ(table.front(), 1u);
+    EXPECT_EQ(table.back(), 16u);
+
+    std::vector<uint16_t> values;
+    for (const auto value : table.subspan(1, 3)) {
+        values.push_back(value);
+    }
+    EXPECT_EQ(values, (std::vector<uint16_t> { 2, 4, 8 }));
+    EXPECT_EQ(table.first(2).back(), 2u);
+    EXPECT_EQ(table.last(2).front(), 8u);
+    EXPECT_EQ(table.subspan(3).size(), 2u);
+    EXPECT_TRUE(core::progmem_span<uint16_t>().empty());
+
+    // Generated tables are viewed through data() and size()
+    const core::progmem_span curve(ramp);
+    EXPECT_EQ(curve.size(), ramp_grid::points);
+    EXPECT_EQ(curve.data(), ramp.data());
+}
+
+TEST(LutTest, test_ln_matches_cmath)
+{
+    for (const double x : { 1e-6, 0.1, 0.5, 0.75, 1.0, 1.4999, 2.0, 3.0, 10.0, 12345.0, 1e9 }) {
+        EXPECT_NEAR(core::lut::ln(x), std::log(x), 1e-12 * (1 + std::abs(std::log(x)))) << "x=" << x;
+    }
+    static_assert(core::lut::ln(1.0) == 0.0);
+}
+
+TEST(LutTest, test_grid_interpolation)
+{
+    static_assert(ramp_grid::points == 33 && ramp_grid::shift == 5);
+    static_assert(ramp_grid::x(32) == 1024);
+    static_assert(ramp_grid::interpolate(ramp, 100) == 400);
+
+    // A straight line interpolates exactly, in flash and in constant expressions alike
+    const core::progmem_span table(ramp);
+    for (uint16_t code = 0; code <= 1023; ++code) {
+        ASSERT_EQ(ramp_grid::interpolate(table, code), code * 4) << "code=" << code;
+    }
+    // Past the last point the last entry is held
+    EXPECT_EQ(ramp_grid::interpolate(table, 1024), 4096u);
+    EXPECT_EQ(ramp_grid::interpolate(table, 65535), 4096u);
+
+    // Falling curves round like rising ones, results saturate to the value type
+    using coarse = core::lut::grid<4, 1>;
+    constexpr auto falling = coarse::generate<int16_t>([](double x) { return -3 * x; });
+    EXPECT_EQ(falling[1], -24);
+    EXPECT_EQ(coarse::interpolate(falling, 3), -9);
+    EXPECT_EQ(coarse::interpolate(falling, 15), -45);
+    constexpr auto clipped = coarse::generate<uint8_t>([](double x) { return 40 * x - 100; });
+    EXPECT_EQ(clipped[0], 0u);
+    EXPECT_EQ(clipped[2], 255u);
+}
+
+TEST(LutTest, test_thermistor_table_tracks_beta_equation)
+{
+    static_assert(sensor::table_type::size() == 33);
+    // 25 degrees at mid-scale, where the thermistor equals the series resistor
+    EXPECT_NEAR(sensor::celsius(511.5), 25.0, 1e-9);
+
+    // Within 0.4 degree from -18 to 86 degrees with 33 points, a finer table brings it down fourfold
+    const core::progmem_span table(sensor_table);
+    EXPECT_LE(worst_error<sensor>(table, 96), 40);
+    using fine = core::thermistor::divider<10000, 10000, 3950, 6>;
+    constexpr auto fine_table = fine::make_table();
+    EXPECT_LE(worst_error<fine>(fine_table, 96), 12);
+    EXPECT_GT(sensor::centi_celsius(table, 100), sensor::centi_celsius(table, 900));
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
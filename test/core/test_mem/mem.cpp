@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <utils/mem_usage.hpp>
+
+#include <cstdint>
+#include <string>
+
+TEST(MemTest, test_paint_untouched)
+{
+    uint8_t ram[64] {};
+    core::mem::paint(ram);
+    EXPECT_EQ(core::mem::untouched({ ram, sizeof(ram) }), 64u);
+
+    // A stack that reached down to ram[40] and a byte that happens to match below its current top
+    for (size_t i = 40; i < 64; ++i) {
+        ram[i] = static_cast<uint8_t>(i);
+    }
+    ram[50] = core::mem::paint_pattern;
+    EXPECT_EQ(core::mem::untouched({ ram, sizeof(ram) }), 40u);
+
+    core::mem::paint({ ram, 8 }, 0xAA);
+    EXPECT_EQ(core::mem::untouched({ ram, sizeof(ram) }), 0u);
+    EXPECT_EQ(core::mem::untouched({ ram, sizeof(ram) }, 0xAA), 8u);
+    EXPECT_EQ(core::mem::untouched({ ram, 0 }), 0u);
+}
+
+TEST(MemTest, test_summarize)
+{
+    // ATmega328P: SRAM 0x100-0x8FF, 412 static bytes, 60 bytes of heap, SP 0x8D0
+    constexpr core::mem::ram_layout layout { 0x100, 0x100 + 412, 0x100 + 472, 0x8D0, 0x8FF };
+    constexpr auto current = core::mem::summarize(layout, 1200);
+    static_assert(current.static_bytes == 412);
+    static_assert(current.heap_bytes == 60);
+    static_assert(current.stack_bytes == 0x8FF - 0x8D0);
+    static_assert(current.free_bytes == 0x8D0 + 1 - (0x100 + 472));
+    static_assert(current.free_min == 1200);
+    static_assert(current.stack_peak == 2048 - 472 - 1200);
+    // The regions partition the SRAM
+    static_assert(current.static_bytes + current.heap_bytes + current.free_bytes + current.stack_bytes == 2048);
+    SUCCEED();
+}
+
+TEST(MemTest, test_summarize_limits)
+{
+    // Unpainted RAM: the peak is the current stack
+    constexpr core::mem::ram_layout layout { 0x100, 0x300, 0x300, 0x800, 0x8FF };
+    constexpr auto unpainted = core::mem::summarize(layout, 0x1000);
+    static_assert(unpainted.free_min == unpainted.free_bytes);
+    static_assert(unpainted.stack_peak == unpainted.stack_bytes);
+
+    // Heap and stack collided
+    constexpr core::mem::ram_layout collided { 0x100, 0x300, 0x810, 0x800, 0x8FF };
+    constexpr auto overflow = core::mem::summarize(collided, 0);
+    static_assert(overflow.free_bytes == 0);
+    static_assert(overflow.free_min == 0);
+    SUCCEED();
+}
+
+TEST(MemTest, test_format)
+{
+    char buffer[64];
+    core::fmt::writer out(buffer);
+    core::mem::format(out, { 412, 0, 38, 187, 1598, 1449 });
+    EXPECT_EQ(std::string(out.written().data(), out.size()), "ram,412,0,38,187,1598,1449\r\n");
+    EXPECT_EQ(std::string(core::mem::report_header), "ram,static,heap,stack,stack_peak,free,free_min\r\n");
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
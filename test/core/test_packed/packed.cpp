@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <delta.hpp>
+#include <packed.hpp>
+
+#include <cstdint>
+#include <vector>
+
+TEST(PackedTest, test_sizes)
+{
+    static_assert(core::packed_size(10, 4) == 5);
+    static_assert(core::packed_size(10, 5) == 7);
+    static_assert(core::packed_size(12, 2) == 3);
+    static_assert(sizeof(core::packed_array<10, 64>) == 80);
+    static_assert(core::packed_array<10, 64>::byte_size == 80);
+    SUCCEED();
+}
+
+TEST(PackedTest, test_layout)
+{
+    // LSB-first bit stream: 0x3FF, 0x000, 0x155, 0x2AA
+    core::packed_array<10, 4> array {};
+    array.set(0, 0x3FF);
+    array.set(1, 0x000);
+    array.set(2, 0x155);
+    array.set(3, 0x2AA);
+
+    const auto bytes = array.bytes();
+    const std::vector<uint8_t> expected = { 0xFF, 0x03, 0x50, 0x95, 0xAA };
+    EXPECT_EQ(std::vector<uint8_t>(bytes.begin(), bytes.end()), expected);
+    EXPECT_EQ(array[0], 0x3FFu);
+    EXPECT_EQ(array[1], 0x000u);
+    EXPECT_EQ(array[2], 0x155u);
+    EXPECT_EQ(array[3], 0x2AAu);
+}
+
+template <uint8_t Bits>
+void check_roundtrip()
+{
+    constexpr size_t count = 67;
+    core::packed_array<Bits, count> array {};
+    const auto mask = core::packed_span<Bits>::mask;
+
+    // Fill with all ones first so set() must clear neighbouring bits correctly
+    for (size_t i = 0; i < count; ++i) {
+        array.set(i, 0xFFFF);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        array.set(i, static_cast<uint16_t>(i * 2654435761U >> 7));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(array.get(i), static_cast<uint16_t>(i * 2654435761U >> 7) & mask) << "bits=" << int { Bits } << " i=" << i;
+    }
+}
+
+TEST(PackedTest, test_roundtrip_widths)
+{
+    check_roundtrip<1>();
+    check_roundtrip<3>();
+    check_roundtrip<8>();
+    check_roundtrip<9>();
+    check_roundtrip<10>();
+    check_roundtrip<11>();
+    check_roundtrip<12>();
+    check_roundtrip<13>();
+    check_roundtrip<15>();
+    check_roundtrip<16>();
+}
+
+TEST(PackedTest, test_span_pack_unpack)
+{
+    const uint16_t samples[] = { 0, 1, 511, 512, 1023, 1000, 3 };
+    uint8_t storage[core::packed_size(10, 7)] {};
+    const core::packed_span<10> view(storage, 7);
+
+    EXPECT_EQ(core::pack(core::span<const uint16_t>(samples), view), 7u);
+    EXPECT_EQ(view.size(), 7u);
+    EXPECT_EQ(view.bytes().size(), 9u);
+
+    uint16_t unpacked[8] {};
+    EXPECT_EQ(core::unpack(view, core::span<uint16_t>(unpacked)), 7u);
+    for (size_t i = 0; i < 7; ++i) {
+        EXPECT_EQ(unpacked[i], samples[i]);
+    }
+
+    // Packing a prefix leaves the following samples intact
+    const uint16_t head[] = { 7, 8, 9 };
+    EXPECT_EQ(core::pack(core::span<const uint16_t>(head), view.first(3)), 3u);
+    EXPECT_EQ(view[2], 9u);
+    EXPECT_EQ(view[3], 512u);
+    EXPECT_EQ(view[6], 3u);
+
+    // Read-only view over received bytes
+    const core::packed_span<10, const uint8_t> received(core::span<const uint8_t>(storage), 7);
+    EXPECT_EQ(received.first(5).size(), 5u);
+    EXPECT_EQ(received[4], 1023u);
+}
+
+TEST(DeltaTest, test_zigzag)
+{
+    static_assert(core::delta::zigzag(0) == 0);
+    static_assert(core::delta::zigzag(-1) == 1);
+    static_assert(core::delta::zigzag(1) == 2);
+    static_assert(core::delta::zigzag(-2) == 3);
+    static_assert(core::delta::zigzag(INT16_MAX) == 0xFFFE);
+    static_assert(core::delta::zigzag(INT16_MIN) == 0xFFFF);
+
+    for (int32_t value = INT16_MIN; value <= INT16_MAX; ++value) {
+        ASSERT_EQ(core::delta::unzigzag(core::delta::zigzag(static_cast<int16_t>(value))), value);
+    }
+}
+
+TEST(DeltaTest, test_known_stream)
+{
+    // Steps +100, -1, +64, -64 -> zigzag 200, 1, 128, 127
+    const uint16_t samples[] = { 100, 99, 163, 99 };
+    uint8_t out[core::delta::max_encoded_size(4)] {};
+    const auto encoded = core::delta::encode(samples, out);
+
+    const std::vector<uint8_t> expected = { 0xC8, 0x01, 0x01, 0x80, 0x01, 0x7F };
+    EXPECT_EQ(std::vector<uint8_t>(encoded.begin(), encoded.end()), expected);
+}
+
+TEST(DeltaTest, test_roundtrip)
+{
+    std::vector<uint16_t> samples;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        samples.push_back(static_cast<uint16_t>(i * 40503U)); // full 16-bit range jumps
+    }
+    samples.insert(samples.end(), { 0, 0xFFFF, 0, 0x8000, 0x7FFF });
+
+    std::vector<uint8_t> encoded(core::delta::max_encoded_size(samples.size()));
+    const auto bytes = core::delta::encode({ samples.data(), samples.size() }, { encoded.data(), encoded.size() }, 512);
+    ASSERT_FALSE(bytes.empty());
+
+    std::vector<uint16_t> decoded(samples.size());
+    const auto values = core::delta::decode({ bytes.data(), bytes.size() }, { decoded.data(), decoded.size() }, 512);
+    EXPECT_EQ(std::vector<uint16_t>(values.begin(), values.end()), samples);
+}
+
+TEST(DeltaTest, test_slow_signal_compresses)
+{
+    // 10-bit triangle with steps of 3 LSB: one byte per sample
+    uint16_t samples[256] {};
+    for (size_t i = 0; i < 256; ++i) {
+        samples[i] = static_cast<uint16_t>(500 + 3 * (i % 64 < 32 ? i % 64 : 64 - i % 64));
+    }
+    uint8_t out[core::delta::max_encoded_size(256)] {};
+    EXPECT_EQ(core::delta::encode(samples, out, 500).size(), 256u);
+}
+
+TEST(DeltaTest, test_errors)
+{
+    uint16_t out[4] {};
+
+    // Output too small
+    uint8_t stream[] = { 0x02, 0x02, 0x02 };
+    EXPECT_TRUE(core::delta::decode(stream, core::span<uint16_t>(out, 2)).empty());
+    EXPECT_EQ(core::delta::decode(stream, out).size(), 3u);
+
+    // Truncated varint
+    const uint8_t truncated[] = { 0x02, 0x80 };
+    EXPECT_TRUE(core::delta::decode(truncated, out).empty());
+
+    // Varint longer than 16 bits
+    const uint8_t overlong[] = { 0xFF, 0xFF, 0x04 };
+    EXPECT_TRUE(core::delta::decode(overlong, out).empty());
+
+    // Encoder output too small
+    const uint16_t samples[] = { 1000, 0 };
+    uint8_t small[3] {};
+    EXPECT_TRUE(core::delta::encode(samples, small).empty());
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
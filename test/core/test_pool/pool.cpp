@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <pool.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+TEST(PoolTest, test_parameters)
+{
+    static_assert(core::pool<uint32_t, 8>::block_size == 1);
+    static_assert(core::pool<uint16_t[32], 4>::block_size == 32);
+    static_assert(std::is_same_v<core::pool<uint16_t[32], 4>::element_type, uint16_t>);
+    static_assert(std::is_same_v<core::pool<uint8_t, 253>::index_type, uint8_t>);
+    static_assert(std::is_same_v<core::pool<uint8_t, 254>::index_type, uint16_t>);
+    // Storage plus one index byte per block and three bookkeeping bytes, before padding
+    static_assert(sizeof(core::pool<uint16_t[32], 4>) <= 4 * 64 + 4 + 3 + alignof(uint16_t));
+    SUCCEED();
+}
+
+TEST(PoolTest, test_allocate_until_exhausted)
+{
+    core::pool<uint16_t[8], 4> pool {};
+    std::vector<core::span<uint16_t>> blocks;
+    for (int i = 0; i < 4; ++i) {
+        auto block = pool.allocate();
+        ASSERT_EQ(block.size(), 8u);
+        for (auto& sample : block) {
+            sample = static_cast<uint16_t>(i);
+        }
+        blocks.push_back(block);
+    }
+    EXPECT_TRUE(pool.allocate().empty());
+    EXPECT_EQ(pool.available(), 0u);
+    EXPECT_EQ(pool.in_use_count(), 4u);
+    EXPECT_EQ(pool.low_water(), 0u);
+
+    // Blocks do not overlap
+    for (int i = 0; i < 4; ++i) {
+        for (const auto sample : blocks[i]) {
+            EXPECT_EQ(sample, i);
+        }
+    }
+}
+
+TEST(PoolTest, test_free_and_reuse)
+{
+    core::pool<uint32_t, 3> pool {};
+    auto a = pool.allocate();
+    auto b = pool.allocate();
+    auto c = pool.allocate();
+    ASSERT_FALSE(c.empty());
+
+    // LIFO reuse: the last freed block comes back first
+    EXPECT_TRUE(pool.free(b));
+    EXPECT_TRUE(pool.free(a));
+    EXPECT_EQ(pool.allocate().data(), a.data());
+    EXPECT_EQ(pool.allocate().data(), b.data());
+    EXPECT_EQ(pool.available(), 0u);
+
+    pool.reset();
+    EXPECT_EQ(pool.available(), 3u);
+}
+
+TEST(PoolTest, test_free_rejects_foreign_and_double_free)
+{
+    core::pool<uint16_t[4], 2> pool {};
+    auto block = pool.allocate();
+    ASSERT_FALSE(block.empty());
+
+    uint16_t foreign[4] {};
+    EXPECT_FALSE(pool.free(foreign));
+    EXPECT_FALSE(pool.free(block.subspan(1))); // not the start of a block
+
+    EXPECT_TRUE(pool.free(block));
+    EXPECT_FALSE(pool.free(block)); // already free
+    EXPECT_EQ(pool.available(), 2u);
+}
+
+TEST(PoolTest, test_constexpr)
+{
+    constexpr auto available = [] {
+        core::pool<uint8_t, 4> pool {};
+        auto first = pool.allocate();
+        pool.allocate();
+        first[0] = 7;
+        pool.free(first);
+        return pool.available() * 10 + pool.allocate()[0];
+    }();
+    static_assert(available == 37);
+    SUCCEED();
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <ring_buffer.hpp>
+
+#include <cstdint>
+#include <thread>
+
+TEST(RingBufferTest, test_empty_state)
+{
+    core::ring_buffer<int, 8> buffer {};
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_FALSE(buffer.full());
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_EQ(buffer.free(), 8u);
+    static_assert(core::ring_buffer<int, 8>::capacity() == 8u);
+
+    int value = -1;
+    EXPECT_FALSE(buffer.pop(value));
+    EXPECT_EQ(value, -1);
+    EXPECT_TRUE(buffer.read_reserve().empty());
+}
+
+TEST(RingBufferTest, test_push_pop_fifo_order)
+{
+    core::ring_buffer<int, 4> buffer {};
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+    }
+    EXPECT_TRUE(buffer.full());
+    EXPECT_FALSE(buffer.push(99));
+
+    for (int i = 0; i < 4; ++i) {
+        int value = -1;
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, test_index_wraparound)
+{
+    // 1000 elements overflow the 8-bit free-running indices several times
+    core::ring_buffer<uint16_t, 4> buffer {};
+
+    for (uint16_t i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(buffer.push(i));
+        EXPECT_TRUE(buffer.push(static_cast<uint16_t>(i + 1000)));
+        EXPECT_EQ(buffer.size(), 2u);
+
+        uint16_t value = 0;
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, i);
+        EXPECT_TRUE(buffer.pop(value));
+        EXPECT_EQ(value, i + 1000);
+    }
+}
+
+TEST(RingBufferTest, test_max_capacity)
+{
+    core::ring_buffer<uint8_t, 128> buffer {};
+
+    for (int i = 0; i < 128; ++i) {
+        EXPECT_TRUE(buffer.push(static_cast<uint8_t>(i)));
+    }
+    EXPECT_TRUE(buffer.full());
+    EXPECT_EQ(buffer.size(), 128u);
+    EXPECT_EQ(buffer.free(), 0u);
+    EXPECT_TRUE(buffer.write_reserve().empty());
+}
+
+TEST(RingBufferTest, test_span_reservations)
+{
+    core::ring_buffer<int, 8> buffer {};
+
+    // Fill 6 slots in place
+    auto region = buffer.write_reserve();
+    ASSERT_EQ(region.size(), 8u);
+    for (size_t i = 0; i < 6; ++i) {
+        region[i] = static_cast<int>(i);
+    }
+    buffer.write_commit(6);
+    EXPECT_EQ(buffer.size(), 6u);
+
+    // Consume 5 in place
+    auto readable = buffer.read_reserve();
+    ASSERT_EQ(readable.size(), 6u);
+    EXPECT_EQ(readable[0], 0);
+    buffer.read_commit(5);
+    EXPECT_EQ(buffer.size(), 1u);
+
+    // Write position is at offset 6: contiguous region stops at the end of the storage
+    region = buffer.write_reserve();
+    EXPECT_EQ(region.size(), 2u);
+    region[0] = 6;
+    region[1] = 7;
+    buffer.write_commit(2);
+
+    // Wrapped region
+    region = buffer.write_reserve();
+    EXPECT_EQ(region.size(), 5u);
+    region[0] = 8;
+    buffer.write_commit(1);
+
+    // Readable region also stops at the end of the storage
+    readable = buffer.read_reserve();
+    ASSERT_EQ(readable.size(), 3u);
+    EXPECT_EQ(readable[0], 5);
+    EXPECT_EQ(readable[2], 7);
+    buffer.read_commit(3);
+
+    readable = buffer.read_reserve();
+    ASSERT_EQ(readable.size(), 1u);
+    EXPECT_EQ(readable[0], 8);
+    buffer.read_commit(1);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, test_clear)
+{
+    core::ring_buffer<int, 4> buffer {};
+    buffer.push(1);
+    buffer.push(2);
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.free(), 4u);
+}
+
+TEST(RingBufferTest, test_erase)
+{
+    core::ring_buffer<int, 4> buffer {};
+    for (int i = 0; i < 3; ++i) {
+        buffer.push(i);
+    }
+    buffer.erase(0, 2);
+    buffer.push(3);
+    buffer.push(4);
+
+    // Remove 3 behind 2, across the wrap point: 2 is moved forward
+    buffer.erase(1, 1);
+    EXPECT_EQ(buffer.size(), 2u);
+    int value = -1;
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, 4);
+    EXPECT_TRUE(buffer.empty());
+}
+
+// A host thread plays the ISR producer while the main thread drains in batches
+TEST(RingBufferTest, test_spsc_stress)
+{
+    constexpr uint32_t count = 200'000;
+    core::ring_buffer<uint32_t, 64> buffer {};
+
+    std::thread producer([&buffer] {
+        uint32_t next = 0;
+        while (next < count) {
+            if ((next & 1) == 0) {
+                if (buffer.push(next)) {
+                    ++next;
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            auto region = buffer.write_reserve();
+            uint8_t written = 0;
+            while (written < region.size() && next < count) {
+                region[written++] = next++;
+            }
+            buffer.write_commit(written);
+            if (written == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool in_order = true;
+    while (expected < count) {
+        auto readable = buffer.read_reserve();
+        if (readable.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (const auto value : readable) {
+            in_order &= (value == expected++);
+        }
+        buffer.read_commit(static_cast<uint8_t>(readable.size()));
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(expected, count);
+    EXPECT_TRUE(buffer.empty());
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <utils/scheduler.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Simulated time: tasks advance it by their cost, stamps are ticks * 100 + fraction
+struct fake_clock {
+    static inline uint16_t now_ticks {};
+    static inline uint16_t fraction {};
+
+    static core::sched::tick ticks() { return now_ticks; }
+    static uint16_t stamp() { return static_cast<uint16_t>(now_ticks * 100 + fraction); }
+
+    static void advance(uint16_t stamps)
+    {
+        const unsigned total = fraction + stamps;
+        now_ticks = static_cast<uint16_t>(now_ticks + total / 100);
+        fraction = static_cast<uint16_t>(total % 100);
+    }
+};
+
+std::vector<char> order;
+uint16_t cost_a = 10;
+uint16_t cost_b = 10;
+
+void task_a()
+{
+    order.push_back('a');
+    fake_clock::advance(cost_a);
+}
+
+void task_b()
+{
+    order.push_back('b');
+    fake_clock::advance(cost_b);
+}
+
+/// @brief Dispatch until idle, then advance to the next tick, for ticks ticks
+template <class Scheduler>
+void run_for(Scheduler& scheduler, uint16_t ticks)
+{
+    const uint16_t end = static_cast<uint16_t>(fake_clock::now_ticks + ticks);
+    while (static_cast<int16_t>(fake_clock::now_ticks - end) < 0) {
+        if (!scheduler.dispatch()) {
+            fake_clock::now_ticks = static_cast<uint16_t>(fake_clock::now_ticks + 1);
+            fake_clock::fraction = 0;
+        }
+    }
+}
+
+void reset(uint16_t start_ticks = 0)
+{
+    fake_clock::now_ticks = start_ticks;
+    fake_clock::fraction = 0;
+    order.clear();
+    cost_a = 10;
+    cost_b = 10;
+}
+
+} // namespace
+
+TEST(SchedulerTest, test_periods_and_offsets)
+{
+    reset();
+    constexpr core::sched::task tasks[] = { { task_a, 2, 0, 0 }, { task_b, 5, 0, 1 } };
+    core::sched::scheduler<2, fake_clock> scheduler(tasks);
+    scheduler.start();
+
+    EXPECT_TRUE(scheduler.pending());
+    run_for(scheduler, 10);
+    // a at 0 2 4 6 8, b at 1 6
+    EXPECT_EQ(std::string(order.begin(), order.end()), "abaaaba");
+    EXPECT_TRUE(scheduler.pending()); // a at 10
+    EXPECT_EQ(scheduler.stats(0).runs, 5u);
+    EXPECT_EQ(scheduler.stats(1).runs, 2u);
+    EXPECT_EQ(scheduler.stats(0).misses, 0u);
+    EXPECT_EQ(scheduler.stats(0).wcet, 10u);
+    EXPECT_EQ(scheduler.stats(0).max_response, 0u);
+    EXPECT_EQ(scheduler.size(), 2u);
+}
+
+TEST(SchedulerTest, test_priority_and_deadline_miss)
+{
+    reset();
+    // b runs for 2 ticks: a, released while b runs, goes first as soon as b returns and misses its 1-tick deadline
+    constexpr core::sched::task tasks[] = { { task_a, 1, 1, 0 }, { task_b, 4, 0, 0 } };
+    core::sched::scheduler<2, fake_clock> scheduler(tasks);
+    scheduler.start();
+    cost_b = 200;
+
+    run_for(scheduler, 4);
+    EXPECT_EQ(std::string(order.begin(), order.end()), "abaaa");
+    EXPECT_EQ(scheduler.stats(0).misses, 1u);
+    EXPECT_EQ(scheduler.stats(0).max_response, 1u);
+    EXPECT_EQ(scheduler.stats(1).misses, 0u);
+    EXPECT_EQ(scheduler.stats(1).wcet, 200u);
+    EXPECT_EQ(scheduler.stats(1).max_response, 2u);
+    EXPECT_EQ(scheduler.stats(0).skips, 0u);
+}
+
+TEST(SchedulerTest, test_overload_skips_releases)
+{
+    reset();
+    constexpr core::sched::task tasks[] = { { task_a, 2, 0, 0 } };
+    core::sched::scheduler<1, fake_clock> scheduler(tasks);
+    scheduler.start();
+
+    // One 7.5-tick job: releases 2 and 4 are skipped, the next job runs at once for release 6
+    cost_a = 750;
+    EXPECT_TRUE(scheduler.dispatch());
+    EXPECT_EQ(scheduler.stats(0).skips, 2u);
+    EXPECT_EQ(scheduler.stats(0).misses, 1u);
+    EXPECT_EQ(scheduler.stats(0).max_response, 7u);
+
+    cost_a = 10;
+    EXPECT_TRUE(scheduler.dispatch());
+    EXPECT_EQ(scheduler.stats(0).misses, 1u); // release 6 completed at tick 7, in time
+    EXPECT_FALSE(scheduler.dispatch());
+    run_for(scheduler, 3); // back on period: release 8
+    EXPECT_EQ(scheduler.stats(0).runs, 3u);
+    EXPECT_EQ(scheduler.stats(0).misses, 1u);
+    EXPECT_EQ(scheduler.stats(0).skips, 2u);
+}
+
+TEST(SchedulerTest, test_tick_wraparound_and_format)
+{
+    reset(0xFFFD);
+    constexpr core::sched::task tasks[] = { { task_a, 3, 0, 0 } };
+    core::sched::scheduler<1, fake_clock> scheduler(tasks);
+    scheduler.start();
+
+    run_for(scheduler, 9);
+    EXPECT_EQ(scheduler.stats(0).runs, 3u);
+    EXPECT_EQ(scheduler.stats(0).misses, 0u);
+    EXPECT_EQ(fake_clock::now_ticks, 6u);
+
+    // start() clears the statistics
+    scheduler.start();
+    EXPECT_EQ(scheduler.stats(0).runs, 0u);
+    run_for(scheduler, 1);
+
+    char line[64];
+    core::fmt::writer out(line);
+    core::sched::format(out, 0, scheduler.stats(0), 4);
+    EXPECT_EQ(std::string(out.written().data(), out.size()), "task,0,1,0,0,40,0\r\n");
+    EXPECT_EQ(std::string(core::sched::report_header), "task,index,runs,misses,skips,wcet_us,max_response_ticks\r\n");
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
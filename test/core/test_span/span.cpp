@@ -2,7 +2,11 @@
 
 #include <span.hpp>
 
+#include <array>
 #include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 class SpanTest : public ::testing::Test {
 protected:
@@ -509,6 +513,242 @@ TEST_F(SpanTest, test_subspan)
     }
 }
 
+// Static extent
+TEST_F(SpanTest, test_static_extent)
+{
+    {
+        // Runtime tests
+        core::span<int, 5> span(m_array);
+
+        EXPECT_EQ(span.size(), 5u);
+        EXPECT_EQ(span.size_bytes(), 5 * sizeof(int));
+        EXPECT_FALSE(span.empty());
+        EXPECT_EQ(span.data(), m_array);
+        EXPECT_EQ(span.front(), 1);
+        EXPECT_EQ(span.back(), 5);
+        EXPECT_EQ(span.end() - span.begin(), 5);
+
+        int sum = 0;
+        for (const auto value : span) {
+            sum += value;
+        }
+        EXPECT_EQ(sum, 15);
+
+        span[0] = 10;
+        EXPECT_EQ(m_array[0], 10);
+    }
+    {
+        // Compile-time tests
+        constexpr core::span<const int, 3> span(m_const_array);
+
+        static_assert(sizeof(span) == sizeof(const int*), "static extent stores only the pointer");
+        static_assert(sizeof(core::span<const int>) == sizeof(const int*) + sizeof(core::size_t));
+        static_assert(decltype(span)::extent == 3u);
+        static_assert(core::span<const int>::extent == core::dynamic_extent);
+        static_assert(span.size() == 3u);
+        static_assert(span[1] == 20);
+        static_assert(span.back() == 30);
+    }
+}
+
+TEST_F(SpanTest, test_extent_conversions)
+{
+    {
+        // Runtime tests
+        core::span<int, 5> fixed(m_array);
+
+        // Static to dynamic is implicit
+        core::span<int> dynamic = fixed;
+        EXPECT_EQ(dynamic.size(), 5u);
+        EXPECT_EQ(dynamic.data(), m_array);
+
+        // Dynamic to static is explicit
+        core::span<int, 5> back(dynamic);
+        EXPECT_EQ(back.data(), m_array);
+
+        core::span<int, 2> from_pointer(m_array + 3, 2);
+        EXPECT_EQ(from_pointer[0], 4);
+        EXPECT_EQ(from_pointer[1], 5);
+    }
+    {
+        // Compile-time tests
+        constexpr core::span<const int, 3> fixed(m_const_array);
+        constexpr core::span<const int> dynamic = fixed;
+        static_assert(dynamic.size() == 3u);
+        static_assert(dynamic.data() == m_const_array);
+    }
+}
+
+TEST_F(SpanTest, test_static_subviews)
+{
+    {
+        // Runtime tests
+        core::span<int, 5> fixed(m_array);
+
+        auto head = fixed.first<2>();
+        static_assert(decltype(head)::extent == 2u);
+        EXPECT_EQ(head.data(), m_array);
+
+        auto tail = fixed.last<2>();
+        static_assert(decltype(tail)::extent == 2u);
+        EXPECT_EQ(tail.data(), m_array + 3);
+
+        auto rest = fixed.subspan<1>();
+        static_assert(decltype(rest)::extent == 4u);
+        EXPECT_EQ(rest.data(), m_array + 1);
+
+        auto middle = fixed.subspan<1, 3>();
+        static_assert(decltype(middle)::extent == 3u);
+        EXPECT_EQ(middle[2], m_array[3]);
+
+        // Runtime subviews of a static span are dynamic
+        auto dynamic = fixed.subspan(1u, 2u);
+        static_assert(decltype(dynamic)::extent == core::dynamic_extent);
+        EXPECT_EQ(dynamic.size(), 2u);
+
+        // Compile-time subviews of a dynamic span
+        core::span<int> view(m_array);
+        auto block = view.first<4>();
+        static_assert(decltype(block)::extent == 4u);
+        EXPECT_EQ(block.data(), m_array);
+        EXPECT_EQ(view.last<1>()[0], m_array[4]);
+        auto pair = view.subspan<3, 2>();
+        static_assert(decltype(pair)::extent == 2u);
+        EXPECT_EQ(pair.data(), m_array + 3);
+        auto remaining = view.subspan<3>();
+        static_assert(decltype(remaining)::extent == core::dynamic_extent);
+        EXPECT_EQ(remaining.size(), 2u);
+    }
+    {
+        // Compile-time tests
+        constexpr core::span<const int, 3> fixed(m_const_array);
+        static_assert(fixed.first<1>()[0] == 10);
+        static_assert(fixed.last<1>()[0] == 30);
+        static_assert(fixed.subspan<1, 1>()[0] == 20);
+        static_assert(fixed.subspan<1>().size() == 2u);
+    }
+}
+
+namespace {
+
+/// Class iterator opted in as contiguous
+struct wrapped_iterator {
+    int* pointer;
+    int* operator->() const { return pointer; }
+};
+
+/// Container with data() and size() only
+struct sample_block {
+    unsigned short values[4];
+    unsigned short* data() { return values; }
+    const unsigned short* data() const { return values; }
+    unsigned char size() const { return 4; }
+};
+
+} // namespace
+
+template <>
+struct core::is_contiguous_iterator<wrapped_iterator> : core::true_type { };
+
+TEST_F(SpanTest, test_iterator_constructors)
+{
+    {
+        // Runtime tests
+        int* first = m_array + 1;
+        core::span<int> counted(first, 3u);
+        EXPECT_EQ(counted.data(), m_array + 1);
+        EXPECT_EQ(counted.size(), 3u);
+
+        core::span<const int> range(m_array + 1, m_array + 4);
+        EXPECT_EQ(range.data(), m_array + 1);
+        EXPECT_EQ(range.size(), 3u);
+        EXPECT_EQ(range.back(), 4);
+
+        core::span<int> wrapped(wrapped_iterator { m_array }, wrapped_iterator { m_array + 5 });
+        EXPECT_EQ(wrapped.size(), 5u);
+        EXPECT_EQ(wrapped.data(), m_array);
+
+        core::span<const int, 2> fixed(wrapped_iterator { m_array + 3 }, 2);
+        EXPECT_EQ(fixed[1], 5);
+    }
+    {
+        // Compile-time tests
+        constexpr core::span<const int> range(m_const_array, m_const_array + 3);
+        static_assert(range.size() == 3u);
+        static_assert(range[2] == 30);
+
+        // An int count is a count, not an end iterator
+        static_assert(std::is_constructible_v<core::span<int>, int*, int>);
+        // Iterators must refer to elements viewable as T
+        static_assert(!std::is_constructible_v<core::span<int>, const int*, const int*>);
+        static_assert(!std::is_constructible_v<core::span<int>, unsigned*, core::size_t>);
+        static_assert(!std::is_constructible_v<core::span<int>, std::vector<int>::iterator, core::size_t>);
+    }
+}
+
+TEST_F(SpanTest, test_container_constructors)
+{
+    {
+        // Runtime tests
+        std::vector<int> vector { 1, 2, 3 };
+        core::span<int> from_vector = vector;
+        EXPECT_EQ(from_vector.data(), vector.data());
+        EXPECT_EQ(from_vector.size(), 3u);
+        from_vector[0] = 7;
+        EXPECT_EQ(vector[0], 7);
+
+        const std::array<int, 4> array { 4, 5, 6, 7 };
+        core::span<const int> from_array(array);
+        EXPECT_EQ(from_array.data(), array.data());
+        EXPECT_EQ(from_array.size(), 4u);
+
+        const std::string text = "core";
+        core::span<const char> from_string = text;
+        EXPECT_EQ(from_string.size(), 4u);
+        EXPECT_EQ(from_string.front(), 'c');
+
+        sample_block block {};
+        core::span<unsigned short> from_block = block;
+        EXPECT_EQ(from_block.data(), block.values);
+        EXPECT_EQ(from_block.size(), 4u);
+    }
+    {
+        // Compile-time tests
+        static_assert(std::is_constructible_v<core::span<const int>, const std::vector<int>&>);
+        static_assert(!std::is_constructible_v<core::span<int>, const std::vector<int>&>);
+        static_assert(!std::is_constructible_v<core::span<unsigned>, std::vector<int>&>);
+        static_assert(!std::is_constructible_v<core::span<int>, std::vector<long>&>);
+        static_assert(!std::is_constructible_v<core::span<int, 3>, std::array<int, 3>&>);
+    }
+}
+
+TEST_F(SpanTest, test_qualification_conversions)
+{
+    {
+        // Runtime tests
+        core::span<int> mutable_view(m_array);
+        core::span<const int> const_view = mutable_view;
+        EXPECT_EQ(const_view.data(), m_array);
+        EXPECT_EQ(const_view.size(), 5u);
+
+        core::span<int, 5> fixed(m_array);
+        core::span<const int, 5> const_fixed = fixed;
+        core::span<const int> const_dynamic = fixed;
+        core::span<const int, 5> back(mutable_view);
+        EXPECT_EQ(const_fixed.data(), m_array);
+        EXPECT_EQ(const_dynamic.size(), 5u);
+        EXPECT_EQ(back.data(), m_array);
+    }
+    {
+        // Compile-time tests
+        static_assert(std::is_convertible_v<core::span<int>, core::span<const int>>);
+        static_assert(!std::is_convertible_v<core::span<const int>, core::span<int>>);
+        static_assert(!std::is_convertible_v<core::span<int>, core::span<unsigned>>);
+        static_assert(!std::is_convertible_v<core::span<int, 3>, core::span<const int, 4>>);
+        static_assert(!std::is_convertible_v<core::span<int>, core::span<int, 3>>);
+    }
+}
+
 auto main(int argc, char** argv) -> int
 {
     ::testing::InitGoogleTest(&argc, argv);
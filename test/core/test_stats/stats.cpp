@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <stats.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/// Double precision reference of a summary, in the same fixed-point units
+struct reference {
+    double mean;
+    double rms;
+    double variance;
+};
+
+reference compute(const std::vector<uint16_t>& values)
+{
+    double sum = 0;
+    double squares = 0;
+    for (const auto value : values) {
+        sum += value;
+        squares += static_cast<double>(value) * value;
+    }
+    const double n = static_cast<double>(values.size());
+    const double mean = sum / n;
+    double spread = 0;
+    for (const auto value : values) {
+        spread += (value - mean) * (value - mean);
+    }
+    return { mean * 100, std::sqrt(squares / n) * 100, spread / n * 100 };
+}
+
+/// Deterministic pseudo-random codes in [offset, offset + spread)
+std::vector<uint16_t> noisy_codes(size_t count, uint16_t offset, uint16_t spread)
+{
+    std::vector<uint16_t> values(count);
+    uint32_t state = 12345;
+    for (auto& value : values) {
+        state = state * 1103515245u + 12345u;
+        value = static_cast<uint16_t>(offset + (state >> 16) % spread);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(StatsTest, test_sqrt_round)
+{
+    static_assert(core::stats::detail::sqrt_round(0) == 0);
+    static_assert(core::stats::detail::sqrt_round(2) == 1);
+    static_assert(core::stats::detail::sqrt_round(3) == 2);
+    static_assert(core::stats::detail::sqrt_round(1u << 20) == 1024);
+    for (uint64_t value : { 6ull, 12ull, 13ull, 1046529ull, 4294967295ull, 10465290000ull, 1ull << 62 }) {
+        EXPECT_EQ(core::stats::detail::sqrt_round(value), std::llround(std::sqrt(static_cast<double>(value))))
+            << "value=" << value;
+    }
+}
+
+TEST(StatsTest, test_accumulator_summary)
+{
+    core::stats::accumulator<> empty;
+    EXPECT_EQ(empty.result().count, 0u);
+    EXPECT_EQ(empty.result().variance, 0u);
+
+    constexpr auto constant = [] {
+        core::stats::accumulator<> acc;
+        for (int i = 0; i < 10; ++i) {
+            acc.add(512);
+        }
+        return acc.result();
+    }();
+    static_assert(constant.count == 10 && constant.min == 512 && constant.max == 512);
+    static_assert(constant.mean == 51200 && constant.rms == 51200 && constant.variance == 0);
+
+    core::stats::accumulator<> acc;
+    for (const uint16_t value : { 1, 2, 3, 4 }) {
+        acc.add(value);
+    }
+    const auto summary = acc.result();
+    EXPECT_EQ(summary.min, 1u);
+    EXPECT_EQ(summary.max, 4u);
+    EXPECT_EQ(summary.mean, 250u);
+    EXPECT_EQ(summary.rms, 274u); // sqrt(7.5)
+    EXPECT_EQ(summary.variance, 125u);
+
+    // Exact for a full window of worst-case codes and for a small spread on a large offset
+    static_assert(core::is_same_v<core::stats::accumulator<1023, 4104>::square_sum_type, uint32_t>);
+    static_assert(core::is_same_v<core::stats::accumulator<1023, 4105>::square_sum_type, uint64_t>);
+    const auto full_scale = std::vector<uint16_t>(4096, 1023);
+    for (const auto& values : { noisy_codes(4096, 0, 1024), noisy_codes(4096, 1000, 4), full_scale }) {
+        core::stats::accumulator<1023, 4096> window;
+        for (const auto value : values) {
+            window.add(value);
+        }
+        const auto result = window.result();
+        const auto expected = compute(values);
+        EXPECT_EQ(result.count, 4096u);
+        EXPECT_EQ(result.mean, std::llround(expected.mean));
+        EXPECT_EQ(result.rms, std::llround(expected.rms));
+        EXPECT_EQ(result.variance, std::llround(expected.variance));
+    }
+}
+
+TEST(StatsTest, test_merge_equals_single_pass)
+{
+    const auto values = noisy_codes(300, 100, 800);
+    core::stats::accumulator<> whole;
+    core::stats::accumulator<> first;
+    core::stats::accumulator<> second;
+    for (size_t i = 0; i < values.size(); ++i) {
+        whole.add(values[i]);
+        (i < 120 ? first : second).add(values[i]);
+    }
+    first.merge(second);
+    const auto merged = first.result();
+    const auto single = whole.result();
+    EXPECT_EQ(merged.count, single.count);
+    EXPECT_EQ(merged.min, single.min);
+    EXPECT_EQ(merged.max, single.max);
+    EXPECT_EQ(merged.mean, single.mean);
+    EXPECT_EQ(merged.rms, single.rms);
+    EXPECT_EQ(merged.variance, single.variance);
+
+    first.reset();
+    EXPECT_EQ(first.count(), 0u);
+    EXPECT_EQ(first.sum(), 0u);
+}
+
+TEST(StatsTest, test_tumbling_windows)
+{
+    core::stats::tumbling<4> window;
+    std::vector<uint32_t> means;
+    for (uint16_t value = 0; value < 14; ++value) {
+        if (window.add(value)) {
+            means.push_back(window.last().mean);
+            EXPECT_EQ(window.last().count, 4u);
+        }
+    }
+    // Windows 0-3, 4-7, 8-11, the last two samples are pending
+    EXPECT_EQ(means, (std::vector<uint32_t> { 150, 550, 950 }));
+    EXPECT_EQ(window.last().min, 8u);
+    EXPECT_EQ(window.last().max, 11u);
+}
+
+TEST(StatsTest, test_sliding_windows_match_recomputation)
+{
+    constexpr uint16_t hop = 5;
+    constexpr uint8_t blocks = 4;
+    core::stats::sliding<hop, blocks> window;
+    static_assert(decltype(window)::length == 20);
+
+    const auto values = noisy_codes(200, 0, 1024);
+    size_t summaries = 0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!window.add(values[i])) {
+            continue;
+        }
+        ++summaries;
+        // The last 20 samples, ending with this one
+        const std::vector<uint16_t> expected_values(values.begin() + static_cast<long>(i + 1 - 20),
+            values.begin() + static_cast<long>(i + 1));
+        const auto expected = compute(expected_values);
+        const auto& last = window.last();
+        ASSERT_EQ(last.count, 20u) << "i=" << i;
+        EXPECT_EQ(last.min, *std::min_element(expected_values.begin(), expected_values.end()));
+        EXPECT_EQ(last.max, *std::max_element(expected_values.begin(), expected_values.end()));
+        EXPECT_EQ(last.mean, std::llround(expected.mean));
+        EXPECT_EQ(last.variance, std::llround(expected.variance));
+    }
+    // First summary once 20 samples are in, then one per hop
+    EXPECT_EQ(summaries, (200u - 20u) / hop + 1);
+
+    window.reset();
+    for (uint16_t i = 0; i < 19; ++i) {
+        EXPECT_FALSE(window.add(i));
+    }
+    EXPECT_TRUE(window.add(19));
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
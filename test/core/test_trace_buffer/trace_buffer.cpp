@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <utils/trace_buffer.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+TEST(TraceBufferTest, test_tags)
+{
+    constexpr auto tag = core::trace::tag(core::trace::kind::end, 5);
+    static_assert(tag == 0x85);
+    static_assert(core::trace::kind_of(tag) == core::trace::kind::end);
+    static_assert(core::trace::id_of(tag) == 5);
+    static_assert(core::trace::id_of(core::trace::tag(core::trace::kind::begin, core::trace::max_id)) == 63);
+    SUCCEED();
+}
+
+TEST(TraceBufferTest, test_ring_order)
+{
+    core::trace::ring<4> events;
+    EXPECT_EQ(events.size(), 0);
+    events.record(1, 100);
+    events.record(2, 200);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].tag, 1);
+    EXPECT_EQ(events[1].stamp, 200);
+
+    // Overwrites the oldest once full, still oldest first
+    for (uint8_t i = 3; i <= 6; ++i) {
+        events.record(i, static_cast<uint16_t>(i * 100));
+    }
+    ASSERT_TRUE(events.full());
+    ASSERT_EQ(events.size(), 4);
+    for (uint8_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(events[i].tag, i + 3);
+        EXPECT_EQ(events[i].stamp, (i + 3) * 100);
+    }
+
+    events.clear();
+    EXPECT_EQ(events.size(), 0);
+    EXPECT_FALSE(events.full());
+}
+
+TEST(TraceBufferTest, test_dump_binary)
+{
+    core::trace::ring<32> events;
+    for (uint8_t i = 0; i < 20; ++i) {
+        events.record(core::trace::tag(core::trace::kind::instant, i), static_cast<uint16_t>(i * 1000));
+    }
+
+    std::vector<std::vector<uint8_t>> chunks;
+    core::trace::dump_binary(7, events, [&chunks](core::span<const uint8_t> chunk) {
+        chunks.emplace_back(chunk.begin(), chunk.end());
+    });
+    ASSERT_EQ(chunks.size(), 2u);
+    for (const auto& chunk : chunks) {
+        ASSERT_LE(chunk.size(), core::trace::wire::max_binary_size);
+        EXPECT_EQ(chunk.front(), 0x00);
+        EXPECT_EQ(chunk.back(), 0x00);
+        for (size_t i = 1; i + 1 < chunk.size(); ++i) {
+            EXPECT_NE(chunk[i], 0x00);
+        }
+    }
+
+    // First chunk: header, 16 events, CRC
+    uint8_t raw[core::trace::wire::max_chunk_size];
+    const auto decoded = core::cobs::decode({ chunks[0].data() + 1, chunks[0].size() - 2 }, raw);
+    ASSERT_EQ(decoded.size(), core::trace::wire::max_chunk_size);
+    EXPECT_EQ(decoded[0], 7);
+    EXPECT_EQ(decoded[1], core::trace::wire::marker);
+    EXPECT_EQ(decoded[2], 0);
+    EXPECT_EQ(decoded[3], 20);
+    EXPECT_EQ(decoded[4 + 3 * 2], 2);
+    EXPECT_EQ(decoded[4 + 3 * 2 + 1], 2000 & 0xFF);
+    EXPECT_EQ(decoded[4 + 3 * 2 + 2], 2000 >> 8);
+    const auto crc = core::crc::ccitt({ decoded.data(), decoded.size() - 2 });
+    EXPECT_EQ(decoded[decoded.size() - 2], crc & 0xFF);
+    EXPECT_EQ(decoded[decoded.size() - 1], crc >> 8);
+}
+
+TEST(TraceBufferTest, test_dump_hex)
+{
+    core::trace::ring<8> events;
+    events.record(core::trace::tag(core::trace::kind::begin, 1), 0x1234);
+
+    std::vector<std::string> lines;
+    core::trace::dump_hex(0, events, [&lines](core::span<char> line) { lines.emplace_back(line.data(), line.size()); });
+    ASSERT_EQ(lines.size(), 1u);
+    const uint8_t chunk[] = { 0x00, 0xF0, 0x00, 0x01, 0x41, 0x34, 0x12 };
+    const auto crc = core::crc::ccitt(chunk);
+    char expected[64];
+    std::snprintf(expected, sizeof(expected), "trace:00F00001413412%02X%02X\r\n", crc & 0xFF, crc >> 8);
+    EXPECT_EQ(lines[0], expected);
+
+    // An empty ring still answers with a header-only chunk
+    events.clear();
+    lines.clear();
+    core::trace::dump_hex(1, events, [&lines](core::span<char> line) { lines.emplace_back(line.data(), line.size()); });
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].substr(0, 14), "trace:01F00000");
+    EXPECT_LE(lines[0].size(), core::trace::wire::max_hex_size);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
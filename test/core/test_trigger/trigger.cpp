@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <utils/trigger.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// @brief Firing pattern of a detector over a sample sequence, '1' where it fires
+std::string fires(core::trigger::detector& detector, std::initializer_list<uint16_t> values)
+{
+    std::string pattern;
+    for (const auto value : values) {
+        pattern += detector.update(value) ? '1' : '0';
+    }
+    return pattern;
+}
+
+template <uint16_t Capacity>
+std::vector<uint16_t> window(const core::trigger::capture<Capacity>& capture)
+{
+    std::vector<uint16_t> samples;
+    for (uint16_t i = 0; i < capture.size(); ++i) {
+        samples.push_back(capture[i]);
+    }
+    return samples;
+}
+
+} // namespace
+
+TEST(TriggerTest, test_level_and_edges)
+{
+    using core::trigger::mode;
+    core::trigger::detector above({ mode::above, 500, 0, 0 });
+    EXPECT_EQ(fires(above, { 100, 500, 600, 400, 700 }), "01101");
+    core::trigger::detector below({ mode::below, 500, 0, 0 });
+    EXPECT_EQ(fires(below, { 100, 500, 600, 400, 700 }), "11010");
+
+    // Starting above the level is not an edge
+    core::trigger::detector rising({ mode::rising, 500, 0, 0 });
+    EXPECT_EQ(fires(rising, { 600, 400, 500, 600, 499, 501 }), "001001");
+    core::trigger::detector falling({ mode::falling, 500, 0, 0 });
+    EXPECT_EQ(fires(falling, { 400, 600, 500, 400, 501, 499 }), "001001");
+    core::trigger::detector either({ mode::either, 500, 0, 0 });
+    EXPECT_EQ(fires(either, { 400, 600, 400, 600 }), "0111");
+}
+
+TEST(TriggerTest, test_hysteresis_rejects_noise)
+{
+    using core::trigger::mode;
+    // Noise around the level: only the excursion below 480 re-arms
+    core::trigger::detector rising({ mode::rising, 500, 0, 20 });
+    EXPECT_EQ(fires(rising, { 470, 505, 495, 505, 490, 510, 479, 500 }), "01000001");
+    core::trigger::detector falling({ mode::falling, 500, 0, 20 });
+    EXPECT_EQ(fires(falling, { 530, 495, 505, 495, 521, 500 }), "010001");
+
+    // No room below the level to arm
+    core::trigger::detector floor({ mode::rising, 10, 0, 10 });
+    EXPECT_EQ(fires(floor, { 0, 20, 0, 20 }), "0000");
+    // Re-arming does not carry over a condition change
+    rising.set({ mode::rising, 500, 0, 20 });
+    EXPECT_EQ(fires(rising, { 600, 400, 600 }), "001");
+}
+
+TEST(TriggerTest, test_windows)
+{
+    using core::trigger::mode;
+    core::trigger::detector exit({ mode::exit_window, 400, 600, 0 });
+    EXPECT_EQ(fires(exit, { 700, 500, 600, 601, 650, 450, 399 }), "0001001");
+    core::trigger::detector enter({ mode::enter_window, 400, 600, 0 });
+    EXPECT_EQ(fires(enter, { 500, 700, 600, 500, 300, 400 }), "001001");
+}
+
+TEST(TriggerTest, test_capture_window)
+{
+    using core::trigger::mode;
+    core::trigger::capture<16> capture;
+    EXPECT_EQ(capture.status(), core::trigger::state::stopped);
+    ASSERT_TRUE(capture.arm({ { mode::rising, 100, 0, 0 }, 3, 4, 1 }));
+    EXPECT_EQ(capture.status(), core::trigger::state::filling);
+
+    // An edge before the history is full is ignored, then the ramp wraps the buffer before the real edge
+    capture.on_sample(0);
+    capture.on_sample(200);
+    EXPECT_EQ(capture.status(), core::trigger::state::filling);
+    for (uint16_t value = 1; value <= 20; ++value) {
+        capture.on_sample(value);
+    }
+    EXPECT_EQ(capture.status(), core::trigger::state::armed);
+    for (const uint16_t value : { 150, 151, 152 }) {
+        capture.on_sample(value);
+    }
+    EXPECT_EQ(capture.status(), core::trigger::state::triggered);
+    EXPECT_FALSE(capture.ready());
+    capture.on_sample(153);
+    ASSERT_TRUE(capture.ready());
+    EXPECT_EQ(capture.captures(), 1u);
+
+    // Frozen until rearm()
+    capture.on_sample(999);
+    EXPECT_EQ(window(capture), (std::vector<uint16_t> { 18, 19, 20, 150, 151, 152, 153 }));
+    EXPECT_EQ(capture.trigger_index(), 3u);
+    EXPECT_EQ(capture[capture.trigger_index()], 150u);
+
+    capture.rearm();
+    for (const uint16_t value : { 1, 2, 3, 4, 5, 200, 6, 7, 8 }) {
+        capture.on_sample(value);
+    }
+    ASSERT_TRUE(capture.ready());
+    EXPECT_EQ(window(capture), (std::vector<uint16_t> { 3, 4, 5, 200, 6, 7, 8 }));
+    EXPECT_EQ(capture.captures(), 2u);
+
+    // Full-scale 10-bit samples survive the packed storage, 256 of them take 320 bytes
+    capture.rearm();
+    for (const uint16_t value : { 1023, 0, 1023, 0, 1023, 0, 1023, 1023 }) {
+        capture.on_sample(value);
+    }
+    ASSERT_TRUE(capture.ready());
+    EXPECT_EQ(window(capture), (std::vector<uint16_t> { 0, 1023, 0, 1023, 0, 1023, 1023 }));
+    static_assert(sizeof(core::trigger::capture<256>) < 256 * 2 - 128);
+}
+
+TEST(TriggerTest, test_capture_decimation_and_limits)
+{
+    using core::trigger::mode;
+    core::trigger::capture<8> capture;
+    EXPECT_FALSE(capture.arm({ { mode::above, 0, 0, 0 }, 5, 4, 1 }));
+    EXPECT_FALSE(capture.arm({ { mode::above, 0, 0, 0 }, 2, 0, 1 }));
+    EXPECT_EQ(capture.status(), core::trigger::state::stopped);
+    capture.rearm();
+    EXPECT_EQ(capture.status(), core::trigger::state::stopped);
+
+    // Level trigger, one sample out of 3 kept, no history, a single sample window
+    ASSERT_TRUE(capture.arm({ { mode::above, 50, 0, 0 }, 0, 1, 3 }));
+    for (const uint16_t value : { 10, 20, 30, 60, 70, 80 }) {
+        capture.on_sample(value);
+    }
+    ASSERT_TRUE(capture.ready());
+    EXPECT_EQ(window(capture), (std::vector<uint16_t> { 60 }));
+
+    // Whole buffer: 4 history samples and 4 from the trigger on
+    ASSERT_TRUE(capture.arm({ { mode::falling, 50, 0, 0 }, 4, 4, 0 }));
+    for (const uint16_t value : { 90, 80, 70, 60, 50, 40, 30, 20, 10 }) {
+        capture.on_sample(value);
+    }
+    ASSERT_TRUE(capture.ready());
+    EXPECT_EQ(window(capture), (std::vector<uint16_t> { 90, 80, 70, 60, 50, 40, 30, 20 }));
+    capture.stop();
+    EXPECT_FALSE(capture.ready());
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
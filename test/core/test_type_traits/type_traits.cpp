@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <type_traits.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+struct base { };
+struct derived : base { };
+
+struct explicit_only {
+    explicit explicit_only(int) { }
+};
+
+struct with_data {
+    int* data();
+    long size() const;
+};
+
+struct without_size {
+    int* data();
+};
+
+template <typename T>
+core::enable_if_t<core::is_unsigned_v<T>, int> overload(T)
+{
+    return 1;
+}
+
+template <typename T>
+core::enable_if_t<!core::is_unsigned_v<T>, int> overload(T)
+{
+    return 2;
+}
+
+} // namespace
+
+TEST(TypeTraitsTest, test_constants_and_selection)
+{
+    static_assert(core::true_type::value && !core::false_type::value);
+    static_assert(core::integral_constant<int, 3> {}() == 3);
+    static_assert(core::is_same_v<core::conditional_t<true, int, long>, int>);
+    static_assert(core::is_same_v<core::conditional_t<false, int, long>, long>);
+    static_assert(core::is_same_v<core::enable_if_t<true>, void>);
+    static_assert(core::is_same_v<core::void_t<int, long>, void>);
+    static_assert(!core::is_same_v<int, const int>);
+
+    EXPECT_EQ(overload(1u), 1);
+    EXPECT_EQ(overload(1), 2);
+}
+
+TEST(TypeTraitsTest, test_modifications)
+{
+    static_assert(core::is_same_v<core::remove_cv_t<const volatile int>, int>);
+    static_assert(core::is_same_v<core::remove_const_t<const int*>, const int*>);
+    static_assert(core::is_same_v<core::remove_const_t<int* const>, int*>);
+    static_assert(core::is_same_v<core::remove_reference_t<int&&>, int>);
+    static_assert(core::is_same_v<core::remove_cvref_t<const int&>, int>);
+    static_assert(core::is_same_v<core::remove_pointer_t<const int* const>, const int>);
+    static_assert(core::is_same_v<core::remove_pointer_t<int>, int>);
+    static_assert(core::is_same_v<decltype(core::declval<int&>()), int&>);
+}
+
+TEST(TypeTraitsTest, test_categories_match_std)
+{
+    static_assert(core::is_pointer_v<int* const> == std::is_pointer_v<int* const>);
+    static_assert(core::is_pointer_v<int[2]> == std::is_pointer_v<int[2]>);
+    static_assert(core::is_array_v<int[2]> && core::is_array_v<int[]> && !core::is_array_v<int*>);
+    static_assert(core::is_const_v<const int> && !core::is_const_v<const int*>);
+
+    static_assert(core::is_integral_v<bool> && core::is_integral_v<const char>);
+    static_assert(core::is_integral_v<std::uint8_t> && core::is_integral_v<std::int64_t>);
+    static_assert(!core::is_integral_v<float> && !core::is_integral_v<int*> && !core::is_integral_v<base>);
+
+    static_assert(core::is_unsigned_v<std::uint16_t> == std::is_unsigned_v<std::uint16_t>);
+    static_assert(core::is_unsigned_v<std::int16_t> == std::is_unsigned_v<std::int16_t>);
+    static_assert(core::is_unsigned_v<bool> == std::is_unsigned_v<bool>);
+    static_assert(core::is_unsigned_v<char> == std::is_unsigned_v<char>);
+    static_assert(!core::is_unsigned_v<float> && !core::is_unsigned_v<base>);
+}
+
+TEST(TypeTraitsTest, test_conversions_match_std)
+{
+    static_assert(core::is_convertible_v<int, long> == std::is_convertible_v<int, long>);
+    static_assert(core::is_convertible_v<derived*, base*> == std::is_convertible_v<derived*, base*>);
+    static_assert(core::is_convertible_v<base*, derived*> == std::is_convertible_v<base*, derived*>);
+    static_assert(core::is_convertible_v<int, explicit_only> == std::is_convertible_v<int, explicit_only>);
+    static_assert(core::is_convertible_v<void, void> == std::is_convertible_v<void, void>);
+    static_assert(core::is_convertible_v<int, void> == std::is_convertible_v<int, void>);
+    static_assert(core::is_convertible_v<int[2], int*> == std::is_convertible_v<int[2], int*>);
+
+    static_assert(core::is_array_convertible_v<int, const int>);
+    static_assert(core::is_array_convertible_v<int, int>);
+    static_assert(!core::is_array_convertible_v<const int, int>);
+    static_assert(!core::is_array_convertible_v<derived, base>);
+    static_assert(!core::is_array_convertible_v<int, unsigned>);
+}
+
+TEST(TypeTraitsTest, test_iterator_and_container_detection)
+{
+    static_assert(core::is_contiguous_iterator_v<const int*>);
+    static_assert(!core::is_contiguous_iterator_v<int>);
+    static_assert(!core::is_contiguous_iterator_v<std::vector<int>::iterator>);
+    static_assert(core::is_same_v<core::iter_element_t<const int*>, const int>);
+
+    static_assert(core::has_data_and_size_v<with_data>);
+    static_assert(core::has_data_and_size_v<std::vector<int>>);
+    static_assert(!core::has_data_and_size_v<without_size>);
+    static_assert(!core::has_data_and_size_v<int[4]>);
+    static_assert(core::is_same_v<core::container_element_t<const std::vector<int>>, const int>);
+
+    // to_address does not dereference, end iterators are fine
+    std::vector<int> values { 1, 2, 3 };
+    EXPECT_EQ(core::to_address(values.data() + 3), values.data() + 3);
+    EXPECT_EQ(core::to_address(values.end()), values.data() + 3);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <utils/uart_link.hpp>
+
+#include <cstdint>
+#include <set>
+#include <string>
+
+namespace {
+
+constexpr uint32_t F_CPU_16MHZ = 16000000;
+
+} // namespace
+
+TEST(UartLinkTest, test_best_setting_at_16mhz)
+{
+    constexpr auto slow = core::uart::best_setting(F_CPU_16MHZ, 9600);
+    static_assert(slow.ubrr == 103 && !slow.double_speed && slow.error_bp == 16 && slow.actual_baud == 9615);
+
+    // Double speed halves the divisor step where it matters
+    const auto medium = core::uart::best_setting(F_CPU_16MHZ, 57600);
+    EXPECT_EQ(medium.ubrr, 34u);
+    EXPECT_TRUE(medium.double_speed);
+    EXPECT_EQ(medium.error_bp, -79);
+
+    const auto classic = core::uart::best_setting(F_CPU_16MHZ, 115200);
+    EXPECT_EQ(classic.ubrr, 16u);
+    EXPECT_TRUE(classic.double_speed);
+    EXPECT_EQ(classic.error_bp, 212);
+
+    // Divisors of F_CPU / 16 are exact at normal speed, which wins ties
+    for (const uint32_t baud : { 250000u, 500000u, 1000000u }) {
+        const auto exact = core::uart::best_setting(F_CPU_16MHZ, baud);
+        EXPECT_EQ(exact.error_bp, 0) << "baud=" << baud;
+        EXPECT_FALSE(exact.double_speed) << "baud=" << baud;
+        EXPECT_EQ(exact.ubrr, F_CPU_16MHZ / 16 / baud - 1) << "baud=" << baud;
+        EXPECT_EQ(exact.actual_baud, baud);
+    }
+    const auto fastest = core::uart::best_setting(F_CPU_16MHZ, 2000000);
+    EXPECT_EQ(fastest.ubrr, 0u);
+    EXPECT_TRUE(fastest.double_speed);
+    EXPECT_EQ(fastest.error_bp, 0);
+
+    // The divisor saturates to the 12-bit register
+    EXPECT_EQ(core::uart::divisor(F_CPU_16MHZ, 100, false).ubrr, 4095u);
+    EXPECT_EQ(core::uart::divisor(F_CPU_16MHZ, 4000000, true).ubrr, 0u);
+}
+
+TEST(UartLinkTest, test_link_config_tolerance)
+{
+    using fast = core::uart::link_config<F_CPU_16MHZ, 500000>;
+    static_assert(fast::setting.ubrr == 1 && fast::tolerance_bp == 200);
+    using medium = core::uart::link_config<F_CPU_16MHZ, 57600>;
+    static_assert(medium::setting.double_speed && medium::tolerance_bp == 150);
+    // 115200 only builds with an explicit wider tolerance
+    using relaxed = core::uart::link_config<F_CPU_16MHZ, 115200, 250>;
+    static_assert(relaxed::setting.error_bp == 212 && relaxed::tolerance_bp == 250);
+    EXPECT_EQ(core::uart::max_error_bp(true), 150);
+    EXPECT_EQ(core::uart::max_error_bp(false), 200);
+}
+
+TEST(UartLinkTest, test_format)
+{
+    char text[64];
+    core::fmt::writer out(text);
+    core::uart::format(out, core::uart::best_setting(F_CPU_16MHZ, 57600));
+    EXPECT_EQ(std::string(out.written().data(), out.written().size()), "link,57600,57143,-0.79,34,1");
+
+    core::fmt::writer exact(text);
+    core::uart::format(exact, core::uart::best_setting(F_CPU_16MHZ, 500000));
+    EXPECT_EQ(std::string(exact.written().data(), exact.written().size()), "link,500000,500000,0.00,1,0");
+}
+
+TEST(UartLinkTest, test_selftest_frames)
+{
+    // Every word of a full sequence cycle is distinct, so a misplaced or repeated word shows
+    std::set<uint16_t> words;
+    for (unsigned sequence = 0; sequence < 256; ++sequence) {
+        for (uint8_t i = 0; i < core::uart::selftest::frame_samples; ++i) {
+            words.insert(core::uart::selftest::pattern(static_cast<uint8_t>(sequence), i));
+        }
+    }
+    EXPECT_EQ(words.size(), 4096u);
+
+    uint8_t wire[core::uart::selftest::frame_size];
+    const auto frame = core::uart::selftest::encode(7, wire);
+    ASSERT_LE(frame.size(), sizeof(wire));
+    EXPECT_EQ(frame.back(), 0u);
+
+    core::frame::decoder<core::uart::selftest::frame_samples> decoder;
+    core::frame::status status = core::frame::status::pending;
+    for (const auto byte : frame) {
+        status = decoder.feed(byte);
+    }
+    ASSERT_EQ(status, core::frame::status::packet);
+    EXPECT_EQ(decoder.last().sequence, 7u);
+    EXPECT_EQ(decoder.last().channel, 0u);
+    ASSERT_EQ(decoder.last().samples.size(), core::uart::selftest::frame_samples);
+    EXPECT_EQ(decoder.last().samples[3], core::uart::selftest::pattern(7, 3));
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <utils/uart_queue.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using core::uart::overflow_policy;
+
+template <class Queue>
+bool write(Queue& queue, const std::string& record)
+{
+    return queue.write(core::span<const uint8_t>(reinterpret_cast<const uint8_t*>(record.data()), record.size()));
+}
+
+/// @brief Pop count bytes, or everything queued
+template <class Queue>
+std::string pop(Queue& queue, size_t count = SIZE_MAX)
+{
+    std::string bytes;
+    uint8_t byte = 0;
+    while (bytes.size() < count && queue.pop(byte)) {
+        bytes.push_back(static_cast<char>(byte));
+    }
+    return bytes;
+}
+
+} // namespace
+
+TEST(UartQueueTest, test_drop_newest)
+{
+    core::uart::record_queue<8, 4> queue;
+    EXPECT_TRUE(write(queue, "abc"));
+    EXPECT_TRUE(write(queue, "defg"));
+    EXPECT_FALSE(write(queue, "hi"));
+    EXPECT_FALSE(write(queue, ""));
+    EXPECT_FALSE(write(queue, "too long!"));
+    EXPECT_EQ(queue.pending(), 7u);
+
+    EXPECT_EQ(pop(queue), "abcdefg");
+    EXPECT_EQ(queue.stats().accepted, 2u);
+    EXPECT_EQ(queue.stats().dropped, 3u);
+}
+
+TEST(UartQueueTest, test_record_count_limit)
+{
+    core::uart::record_queue<16, 2> queue;
+    EXPECT_TRUE(write(queue, "a"));
+    EXPECT_TRUE(write(queue, "b"));
+    EXPECT_FALSE(write(queue, "c"));
+    EXPECT_EQ(pop(queue, 1), "a");
+    EXPECT_TRUE(write(queue, "c"));
+    EXPECT_EQ(pop(queue), "bc");
+}
+
+TEST(UartQueueTest, test_drop_oldest_keeps_record_on_the_wire)
+{
+    core::uart::record_queue<8, 4> queue;
+    queue.set_policy(overflow_policy::drop_oldest);
+    EXPECT_TRUE(write(queue, "abc"));
+    EXPECT_TRUE(write(queue, "de"));
+    EXPECT_TRUE(write(queue, "fg"));
+
+    // "abc" has started, only whole unsent records are dropped, oldest first
+    EXPECT_EQ(pop(queue, 1), "a");
+    EXPECT_TRUE(write(queue, "hijk"));
+    EXPECT_EQ(queue.stats().dropped, 1u);
+    EXPECT_EQ(pop(queue), "bcfghijk");
+
+    // Wrapped queue
+    EXPECT_TRUE(write(queue, "lmnop"));
+    EXPECT_TRUE(write(queue, "qr"));
+    EXPECT_TRUE(write(queue, "stu"));
+    EXPECT_EQ(pop(queue), "qrstu");
+    EXPECT_EQ(queue.stats().dropped, 2u);
+}
+
+TEST(UartQueueTest, test_decimate)
+{
+    core::uart::record_queue<8, 8> queue;
+    queue.set_policy(overflow_policy::decimate, 3);
+    EXPECT_TRUE(write(queue, "ab"));
+    EXPECT_TRUE(write(queue, "cd"));
+
+    // Half full: one record out of 3
+    EXPECT_FALSE(write(queue, "e"));
+    EXPECT_FALSE(write(queue, "f"));
+    EXPECT_TRUE(write(queue, "g"));
+    EXPECT_EQ(queue.stats().decimated, 2u);
+    EXPECT_EQ(pop(queue), "abcdg");
+
+    // Below half full again: everything goes
+    EXPECT_TRUE(write(queue, "h"));
+    EXPECT_TRUE(write(queue, "i"));
+    EXPECT_EQ(pop(queue), "hi");
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <capture.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+/// Unique capture path in the temp directory, removed on destruction
+struct temp_path {
+    std::string path = "/tmp/test_capture_" + std::to_string(::getpid()) + "_"
+        + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".cap";
+    ~temp_path() { ::unlink(path.c_str()); }
+};
+
+} // namespace
+
+TEST(CaptureTest, test_layout)
+{
+    constexpr auto regions = host::capture::make_layout(5000, 10);
+    static_assert(regions.values_offset == 4096);
+    static_assert(regions.channels_offset == 4096 + 12288);
+    static_assert(regions.index_offset == 4096 + 12288 + 8192);
+    static_assert(regions.file_size == 4096 + 12288 + 8192 + 4096);
+    static_assert(sizeof(host::capture::header) <= host::capture::page_size);
+    SUCCEED();
+}
+
+TEST(CaptureTest, test_roundtrip)
+{
+    temp_path file;
+    host::capture::writer out;
+    ASSERT_TRUE(out.open(file.path.c_str(), 100, 4, 42));
+
+    out.push(1, 100);
+    out.push(1, 101);
+    out.commit(1000, host::capture::source::frame_raw16, 1, 7);
+    out.push(0, 200);
+    out.push(2, 300);
+    out.push(0, 201);
+    out.commit(2000, host::capture::source::csv);
+    EXPECT_EQ(out.count(), 5u);
+
+    // Readers see committed samples of a capture still being written
+    host::capture::reader in;
+    ASSERT_TRUE(in.open(file.path.c_str()));
+    EXPECT_EQ(in.info().created_ns, 42u);
+    EXPECT_EQ(in.info().capacity, 100u);
+    out.push(3, 400); // staged, not committed
+    ASSERT_EQ(in.count(), 5u);
+
+    const uint16_t values[] = { 100, 101, 200, 300, 201 };
+    const uint8_t channels[] = { 1, 1, 0, 2, 0 };
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(in.values()[i], values[i]);
+        EXPECT_EQ(in.channels()[i], channels[i]);
+    }
+
+    const auto index = in.index();
+    ASSERT_EQ(index.size(), 2u);
+    EXPECT_EQ(index[0].first_sample, 0u);
+    EXPECT_EQ(index[0].count, 2u);
+    EXPECT_EQ(index[0].host_time_ns, 1000u);
+    EXPECT_EQ(index[0].channel, 1);
+    EXPECT_EQ(index[0].sequence, 7);
+    EXPECT_EQ(index[0].format, host::capture::source::frame_raw16);
+    EXPECT_EQ(index[1].first_sample, 2u);
+    EXPECT_EQ(index[1].count, 3u);
+    EXPECT_EQ(index[1].channel, host::capture::mixed_channel);
+    EXPECT_EQ(index[1].format, host::capture::source::csv);
+
+    // Empty commits add no index entry
+    out.commit(3000, host::capture::source::csv);
+    out.commit(3000, host::capture::source::csv);
+    EXPECT_EQ(in.count(), 6u);
+    EXPECT_EQ(in.index().size(), 3u);
+
+    out.close();
+    EXPECT_EQ(in.count(), 6u);
+    EXPECT_EQ(in.values()[5], 400);
+}
+
+TEST(CaptureTest, test_full)
+{
+    temp_path file;
+    host::capture::writer out;
+    ASSERT_TRUE(out.open(file.path.c_str(), 3, 1, 0));
+
+    EXPECT_TRUE(out.push(0, 1));
+    EXPECT_TRUE(out.push(0, 2));
+    out.commit(1, host::capture::source::csv);
+    EXPECT_TRUE(out.push(0, 3));
+    EXPECT_TRUE(out.full());
+    EXPECT_FALSE(out.push(0, 4));
+    EXPECT_EQ(out.dropped(), 1u);
+    // The index is full too, the batch is still published
+    out.commit(2, host::capture::source::csv);
+    EXPECT_EQ(out.count(), 3u);
+    EXPECT_EQ(out.unindexed(), 1u);
+
+    host::capture::reader in;
+    ASSERT_TRUE(in.open(file.path.c_str()));
+    EXPECT_EQ(in.count(), 3u);
+    EXPECT_EQ(in.index().size(), 1u);
+}
+
+TEST(CaptureTest, test_invalid)
+{
+    temp_path file;
+    host::capture::writer out;
+    EXPECT_FALSE(out.open(file.path.c_str(), 0, 1, 0));
+    EXPECT_FALSE(out.is_open());
+    EXPECT_STRNE(out.error(), "");
+    EXPECT_FALSE(out.open("/nonexistent/dir/capture.cap", 10, 1, 0));
+
+    // Not a capture: a page of zeros
+    const int fd = ::open(file.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(::ftruncate(fd, 4096), 0);
+    ::close(fd);
+    host::capture::reader in;
+    EXPECT_FALSE(in.open(file.path.c_str()));
+    EXPECT_FALSE(in.open("/nonexistent/capture.cap"));
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
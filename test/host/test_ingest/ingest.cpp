@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <capture.hpp>
+#include <csv.hpp>
+#include <ingest.hpp>
+
+#include <frame.hpp>
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Capture in the temp directory, removed on destruction
+struct temp_capture {
+    std::string path = "/tmp/test_ingest_" + std::to_string(::getpid()) + "_"
+        + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".cap";
+    host::capture::writer out;
+    host::capture::reader in;
+
+    temp_capture()
+    {
+        EXPECT_TRUE(out.open(path.c_str(), 1024, 64, 0));
+        EXPECT_TRUE(in.open(path.c_str()));
+    }
+    ~temp_capture() { ::unlink(path.c_str()); }
+};
+
+core::span<const uint8_t> bytes_of(const char* text)
+{
+    return { reinterpret_cast<const uint8_t*>(text), std::strlen(text) };
+}
+
+} // namespace
+
+TEST(CsvTest, test_split_lines)
+{
+    host::csv::parser parser;
+    std::vector<std::pair<uint8_t, uint16_t>> samples;
+    const auto collect = [&samples](uint8_t channel, uint16_t raw) { samples.emplace_back(channel, raw); };
+
+    parser.feed(bytes_of("Channel; ADC; Voltage;\r\n1, 10"), collect);
+    parser.feed(bytes_of("23, 5000\r"), collect);
+    parser.feed(bytes_of("\n512, 2502\r\n"), collect);
+    parser.feed(bytes_of("2, 7\r\n1,x,3\r\n1, 2, 3, 4\r\n, 1, 2\r\n"), collect);
+
+    ASSERT_EQ(samples.size(), 3u);
+    EXPECT_EQ(samples[0], std::make_pair(uint8_t { 1 }, uint16_t { 1023 }));
+    EXPECT_EQ(samples[1], std::make_pair(uint8_t { 0 }, uint16_t { 512 }));
+    EXPECT_EQ(samples[2], std::make_pair(uint8_t { 0 }, uint16_t { 2 }));
+    EXPECT_EQ(parser.stats().lines, 7u);
+    EXPECT_EQ(parser.stats().samples, 3u);
+    EXPECT_EQ(parser.stats().skipped, 4u);
+}
+
+TEST(CsvTest, test_overlong_line)
+{
+    host::csv::parser parser;
+    int calls = 0;
+    std::string line(host::csv::parser::max_line + 10, ' ');
+    line += "1, 2, 3\n0, 5, 24\n";
+    parser.feed(bytes_of(line.c_str()), [&calls](uint8_t, uint16_t raw) {
+        EXPECT_EQ(raw, 5);
+        ++calls;
+    });
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(parser.stats().skipped, 1u);
+}
+
+TEST(IngestTest, test_csv)
+{
+    temp_capture capture;
+    host::ingest::session session(capture.out, host::ingest::format::automatic);
+
+    // No line feed yet: format still unknown, the partial line is discarded
+    session.feed(bytes_of("3, 1"), 1);
+    EXPECT_EQ(session.mode(), host::ingest::format::automatic);
+    session.feed(bytes_of("00, 488\r\n0, 7, 34\r\n1, 8, "), 2);
+    EXPECT_EQ(session.mode(), host::ingest::format::csv);
+    session.feed(bytes_of("39\r\n"), 3);
+
+    ASSERT_EQ(capture.in.count(), 2u);
+    EXPECT_EQ(capture.in.values()[0], 7);
+    EXPECT_EQ(capture.in.channels()[0], 0);
+    EXPECT_EQ(capture.in.values()[1], 8);
+    EXPECT_EQ(capture.in.channels()[1], 1);
+    ASSERT_EQ(capture.in.index().size(), 2u);
+    EXPECT_EQ(capture.in.index()[1].host_time_ns, 3u);
+    EXPECT_EQ(session.bytes(), 4u + 25u + 4u);
+    EXPECT_EQ(session.csv_stats().skipped, 0u);
+}
+
+TEST(IngestTest, test_binary)
+{
+    temp_capture capture;
+    host::ingest::session session(capture.out, host::ingest::format::automatic);
+
+    const uint16_t first[] = { 1, 2, 1023 };
+    const uint16_t second[] = { 500, 501, 499, 0 };
+    const uint16_t third[] = { 42 };
+    std::vector<uint8_t> stream { 'x', 'y', 0x00 }; // tail of a frame the receiver joined in
+    uint8_t wire[core::frame::max_frame_size(4, core::frame::encoding::delta)];
+    auto frame = core::frame::encode(5, 2, first, wire, core::frame::encoding::raw16);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    frame = core::frame::encode(6, 3, second, wire, core::frame::encoding::delta);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    frame = core::frame::encode(7, 2, third, wire, core::frame::encoding::packed10);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+
+    // Byte by byte: frames spanning several reads
+    for (size_t i = 0; i < stream.size(); ++i) {
+        session.feed({ &stream[i], 1 }, i);
+    }
+    EXPECT_EQ(session.mode(), host::ingest::format::binary);
+    EXPECT_EQ(session.frame_stats().frames, 3u);
+
+    const uint16_t values[] = { 1, 2, 1023, 500, 501, 499, 0, 42 };
+    const uint8_t channels[] = { 2, 2, 2, 3, 3, 3, 3, 2 };
+    ASSERT_EQ(capture.in.count(), 8u);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(capture.in.values()[i], values[i]);
+        EXPECT_EQ(capture.in.channels()[i], channels[i]);
+    }
+
+    const auto index = capture.in.index();
+    ASSERT_EQ(index.size(), 3u);
+    EXPECT_EQ(index[0].sequence, 5);
+    EXPECT_EQ(index[0].format, host::capture::source::frame_raw16);
+    EXPECT_EQ(index[1].first_sample, 3u);
+    EXPECT_EQ(index[1].channel, 3);
+    EXPECT_EQ(index[1].format, host::capture::source::frame_delta);
+    EXPECT_EQ(index[2].format, host::capture::source::frame_packed10);
+    EXPECT_EQ(index[2].host_time_ns, stream.size() - 1);
+}
+
+TEST(IngestTest, test_forced_format)
+{
+    temp_capture capture;
+    host::ingest::session session(capture.out, host::ingest::format::csv);
+    session.feed(bytes_of("0, 9, 43\n"), 0);
+    EXPECT_EQ(session.mode(), host::ingest::format::csv);
+    EXPECT_EQ(capture.in.count(), 1u);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
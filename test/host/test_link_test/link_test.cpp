@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <link_test.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// @brief Self-test stream of frames first to first + count - 1, with the firmware header if asked
+std::vector<uint8_t> make_stream(unsigned first, unsigned count, bool header)
+{
+    std::vector<uint8_t> stream;
+    if (header) {
+        const std::string line = "link,500000,500000,0.00,1,0\r\n";
+        stream.assign(line.begin(), line.end());
+    }
+    for (unsigned sequence = first; sequence < first + count; ++sequence) {
+        uint8_t wire[core::uart::selftest::frame_size];
+        const auto frame = core::uart::selftest::encode(static_cast<uint8_t>(sequence), wire);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    return stream;
+}
+
+/// @brief Feed a stream in chunks of chunk bytes, one millisecond apart
+host::link_test::statistics run(host::link_test::checker& checker, const std::vector<uint8_t>& stream,
+    size_t chunk = 64)
+{
+    uint64_t now = 1000000;
+    for (size_t offset = 0; offset < stream.size(); offset += chunk) {
+        const size_t size = stream.size() - offset < chunk ? stream.size() - offset : chunk;
+        checker.feed(core::span<const uint8_t>(stream.data() + offset, size), now);
+        now += 1000000;
+    }
+    return checker.stats();
+}
+
+} // namespace
+
+TEST(LinkTestTest, test_clean_stream)
+{
+    const auto stream = make_stream(0, 600, true);
+    host::link_test::checker checker;
+    const auto stats = run(checker, stream);
+    EXPECT_EQ(checker.header(), "link,500000,500000,0.00,1,0");
+    // The first frame is the baseline, the sequence wraps past 255 without gaps
+    EXPECT_EQ(stats.frames, 599u);
+    EXPECT_EQ(stats.pattern_errors + stats.crc_errors + stats.framing_errors + stats.dropped_frames, 0u);
+    EXPECT_EQ(stats.error_rate(), 0.0);
+    EXPECT_GT(stats.bytes_per_second(), 0.0);
+    EXPECT_LT(stats.bytes, stream.size());
+}
+
+TEST(LinkTestTest, test_corruption_and_drops)
+{
+    auto stream = make_stream(0, 100, true);
+    const size_t header = std::string("link,500000,500000,0.00,1,0\r\n").size();
+    const size_t frame = make_stream(0, 1, false).size();
+
+    // Flip a bit in the middle of frame 10, then cut frames 50 and 51 out
+    stream[header + 10 * frame + frame / 2] ^= 0x10;
+    stream.erase(stream.begin() + static_cast<long>(header + 50 * frame),
+        stream.begin() + static_cast<long>(header + 52 * frame));
+
+    host::link_test::checker checker;
+    const auto stats = run(checker, stream, 1000);
+    EXPECT_EQ(stats.frames, 96u);
+    EXPECT_EQ(stats.crc_errors + stats.framing_errors + stats.pattern_errors, 1u);
+    // The corrupted frame also leaves a sequence gap
+    EXPECT_EQ(stats.dropped_frames, 3u);
+    EXPECT_NEAR(stats.error_rate(), 4.0 / 100.0, 1e-12);
+}
+
+TEST(LinkTestTest, test_wrong_pattern)
+{
+    // A valid frame of the right size carrying other words
+    auto stream = make_stream(0, 3, false);
+    const uint16_t values[core::uart::selftest::frame_samples] {};
+    uint8_t wire[core::uart::selftest::frame_size];
+    const auto frame = core::frame::encode(3, 0, values, wire);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+
+    host::link_test::checker checker;
+    const auto stats = run(checker, stream);
+    EXPECT_TRUE(checker.header().empty());
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_EQ(stats.pattern_errors, 1u);
+    EXPECT_EQ(stats.crc_errors, 0u);
+}
+
+TEST(LinkTestTest, test_mid_stream_join)
+{
+    // Joining in the middle of a frame, without the header, costs nothing
+    const auto full = make_stream(40, 20, false);
+    const std::vector<uint8_t> stream(full.begin() + 17, full.end());
+    host::link_test::checker checker;
+    const auto stats = run(checker, stream, 7);
+    EXPECT_TRUE(checker.header().empty());
+    EXPECT_EQ(stats.frames, 18u);
+    EXPECT_EQ(stats.error_rate(), 0.0);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <replay.hpp>
+
+#include <frame.hpp>
+#include <stats.hpp>
+#include <utils/output.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr core::adc::channel_config CHANNELS[] = { { 0, 1 }, { 1, 4 } };
+
+/// Two short traces of distinct values, so any misrouted sample shows
+host::replay::trace make_trace()
+{
+    host::replay::trace source;
+    source.assign(0, { 10, 11, 12, 13, 14 });
+    source.assign(1, { 500, 501, 502 });
+    return source;
+}
+
+/// Link of the firmware queue size
+using test_link = host::replay::link<128, 16>;
+
+/// @brief Bytes of the records sent on the link
+std::vector<uint8_t> sent_bytes(test_link& link)
+{
+    std::vector<uint8_t> bytes;
+    link.deliver([&bytes](host::replay::record_fate fate, core::span<const uint8_t> record) {
+        if (fate == host::replay::record_fate::sent) {
+            bytes.insert(bytes.end(), record.begin(), record.end());
+        }
+    });
+    return bytes;
+}
+
+/// @brief Run conversions samples through a replay scanner and the output stage, return the verification
+template <core::output::mode Mode>
+host::replay::verification replay_through(const host::replay::trace& source, int conversions, bool corrupt = false)
+{
+    host::replay::scanner<32, 2> scanner(CHANNELS, source);
+    test_link link;
+    core::output::stage<Mode, 4> output;
+    scanner.start();
+    for (int i = 0; i < conversions; ++i) {
+        scanner.convert();
+        if (scanner.available() >= 8) {
+            while (output.send_next(scanner, link)) { }
+        }
+    }
+    while (output.send_next(scanner, link)) { }
+
+    std::vector<uint8_t> bytes = sent_bytes(link);
+    if (corrupt) {
+        // Turn the first 1 into a 2: the first CSV value becomes 20, a frame byte fails the CRC
+        auto digit = std::find(bytes.begin(), bytes.end(), Mode == core::output::mode::csv ? '1' : 11);
+        *digit = Mode == core::output::mode::csv ? '2' : 12;
+    }
+
+    host::replay::verifier verifier(source);
+    if constexpr (Mode == core::output::mode::binary) {
+        core::frame::decoder<> frames;
+        frames.feed(bytes, [&verifier](const core::frame::packet& packet) {
+            for (const auto sample : packet.samples) {
+                verifier.check(packet.channel, sample);
+            }
+        });
+    } else {
+        host::csv::parser lines;
+        lines.feed(bytes, [&verifier](uint8_t channel, uint16_t raw) { verifier.check(channel, raw); });
+    }
+    return verifier.stats();
+}
+
+} // namespace
+
+TEST(ReplayTest, test_synthesize_edo_square)
+{
+    constexpr size_t count = 9600;
+    const auto codes = host::replay::synthesize(host::replay::edo_system, 9600.0, count);
+    ASSERT_EQ(codes.size(), count);
+    // 1 kHz at 9.6 kS/s, 95 % high: the 50 us low phase is caught by about every other period
+    EXPECT_EQ(codes[0], 1023u);
+    EXPECT_EQ(codes[9], 1023u);
+    EXPECT_EQ(codes[19], 0u);
+    EXPECT_EQ(codes[20], 1023u);
+    const auto high = std::count(codes.begin(), codes.end(), 1023);
+    EXPECT_NEAR(static_cast<double>(high) / count, 0.95, 0.06);
+
+    // Noise stays within its bounds, the low-pass slows the edges down
+    auto noisy = host::replay::edo_system;
+    noisy.type = host::replay::shape::triangle;
+    noisy.semi_amplitude_v = 1.0;
+    noisy.noise_lsb = 4;
+    const auto clean = host::replay::synthesize({ host::replay::shape::triangle, 1000.0, 0.5, 1.0, 2.5, 0.0, 0 },
+        9600.0, count);
+    const auto dirty = host::replay::synthesize(noisy, 9600.0, count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_LE(std::abs(static_cast<int>(dirty[i]) - static_cast<int>(clean[i])), 4);
+    }
+    auto filtered = host::replay::edo_system;
+    filtered.cutoff_hz = 500;
+    const auto smooth = host::replay::synthesize(filtered, 9600.0, 32);
+    EXPECT_GT(smooth[19], 0u);
+    EXPECT_LT(smooth[20], 1023u);
+}
+
+TEST(ReplayTest, test_scanner_follows_schedule_and_traces)
+{
+    const auto source = make_trace();
+    host::replay::scanner<8, 2> scanner(CHANNELS, source);
+    scanner.start();
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_TRUE(scanner.convert());
+    }
+
+    // A0 every round, A1 every 4th round after A0, traces consumed in order
+    std::vector<uint16_t> values;
+    core::adc::tagged_sample sample;
+    while (scanner.pop(sample)) {
+        values.push_back(static_cast<uint16_t>(sample.channel() << 12 | sample.value()));
+    }
+    EXPECT_EQ(values, (std::vector<uint16_t> { 10, 1 << 12 | 500, 11, 12, 13, 14, 1 << 12 | 501 }));
+    // Settling conversions: start, 0->1, 1->0, 0->1
+    EXPECT_EQ(scanner.samples(), 7u);
+    EXPECT_EQ(scanner.conversions(), 11u);
+
+    // Undrained buffer overruns like the firmware one
+    for (int i = 0; i < 10; ++i) {
+        scanner.convert();
+    }
+    EXPECT_EQ(scanner.available(), 8u);
+    EXPECT_EQ(scanner.overruns(), 2u);
+}
+
+TEST(ReplayTest, test_output_stage_verified_end_to_end)
+{
+    const auto source = make_trace();
+    for (const bool binary : { false, true }) {
+        const auto checked = binary ? replay_through<core::output::mode::binary>(source, 1000)
+                                    : replay_through<core::output::mode::csv>(source, 1000);
+        EXPECT_EQ(checked.samples, 1000u);
+        EXPECT_EQ(checked.mismatches, 0u);
+    }
+
+    // Corruption on the link: a wrong CSV value, or a binary frame lost to its CRC which shifts its channel
+    const auto csv = replay_through<core::output::mode::csv>(source, 100, true);
+    EXPECT_EQ(csv.mismatches, 1u);
+    EXPECT_EQ(csv.first_mismatch, 0u);
+    const auto binary = replay_through<core::output::mode::binary>(source, 100, true);
+    EXPECT_LT(binary.samples, 100u);
+    EXPECT_GT(binary.mismatches, 0u);
+}
+
+TEST(ReplayTest, test_slow_link_loses_whole_records)
+{
+    // 24 samples per ms as CSV lines of about 10 bytes, through a 9600 baud link that sends 0.96 bytes per ms
+    const auto source = make_trace();
+    for (const auto policy : { core::uart::overflow_policy::drop_newest, core::uart::overflow_policy::drop_oldest }) {
+        host::replay::scanner<32, 2> scanner(CHANNELS, source);
+        test_link link(9600, policy);
+        core::output::stage<core::output::mode::csv, 4> output;
+        host::replay::verifier verifier(source);
+        host::csv::parser sent;
+        host::csv::parser lost;
+        const auto verify = [&] {
+            link.deliver([&](host::replay::record_fate fate, core::span<const uint8_t> record) {
+                if (fate == host::replay::record_fate::sent) {
+                    sent.feed(record, [&verifier](uint8_t channel, uint16_t raw) { verifier.check(channel, raw); });
+                } else {
+                    EXPECT_EQ(fate,
+                        policy == core::uart::overflow_policy::drop_newest ? host::replay::record_fate::rejected
+                                                                           : host::replay::record_fate::evicted);
+                    lost.feed(record, [&verifier](uint8_t channel, uint16_t raw) { verifier.lost(channel, raw); });
+                }
+            });
+        };
+
+        scanner.start();
+        for (int ms = 0; ms < 50; ++ms) {
+            for (int i = 0; i < 24; ++i) {
+                scanner.convert();
+            }
+            while (output.send_next(scanner, link)) { }
+            link.advance(1e-3);
+            verify();
+        }
+        link.flush();
+        verify();
+
+        // Every sample is accounted for, sent intact or lost whole with its record
+        const auto& checked = verifier.stats();
+        EXPECT_EQ(checked.samples + checked.lost, scanner.samples());
+        EXPECT_EQ(checked.mismatches, 0u);
+        EXPECT_GT(checked.lost, 0u);
+        EXPECT_GT(checked.samples, 0u);
+        EXPECT_EQ(link.stats().dropped, checked.lost);
+        EXPECT_EQ(sent.stats().skipped, 0u);
+    }
+}
+
+TEST(ReplayTest, test_output_stage_summaries)
+{
+    // 8-sample windows over the wrapping traces: 10 11 12 13 14 10 11 12, then 13 14 10 11 12 13 14 10
+    const auto source = make_trace();
+    host::replay::scanner<32, 2> scanner(CHANNELS, source);
+    test_link link;
+    core::output::stage<core::output::mode::csv, 4> output;
+    core::stats::tumbling<8> windows[2];
+    scanner.start();
+    for (int i = 0; i < 20; ++i) {
+        scanner.convert();
+    }
+    while (output.summarize_next(scanner, CHANNELS, windows, link)) { }
+
+    // 16 samples of A0 and 4 of A1: two A0 windows, A1 still pending
+    const auto bytes = sent_bytes(link);
+    const std::string text(bytes.begin(), bytes.end());
+    EXPECT_EQ(text,
+        "stats,0,8,11.63,10,14,11.70,1.73\r\n"
+        "stats,0,8,12.13,10,14,12.22,2.36\r\n");
+    EXPECT_EQ(link.records(), 2u);
+
+    // The CSV sample parser skips summary lines
+    host::csv::parser lines;
+    lines.feed(bytes, [](uint8_t, uint16_t) { FAIL(); });
+    EXPECT_EQ(lines.stats().skipped, 2u);
+}
+
+TEST(ReplayTest, test_load_csv_recording)
+{
+    const std::string path = "/tmp/test_replay_" + std::to_string(::getpid()) + ".csv";
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    std::fputs("Channel; ADC; Voltage;\r\n0, 100, 489\r\n1, 700, 3421\r\n0, 101, 494\r\n", file);
+    std::fclose(file);
+
+    host::replay::trace source;
+    ASSERT_TRUE(source.load(path.c_str()));
+    ::unlink(path.c_str());
+    EXPECT_EQ(source.size(), 3u);
+    EXPECT_EQ(std::vector<uint16_t>(source.channel(0).begin(), source.channel(0).end()),
+        (std::vector<uint16_t> { 100, 101 }));
+    EXPECT_EQ(source.channel(1)[0], 700u);
+    EXPECT_TRUE(source.channel(7).empty());
+    EXPECT_FALSE(source.load("/nonexistent/trace.csv"));
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
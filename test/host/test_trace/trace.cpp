@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <trace.hpp>
+
+#include <frame.hpp>
+#include <utils/trace_buffer.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using core::trace::kind;
+using core::trace::tag;
+
+/// Ring with an ISR region, an instant and a stamp wrap
+core::trace::ring<32> sample_ring()
+{
+    core::trace::ring<32> events;
+    events.record(tag(kind::begin, 0), 65000);
+    events.record(tag(kind::end, 0), 65100);
+    events.record(tag(kind::instant, 2), 200); // wrapped: 636 cycles later
+    events.record(tag(kind::begin, 0), 1000);
+    events.record(tag(kind::end, 0), 1250);
+    for (uint16_t i = 0; i < 20; ++i) {
+        events.record(tag(kind::instant, 1), static_cast<uint16_t>(2000 + i));
+    }
+    return events;
+}
+
+void append(std::vector<uint8_t>& stream, const char* text)
+{
+    stream.insert(stream.end(), text, text + std::strlen(text));
+}
+
+} // namespace
+
+TEST(TraceTest, test_unwrap)
+{
+    const core::trace::event raw[] = { { 0x40, 65000 }, { 0x80, 100 }, { 0x00, 100 }, { 0x01, 99 } };
+    const auto events = host::trace::unwrap(raw);
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events[0].cycle, 0u);
+    EXPECT_EQ(events[1].cycle, 636u);
+    EXPECT_EQ(events[1].type, kind::end);
+    EXPECT_EQ(events[2].cycle, 636u);
+    EXPECT_EQ(events[3].cycle, 636u + 65535u);
+    EXPECT_EQ(events[3].id, 1);
+}
+
+TEST(TraceTest, test_binary_in_mixed_stream)
+{
+    const auto ring = sample_ring();
+    std::vector<uint8_t> stream;
+    append(stream, "0, 512, 2502\r\n0, 5");
+    // A sample frame in between must not confuse either decoder
+    const uint16_t samples[] = { 1, 2, 3 };
+    uint8_t wire[core::frame::max_frame_size(3)];
+    const auto frame = core::frame::encode(0, 0, samples, wire);
+    stream.push_back(0x00);
+    stream.insert(stream.end(), frame.begin(), frame.end());
+    core::trace::dump_binary(3, ring, [&stream](core::span<const uint8_t> chunk) {
+        stream.insert(stream.end(), chunk.begin(), chunk.end());
+    });
+    append(stream, "0, 513, 2507\r\n");
+
+    host::trace::parser parser;
+    std::vector<host::trace::dump> dumps;
+    // Byte by byte: chunks spanning reads
+    for (const auto byte : stream) {
+        parser.feed({ &byte, 1 }, [&dumps](const host::trace::dump& item) { dumps.push_back(item); });
+    }
+    ASSERT_EQ(dumps.size(), 1u);
+    EXPECT_EQ(dumps[0].number, 3);
+    ASSERT_EQ(dumps[0].events.size(), 25u);
+    EXPECT_EQ(dumps[0].events[2].cycle, 736u);
+    EXPECT_EQ(parser.stats().chunks, 2u);
+    EXPECT_EQ(parser.stats().crc_errors, 0u);
+
+    // Core frame decoders reject trace chunks
+    core::frame::decoder<> frames;
+    frames.feed(stream, [](const core::frame::packet& packet) { EXPECT_EQ(packet.sequence, 0); });
+    EXPECT_EQ(frames.stats().frames, 1u);
+    EXPECT_EQ(frames.stats().samples, 3u);
+}
+
+TEST(TraceTest, test_hex_lines)
+{
+    const auto ring = sample_ring();
+    std::vector<uint8_t> stream;
+    core::trace::dump_hex(9, ring, [&stream](core::span<char> line) {
+        // simavr colors console lines
+        append(stream, "\x1b[32m");
+        stream.insert(stream.end(), line.begin(), line.end() - 2);
+        append(stream, "\x1b[0m\n");
+    });
+    // A corrupted copy of the first line of a second dump
+    std::string corrupted;
+    core::trace::dump_hex(10, ring, [&corrupted](core::span<char> line) {
+        if (corrupted.empty()) {
+            corrupted.assign(line.data(), line.size());
+        }
+    });
+    corrupted[12] = corrupted[12] == '0' ? '1' : '0';
+    append(stream, corrupted.c_str());
+
+    host::trace::parser parser;
+    std::vector<host::trace::dump> dumps;
+    parser.feed(stream, [&dumps](const host::trace::dump& item) { dumps.push_back(item); });
+    ASSERT_EQ(dumps.size(), 1u);
+    EXPECT_EQ(dumps[0].number, 9);
+    EXPECT_EQ(dumps[0].events.size(), 25u);
+    EXPECT_EQ(parser.stats().crc_errors, 1u);
+}
+
+TEST(TraceTest, test_incomplete_dump)
+{
+    const auto ring = sample_ring();
+    std::vector<std::vector<uint8_t>> chunks;
+    for (uint8_t number = 0; number < 2; ++number) {
+        core::trace::dump_binary(number, ring, [&chunks](core::span<const uint8_t> chunk) {
+            chunks.emplace_back(chunk.begin(), chunk.end());
+        });
+    }
+    host::trace::parser parser;
+    std::vector<host::trace::dump> dumps;
+    const auto collect = [&dumps](const host::trace::dump& item) { dumps.push_back(item); };
+    // Second chunk of dump 0 lost
+    for (const size_t i : { 0, 2, 3 }) {
+        parser.feed({ chunks[i].data(), chunks[i].size() }, collect);
+    }
+    ASSERT_EQ(dumps.size(), 1u);
+    EXPECT_EQ(dumps[0].number, 1);
+    EXPECT_EQ(parser.stats().incomplete, 1u);
+}
+
+TEST(TraceTest, test_analysis)
+{
+    const core::trace::event raw[] = {
+        { tag(kind::begin, 0), 0 }, // adc isr
+        { tag(kind::end, 0), 100 },
+        { tag(kind::begin, 0), 150 },
+        { tag(kind::end, 0), 260 },
+        { tag(kind::begin, 1), 300 }, // uart isr
+        { tag(kind::instant, 2), 340 }, // idle
+        { tag(kind::end, 1), 350 },
+        { tag(kind::end, 0), 400 }, // unmatched
+        { tag(kind::instant, 2), 500 }, // idle without a new conversion
+    };
+    const auto events = host::trace::unwrap(raw);
+
+    EXPECT_EQ(host::trace::durations(events, 0), (std::vector<uint64_t> { 100, 110 }));
+    EXPECT_EQ(host::trace::durations(events, 1), (std::vector<uint64_t> { 50 }));
+    EXPECT_EQ(host::trace::latencies(events, 0, 2), (std::vector<uint64_t> { 190 }));
+
+    const auto stats = host::trace::summarize({ 5, 1, 3, 2, 4 });
+    EXPECT_EQ(stats.count, 5u);
+    EXPECT_EQ(stats.min, 1u);
+    EXPECT_EQ(stats.p50, 3u);
+    EXPECT_EQ(stats.max, 5u);
+    EXPECT_DOUBLE_EQ(stats.mean, 3.0);
+    EXPECT_EQ(host::trace::summarize({}).count, 0u);
+
+    const auto text = host::trace::histogram({ 0, 100, 110, 120 }, 16.0);
+    EXPECT_NE(text.find("[       0,        1)"), std::string::npos);
+    EXPECT_NE(text.find("[      64,      128)"), std::string::npos);
+
+    const auto json = host::trace::chrome_json({ { 0, events } }, { "adc_isr", "uart_isr" }, 16.0);
+    EXPECT_NE(json.find("{\"name\":\"adc_isr\",\"ph\":\"B\",\"ts\":0.0000"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"id2\",\"ph\":\"i\",\"s\":\"t\",\"ts\":21.2500"), std::string::npos);
+    EXPECT_EQ(json.back(), '\n');
+}
+
+auto main(int argc, char** argv) -> int
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
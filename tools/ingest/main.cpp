@@ -0,0 +1,455 @@
+#include <capture.hpp>
+#include <ingest.hpp>
+#include <link_test.hpp>
+#include <serial.hpp>
+
+#include <fmt.hpp>
+#include <frame.hpp>
+#include <utils/adc_converter.hpp>
+#include <utils/uart_link.hpp>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+// Host ingest tool for the firmware serial stream.
+//
+//   ingest record <device> <capture> [--format auto|csv|binary] [--capacity samples] [--baud rate]
+//   ingest synth <device> [--format csv|binary|linktest] [--encoding raw16|packed10|delta]
+//                         [--samples n] [--channels n] [--rate samples_per_second] [--baud rate]
+//   ingest linktest <device> [--baud rate] [--seconds n]
+//   ingest dump <capture> [--samples n]
+//
+// record reads the device with large non-blocking reads and decodes straight into a preallocated,
+// memory-mapped capture file (see lib/host/capture.hpp) until SIGINT/SIGTERM, end of stream or a full
+// capture. synth writes a synthetic stream in the firmware formats, e.g. into one end of the socat pty
+// pair of `make monitor-virtual-serial` while record listens on the other. linktest checks the stream of
+// the UART_SELFTEST firmware (see lib/host/link_test.hpp) and reports sustained throughput and errors
+// every second, then in total.
+
+namespace {
+
+constexpr std::size_t READ_SIZE = 64 * 1024;
+
+volatile std::sig_atomic_t stop_requested = 0;
+
+void on_signal(int)
+{
+    stop_requested = 1;
+}
+
+core::uint64_t now_ns()
+{
+    timespec now {};
+    ::clock_gettime(CLOCK_REALTIME, &now);
+    return static_cast<core::uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<core::uint64_t>(now.tv_nsec);
+}
+
+/// @brief Value of --name in argv, fallback if absent
+const char* option(int argc, char** argv, const char* name, const char* fallback)
+{
+    for (int i = 0; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+int usage()
+{
+    std::fputs("usage:\n"
+               "  ingest record <device> <capture> [--format auto|csv|binary] [--capacity samples] [--baud rate]\n"
+               "  ingest synth <device> [--format csv|binary|linktest] [--encoding raw16|packed10|delta]\n"
+               "                        [--samples n] [--channels n] [--rate samples_per_second] [--baud rate]\n"
+               "  ingest linktest <device> [--baud rate] [--seconds n]\n"
+               "  ingest dump <capture> [--samples n]\n",
+        stderr);
+    return 2;
+}
+
+void print_stats(const host::ingest::session& session, const host::capture::writer& capture)
+{
+    const auto& frames = session.frame_stats();
+    const auto& lines = session.csv_stats();
+    std::fprintf(stderr,
+        "bytes=%llu samples=%llu frames=%llu dropped_frames=%llu crc_errors=%llu framing_errors=%llu "
+        "csv_lines=%llu csv_skipped=%llu capture_full_drops=%llu\n",
+        static_cast<unsigned long long>(session.bytes()), static_cast<unsigned long long>(capture.count()),
+        static_cast<unsigned long long>(frames.frames), static_cast<unsigned long long>(frames.dropped_frames),
+        static_cast<unsigned long long>(frames.crc_errors), static_cast<unsigned long long>(frames.framing_errors),
+        static_cast<unsigned long long>(lines.lines), static_cast<unsigned long long>(lines.skipped),
+        static_cast<unsigned long long>(capture.dropped()));
+}
+
+int record(int argc, char** argv)
+{
+    if (argc < 4) {
+        return usage();
+    }
+    const char* device = argv[2];
+    const char* path = argv[3];
+    const char* format_name = option(argc, argv, "--format", "auto");
+    const auto capacity = std::strtoull(option(argc, argv, "--capacity", "16777216"), nullptr, 10);
+    const auto baud = static_cast<core::uint32_t>(std::strtoul(option(argc, argv, "--baud", "9600"), nullptr, 10));
+
+    auto mode = host::ingest::format::automatic;
+    if (std::strcmp(format_name, "csv") == 0) {
+        mode = host::ingest::format::csv;
+    } else if (std::strcmp(format_name, "binary") == 0) {
+        mode = host::ingest::format::binary;
+    } else if (std::strcmp(format_name, "auto") != 0) {
+        return usage();
+    }
+
+    const int fd = host::serial::open(device, baud);
+    if (fd < 0) {
+        std::fprintf(stderr, "ingest: %s: %s\n", device, std::strerror(errno));
+        return 1;
+    }
+    // One index entry per 8 samples covers frames down to that size, CSV batches are far larger
+    static host::capture::writer capture;
+    if (!capture.open(path, capacity, capacity / 8 + 1, now_ns())) {
+        std::fprintf(stderr, "ingest: %s: %s\n", path, capture.error());
+        ::close(fd);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    host::ingest::session session(capture, mode);
+    static core::uint8_t buffer[READ_SIZE];
+    core::uint64_t last_report = now_ns();
+    bool end_of_stream = false;
+    while (!stop_requested && !end_of_stream && !capture.full()) {
+        pollfd ready { fd, POLLIN, 0 };
+        const int events = ::poll(&ready, 1, 200);
+        if (events < 0 && errno != EINTR) {
+            std::perror("ingest: poll");
+            break;
+        }
+        // Drain everything available before polling again
+        for (;;) {
+            const ssize_t size = ::read(fd, buffer, sizeof(buffer));
+            if (size > 0) {
+                session.feed(core::span<const core::uint8_t>(buffer, static_cast<core::size_t>(size)), now_ns());
+                continue;
+            }
+            if (size == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                end_of_stream = true; // EOF of a file/FIFO, EIO of a hung-up pty
+            }
+            break;
+        }
+
+        const core::uint64_t now = now_ns();
+        if (now - last_report >= 1000000000ULL) {
+            last_report = now;
+            print_stats(session, capture);
+        }
+    }
+
+    print_stats(session, capture);
+    if (capture.full()) {
+        std::fputs("ingest: capture full\n", stderr);
+    }
+    capture.close();
+    ::close(fd);
+    return 0;
+}
+
+/// @brief Write the firmware self-test stream of a 16 MHz board at baud: its "link,..." line, then frames
+int synth_link_test(int fd, core::uint32_t baud, core::uint64_t samples, core::uint64_t rate)
+{
+    char text[64];
+    core::fmt::writer header(text);
+    core::uart::format(header, core::uart::best_setting(16000000, baud)).append("\r\n");
+    const auto line = header.written();
+    bool ok = host::serial::write_all(fd, { reinterpret_cast<const core::uint8_t*>(line.data()), line.size() });
+
+    core::uint8_t sequence = 0;
+    core::uint64_t sent = 0;
+    const core::uint64_t start = now_ns();
+    while (ok && sent < samples && !stop_requested) {
+        core::uint8_t wire[core::uart::selftest::frame_size];
+        ok = host::serial::write_all(fd, core::uart::selftest::encode(sequence++, wire));
+        sent += core::uart::selftest::frame_samples;
+        if (rate > 0) {
+            const core::uint64_t due = start + sent * 1000000000ULL / rate;
+            const core::uint64_t now = now_ns();
+            if (due > now) {
+                const timespec pause { static_cast<time_t>((due - now) / 1000000000ULL),
+                    static_cast<long>((due - now) % 1000000000ULL) };
+                ::nanosleep(&pause, nullptr);
+            }
+        }
+    }
+    if (!ok) {
+        std::fprintf(stderr, "ingest: write: %s\n", std::strerror(errno));
+        return 1;
+    }
+    std::fprintf(stderr, "sent=%llu\n", static_cast<unsigned long long>(sent));
+    return 0;
+}
+
+void print_link_test(const char* label, const host::link_test::statistics& stats, core::uint32_t baud)
+{
+    const double rate = stats.bytes_per_second();
+    // 8N1 carries a byte in 10 bits
+    const double capacity = baud > 0 ? rate * 10 * 100 / baud : 0;
+    std::fprintf(stderr,
+        "%s bytes=%llu bytes_per_second=%.0f line_usage=%.1f%% frames=%llu pattern_errors=%llu crc_errors=%llu "
+        "framing_errors=%llu dropped_frames=%llu error_rate=%.2e\n",
+        label, static_cast<unsigned long long>(stats.bytes), rate, capacity,
+        static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.pattern_errors),
+        static_cast<unsigned long long>(stats.crc_errors), static_cast<unsigned long long>(stats.framing_errors),
+        static_cast<unsigned long long>(stats.dropped_frames), stats.error_rate());
+}
+
+int link_test(int argc, char** argv)
+{
+    if (argc < 3) {
+        return usage();
+    }
+    const char* device = argv[2];
+    const auto baud = static_cast<core::uint32_t>(std::strtoul(option(argc, argv, "--baud", "500000"), nullptr, 10));
+    const auto seconds = std::strtoull(option(argc, argv, "--seconds", "10"), nullptr, 10);
+
+    const int fd = host::serial::open(device, baud);
+    if (fd < 0) {
+        std::fprintf(stderr, "ingest: %s: %s\n", device, std::strerror(errno));
+        return 1;
+    }
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    host::link_test::checker checker;
+    static core::uint8_t buffer[READ_SIZE];
+    const core::uint64_t start = now_ns();
+    core::uint64_t last_report = start;
+    host::link_test::statistics previous {};
+    bool end_of_stream = false;
+    bool header_shown = false;
+    while (!stop_requested && !end_of_stream && (seconds == 0 || now_ns() - start < seconds * 1000000000ULL)) {
+        pollfd ready { fd, POLLIN, 0 };
+        if (::poll(&ready, 1, 200) < 0 && errno != EINTR) {
+            std::perror("ingest: poll");
+            break;
+        }
+        for (;;) {
+            const ssize_t size = ::read(fd, buffer, sizeof(buffer));
+            if (size > 0) {
+                checker.feed(core::span<const core::uint8_t>(buffer, static_cast<core::size_t>(size)), now_ns());
+                continue;
+            }
+            if (size == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                end_of_stream = true;
+            }
+            break;
+        }
+        if (!header_shown && !checker.header().empty()) {
+            header_shown = true;
+            std::fprintf(stderr, "%s\n", checker.header().c_str());
+        }
+
+        const core::uint64_t now = now_ns();
+        if (now - last_report >= 1000000000ULL) {
+            last_report = now;
+            // The last second alone: differences against the previous report
+            const auto total = checker.stats();
+            auto second = total;
+            second.bytes -= previous.bytes;
+            second.frames -= previous.frames;
+            second.pattern_errors -= previous.pattern_errors;
+            second.crc_errors -= previous.crc_errors;
+            second.framing_errors -= previous.framing_errors;
+            second.dropped_frames -= previous.dropped_frames;
+            second.first_ns = previous.last_ns > 0 ? previous.last_ns : total.first_ns;
+            print_link_test("second", second, baud);
+            previous = total;
+        }
+    }
+
+    const auto total = checker.stats();
+    print_link_test("total", total, baud);
+    ::close(fd);
+    if (total.frames == 0) {
+        std::fputs("ingest: no self-test frames received\n", stderr);
+        return 1;
+    }
+    return 0;
+}
+
+int synth(int argc, char** argv)
+{
+    if (argc < 3) {
+        return usage();
+    }
+    const char* device = argv[2];
+    const char* format_name = option(argc, argv, "--format", "csv");
+    const bool binary = std::strcmp(format_name, "binary") == 0;
+    const bool link_test = std::strcmp(format_name, "linktest") == 0;
+    const char* encoding_name = option(argc, argv, "--encoding", "raw16");
+    const auto samples = std::strtoull(option(argc, argv, "--samples", "10000"), nullptr, 10);
+    const auto channels = static_cast<core::uint8_t>(std::strtoul(option(argc, argv, "--channels", "2"), nullptr, 10));
+    const auto rate = std::strtoull(option(argc, argv, "--rate", "0"), nullptr, 10);
+    const auto baud = static_cast<core::uint32_t>(std::strtoul(option(argc, argv, "--baud", "9600"), nullptr, 10));
+    if (channels == 0 || channels > core::frame::max_channel + 1) {
+        return usage();
+    }
+
+    auto encoding = core::frame::encoding::raw16;
+    if (std::strcmp(encoding_name, "packed10") == 0) {
+        encoding = core::frame::encoding::packed10;
+    } else if (std::strcmp(encoding_name, "delta") == 0) {
+        encoding = core::frame::encoding::delta;
+    }
+
+    const int fd = host::serial::open(device, baud, true);
+    if (fd < 0) {
+        std::fprintf(stderr, "ingest: %s: %s\n", device, std::strerror(errno));
+        return 1;
+    }
+    if (link_test) {
+        const int result = synth_link_test(fd, baud, samples, rate);
+        ::close(fd);
+        return result;
+    }
+
+    // Triangle waves of different slopes per channel, sent in batches of 16 samples per channel
+    constexpr core::uint8_t batch = 16;
+    core::uint8_t sequence = 0;
+    core::uint64_t sent = 0;
+    core::uint64_t time[core::frame::max_channel + 1] {};
+    const core::uint64_t start = now_ns();
+    while (sent < samples && !stop_requested) {
+        for (core::uint8_t channel = 0; channel < channels && sent < samples; ++channel) {
+            core::uint16_t values[batch];
+            core::uint8_t count = 0;
+            for (; count < batch && sent + count < samples; ++count) {
+                const core::uint64_t phase = (time[channel]++ * (channel + 1)) % 2046;
+                values[count] = static_cast<core::uint16_t>(phase < 1023 ? phase : 2046 - phase);
+            }
+
+            bool ok = true;
+            if (binary) {
+                core::uint8_t wire[core::frame::max_frame_size(batch, core::frame::encoding::delta)];
+                const auto frame = core::frame::encode(sequence++, channel, { values, count }, wire, encoding);
+                ok = host::serial::write_all(fd, frame);
+            } else {
+                char text[batch * 24];
+                core::fmt::writer out(text);
+                for (core::uint8_t i = 0; i < count; ++i) {
+                    out.append_uint(channel)
+                        .append(", ")
+                        .append_uint(values[i])
+                        .append(", ")
+                        .append_uint(core::adc::converter<10, 5000>::to_mv(values[i]))
+                        .append("\r\n");
+                }
+                const auto written = out.written();
+                ok = host::serial::write_all(
+                    fd, { reinterpret_cast<const core::uint8_t*>(written.data()), written.size() });
+            }
+            if (!ok) {
+                std::fprintf(stderr, "ingest: write: %s\n", std::strerror(errno));
+                ::close(fd);
+                return 1;
+            }
+            sent += count;
+        }
+
+        if (rate > 0) {
+            const core::uint64_t due = start + sent * 1000000000ULL / rate;
+            const core::uint64_t now = now_ns();
+            if (due > now) {
+                const timespec pause { static_cast<time_t>((due - now) / 1000000000ULL),
+                    static_cast<long>((due - now) % 1000000000ULL) };
+                ::nanosleep(&pause, nullptr);
+            }
+        }
+    }
+
+    std::fprintf(stderr, "sent=%llu\n", static_cast<unsigned long long>(sent));
+    ::close(fd);
+    return 0;
+}
+
+int dump(int argc, char** argv)
+{
+    if (argc < 3) {
+        return usage();
+    }
+    host::capture::reader capture;
+    if (!capture.open(argv[2])) {
+        std::fprintf(stderr, "ingest: %s: not a capture file\n", argv[2]);
+        return 1;
+    }
+    const auto limit = std::strtoull(option(argc, argv, "--samples", "0"), nullptr, 10);
+
+    const auto& info = capture.info();
+    const auto values = capture.values();
+    const auto channels = capture.channels();
+    const auto index = capture.index();
+    std::printf("capacity=%llu samples=%llu index=%llu/%llu\n", static_cast<unsigned long long>(info.capacity),
+        static_cast<unsigned long long>(values.size()), static_cast<unsigned long long>(index.size()),
+        static_cast<unsigned long long>(info.index_capacity));
+    if (!index.empty()) {
+        const double seconds = static_cast<double>(index.back().host_time_ns - index.front().host_time_ns) / 1e9;
+        std::printf("span=%.3fs\n", seconds);
+    }
+
+    struct summary {
+        core::uint64_t count;
+        core::uint16_t min;
+        core::uint16_t max;
+        core::uint64_t total;
+    } per_channel[256] {};
+    for (core::size_t i = 0; i < values.size(); ++i) {
+        auto& channel = per_channel[channels[i]];
+        channel.min = channel.count == 0 || values[i] < channel.min ? values[i] : channel.min;
+        channel.max = channel.count == 0 || values[i] > channel.max ? values[i] : channel.max;
+        channel.total += values[i];
+        ++channel.count;
+    }
+    std::printf("channel,count,min,mean,max\n");
+    for (unsigned channel = 0; channel < 256; ++channel) {
+        const auto& stats = per_channel[channel];
+        if (stats.count > 0) {
+            std::printf("%u,%llu,%u,%llu,%u\n", channel, static_cast<unsigned long long>(stats.count), stats.min,
+                static_cast<unsigned long long>(stats.total / stats.count), stats.max);
+        }
+    }
+
+    for (core::size_t i = 0; i < values.size() && i < limit; ++i) {
+        std::printf("%u, %u\n", channels[i], values[i]);
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        return usage();
+    }
+    if (std::strcmp(argv[1], "record") == 0) {
+        return record(argc, argv);
+    }
+    if (std::strcmp(argv[1], "synth") == 0) {
+        return synth(argc, argv);
+    }
+    if (std::strcmp(argv[1], "linktest") == 0) {
+        return link_test(argc, argv);
+    }
+    if (std::strcmp(argv[1], "dump") == 0) {
+        return dump(argc, argv);
+    }
+    return usage();
+}
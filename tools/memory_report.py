@@ -0,0 +1,104 @@
+"""
+PlatformIO post-build script: per-symbol RAM/flash report of the firmware ELF
+
+Runs after every link of an AVR environment (see `extra_scripts` in platformio.ini) and writes
+`.pio/build/<env>/memory_report.txt`:
+
+- Totals of .text/.data/.bss against the board limits, with the RAM left for heap and stack
+- Every RAM symbol (.data/.bss), largest first, so buffers can be sized against what is left
+- The largest flash symbols
+
+A short summary with the largest RAM symbols is printed to the build log. `make memory-report` builds all
+atmega328p_* environments and collects their reports in .memory/.
+"""
+
+import os
+import subprocess
+
+Import("env")  # noqa: F821 - injected by SCons
+
+# avr-gcc ELF address spaces: flash from 0, SRAM mirrored at 0x800000, EEPROM at 0x810000
+RAM_OFFSET = 0x800000
+EEPROM_OFFSET = 0x810000
+FLASH_TOP = 40
+SUMMARY_TOP = 10
+
+
+def _tool(name):
+    """Binutils tool next to the compiler, e.g. avr-gcc -> avr-nm"""
+    compiler = env.subst("$CC")  # noqa: F821
+    return compiler[: -len("gcc")] + name if compiler.endswith("gcc") else name
+
+
+def _run(args):
+    return subprocess.run(args, check=True, capture_output=True, text=True, env=env["ENV"]).stdout  # noqa: F821
+
+
+def _sections(elf):
+    """Sizes of the allocated sections, from `size -A`"""
+    sizes = {}
+    for line in _run([_tool("size"), "-A", elf]).splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0].startswith(".") and fields[1].isdigit():
+            sizes[fields[0]] = int(fields[1])
+    return sizes
+
+
+def _symbols(elf):
+    """(size, kind, section, name) of every sized symbol, kind is 'ram' or 'flash' (code and PROGMEM)"""
+    symbols = []
+    output = _run([_tool("nm"), "--print-size", "--size-sort", "--demangle", "--radix=d", elf])
+    for line in output.splitlines():
+        fields = line.split(maxsplit=3)
+        if len(fields) != 4:
+            continue
+        address, size, kind, name = int(fields[0]), int(fields[1]), fields[2], fields[3]
+        if address >= EEPROM_OFFSET:
+            continue
+        if address >= RAM_OFFSET:
+            section = ".bss" if kind in "bB" else ".data"
+            symbols.append((size, "ram", section, name))
+        else:
+            symbols.append((size, "flash", ".text", name))
+    symbols.sort(key=lambda symbol: (-symbol[0], symbol[3]))
+    return symbols
+
+
+def _table(symbols):
+    lines = ["  size  section   symbol"]
+    lines += ["%6d  %-8s  %s" % (size, section, name) for size, _, section, name in symbols]
+    return lines
+
+
+def memory_report(source, target, env):
+    elf = str(source[0])
+    board = env.BoardConfig()
+    max_ram = int(board.get("upload.maximum_ram_size", 0))
+    max_flash = int(board.get("upload.maximum_size", 0))
+
+    sections = _sections(elf)
+    data, bss, text = sections.get(".data", 0), sections.get(".bss", 0), sections.get(".text", 0)
+    symbols = _symbols(elf)
+    ram = [symbol for symbol in symbols if symbol[1] == "ram"]
+    flash = [symbol for symbol in symbols if symbol[1] == "flash"]
+
+    totals = [
+        "RAM   %5d / %d bytes (.data %d + .bss %d), %d left for heap and stack"
+        % (data + bss, max_ram, data, bss, max_ram - data - bss),
+        "Flash %5d / %d bytes (.text %d + .data %d)" % (text + data, max_flash, text, data),
+    ]
+    lines = ["Memory report: %s" % env.subst("$PIOENV"), ""] + totals
+    lines += ["", "RAM symbols (%d bytes in %d symbols)" % (sum(s[0] for s in ram), len(ram))] + _table(ram)
+    lines += ["", "Largest flash symbols (top %d of %d)" % (FLASH_TOP, len(flash))] + _table(flash[:FLASH_TOP])
+
+    path = os.path.join(env.subst("$BUILD_DIR"), "memory_report.txt")
+    with open(path, "w") as report:
+        report.write("\n".join(lines) + "\n")
+
+    print("\n".join(totals))
+    print("Largest RAM symbols:")
+    print("\n".join(_table(ram[:SUMMARY_TOP])))
+    print("Full report: %s" % path)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", memory_report)  # noqa: F821
@@ -0,0 +1,378 @@
+#include <csv.hpp>
+#include <replay.hpp>
+
+#include "firmware_config.hpp"
+
+#include <frame.hpp>
+#include <utils/output.hpp>
+#include <utils/trigger.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+
+// Native replay of the firmware pipeline.
+//
+//   replay [trace.cap|trace.csv] [--samples 10000000] [--binary] [--encoding raw16|packed10|delta]
+//          [--capture] [--period 2] [--baud 9600]
+//          [--wave square|sine|triangle|sawtooth] [--frequency 1000] [--duty 0.95] [--cutoff 0] [--noise 0]
+//
+// Feeds a recording (a capture file from the ingest tool or a CSV log of the firmware) or a synthetic
+// WaveGen signal, by default the one of sim/02-EDO-system.sim1, through the firmware pipeline with the
+// firmware configuration (include/firmware_config.hpp), as fast as the host runs it: the scan sequencer, the
+// output stage (core::output) and the transmit queue with its overflow policy, drained at the line rate of
+// --baud (0 for a link that never fills up). The output is decoded and checked against the trace, samples of
+// records the queue dropped included; the exit status is 1 if any sample was corrupted or went missing
+// otherwise.
+
+namespace {
+
+using replay_link = host::replay::link<UART_QUEUE_BYTES, UART_QUEUE_RECORDS>;
+
+struct options {
+    core::uint64_t samples;
+    core::uint32_t period_ms; //< Period of the transmit task
+    core::uint32_t baud; //< Line rate of the virtual UART, 0 for unlimited
+    bool capture;
+};
+
+/// Wall time split between the firmware code and the verification
+struct timing {
+    using clock = std::chrono::steady_clock;
+
+    double total {};
+    double verify {};
+    clock::time_point start = clock::now();
+
+    template <class Function>
+    void verifying(Function&& function)
+    {
+        const auto begin = clock::now();
+        function();
+        verify += std::chrono::duration<double>(clock::now() - begin).count();
+    }
+
+    void stop() { total = std::chrono::duration<double>(clock::now() - start).count(); }
+};
+
+const char* option(int argc, char** argv, const char* name, const char* fallback)
+{
+    for (int i = 0; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+bool flag(int argc, char** argv, const char* name)
+{
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Decoder of the link bytes, whichever the output mode
+template <core::output::mode Mode>
+struct decoder {
+    core::frame::decoder<> frames;
+    host::csv::parser lines;
+
+    template <class Callback>
+    void feed(core::span<const core::uint8_t> bytes, Callback&& on_sample)
+    {
+        if constexpr (Mode == core::output::mode::binary) {
+            frames.feed(bytes, [&on_sample](const core::frame::packet& packet) {
+                for (const auto sample : packet.samples) {
+                    on_sample(packet.channel, sample);
+                }
+            });
+        } else {
+            lines.feed(bytes, on_sample);
+        }
+    }
+
+    /// @brief Corrupted frames, sequence gaps are frames the transmit queue dropped
+    core::uint64_t errors() const
+    {
+        const auto& stats = frames.stats();
+        return stats.crc_errors + stats.framing_errors;
+    }
+};
+
+void report(const char* what, const options& config, core::uint64_t samples, core::uint64_t conversions,
+    const timing& time, const replay_link& link)
+{
+    const double adc_seconds = static_cast<double>(conversions) / host::replay::conversion_rate_hz;
+    const double pipeline = time.total - time.verify;
+    std::printf("replay: %s, %llu samples, %.1f s of ADC time\n", what, static_cast<unsigned long long>(samples),
+        adc_seconds);
+    std::printf("pipeline: %.3f s, %.2f Msamples/s, %.0fx real time (verification %.3f s more)\n", pipeline,
+        static_cast<double>(samples) / pipeline / 1e6, adc_seconds / pipeline, time.verify);
+    const auto& queue = link.stats();
+    std::printf("output: %llu records, %u queued, %u dropped, %u decimated, %llu bytes on the wire",
+        static_cast<unsigned long long>(link.records()), queue.accepted, queue.dropped, queue.decimated,
+        static_cast<unsigned long long>(link.bytes()));
+    if (config.baud > 0) {
+        std::printf(" at %u baud (%.0f %% of the ADC time)", config.baud,
+            100 * static_cast<double>(link.bytes()) * 10 / config.baud / adc_seconds);
+    }
+    std::printf("\n");
+}
+
+/// @brief Scan the sensor channels and stream every sample, as the firmware does by default
+template <core::output::mode Mode, core::frame::encoding Encoding>
+int stream(const options& config, const host::replay::trace& source)
+{
+    host::replay::scanner<SAMPLE_BUFFER_SLOTS, SENSOR_CHANNEL_COUNT> scanner(SENSOR_CHANNELS, source);
+    replay_link link(config.baud, UART_OVERFLOW_POLICY);
+    host::replay::verifier verifier(source);
+    core::output::stage<Mode, FRAME_MAX_SAMPLES, Encoding> output;
+    decoder<Mode> link_decoder;
+    decoder<Mode> lost_decoder;
+
+    const auto check = [&verifier](core::uint8_t channel, core::uint16_t raw) { verifier.check(channel, raw); };
+    const auto check_lost = [&verifier](core::uint8_t channel, core::uint16_t raw) { verifier.lost(channel, raw); };
+    const auto verify = [&] {
+        link.deliver([&](host::replay::record_fate fate, core::span<const core::uint8_t> record) {
+            if (fate == host::replay::record_fate::sent) {
+                link_decoder.feed(record, check);
+            } else {
+                lost_decoder.feed(record, check_lost);
+            }
+        });
+    };
+    const auto transmit = [&] {
+        while (scanner.available() != 0) {
+            output.send_next(scanner, link);
+        }
+    };
+
+    timing time;
+    scanner.start();
+    for (core::uint64_t tick = 1; scanner.samples() < config.samples; ++tick) {
+        // One 1 ms scheduler tick worth of conversions, then the transmit task when due
+        const auto until = static_cast<core::uint64_t>(tick * host::replay::conversion_rate_hz / 1000);
+        while (scanner.conversions() < until && scanner.samples() < config.samples) {
+            scanner.convert();
+        }
+        if (tick % config.period_ms == 0) {
+            transmit();
+        }
+        link.advance(1e-3);
+        time.verifying(verify);
+    }
+    transmit();
+    link.flush();
+    time.verifying(verify);
+    time.stop();
+
+    const char* what = Mode == core::output::mode::csv ? "csv"
+        : Encoding == core::frame::encoding::packed10  ? "binary packed10"
+        : Encoding == core::frame::encoding::delta     ? "binary delta"
+                                                       : "binary raw16";
+    report(what, config, scanner.samples(), scanner.conversions(), time, link);
+
+    const auto& checked = verifier.stats();
+    std::printf("verify: %llu samples decoded, %llu lost to the transmit queue, %llu mismatches, %llu overruns, "
+                "%llu link errors\n",
+        static_cast<unsigned long long>(checked.samples), static_cast<unsigned long long>(checked.lost),
+        static_cast<unsigned long long>(checked.mismatches), static_cast<unsigned long long>(scanner.overruns()),
+        static_cast<unsigned long long>(link_decoder.errors()));
+    if (checked.mismatches > 0) {
+        std::printf("first mismatch at sample %llu\n", static_cast<unsigned long long>(checked.first_mismatch));
+    }
+    const bool complete = checked.samples + checked.lost == scanner.samples();
+    return complete && checked.mismatches == 0 && link_decoder.errors() == 0 ? 0 : 1;
+}
+
+/// @brief Free-run the capture channel into the trigger engine and send the windows, as -D CAPTURE_TRIGGER
+template <core::output::mode Mode, core::frame::encoding Encoding>
+int capture(const options& config, const host::replay::trace& source)
+{
+    const auto samples = source.channel(CAPTURE_CHANNEL);
+    if (samples.empty()) {
+        std::fprintf(stderr, "replay: no samples on capture channel %u\n", CAPTURE_CHANNEL);
+        return 1;
+    }
+
+    core::trigger::capture<CAPTURE_CAPACITY> engine;
+    replay_link link(config.baud, UART_OVERFLOW_POLICY);
+    core::output::stage<Mode, FRAME_MAX_SAMPLES, Encoding> output;
+    decoder<Mode> link_decoder;
+    decoder<Mode> lost_decoder;
+    engine.arm(CAPTURE_SETTINGS);
+
+    // Windows as read from the engine, compared with the decoded output
+    std::deque<core::uint16_t> expected;
+    core::uint64_t windows = 0;
+    core::uint64_t decoded = 0;
+    core::uint64_t lost = 0;
+    core::uint64_t mismatches = 0;
+    core::uint64_t misplaced_triggers = 0;
+    const auto expect = [&](core::uint8_t channel, core::uint16_t raw) {
+        if (expected.empty() || channel != CAPTURE_CHANNEL || expected.front() != raw) {
+            ++mismatches;
+        }
+        if (!expected.empty()) {
+            expected.pop_front();
+        }
+    };
+    const auto check = [&](core::uint8_t channel, core::uint16_t raw) {
+        ++decoded;
+        expect(channel, raw);
+    };
+    const auto check_lost = [&](core::uint8_t channel, core::uint16_t raw) {
+        ++lost;
+        expect(channel, raw);
+    };
+    // The output stage sends a rejected record again, only records dropped once queued are lost
+    const auto verify = [&] {
+        link.deliver([&](host::replay::record_fate fate, core::span<const core::uint8_t> record) {
+            if (fate == host::replay::record_fate::sent) {
+                link_decoder.feed(record, check);
+            } else if (fate == host::replay::record_fate::evicted) {
+                lost_decoder.feed(record, check_lost);
+            }
+        });
+    };
+    bool recorded = false; // Window in progress already added to expected
+    const auto transmit = [&] {
+        if (!engine.ready()) {
+            return;
+        }
+        if (!recorded) {
+            ++windows;
+            for (core::uint16_t i = 0; i < engine.size(); ++i) {
+                expected.push_back(engine[i]);
+            }
+            if (engine[engine.trigger_index()] < CAPTURE_SETTINGS.when.level) {
+                ++misplaced_triggers;
+            }
+            recorded = true;
+        }
+        recorded = !output.send_capture(engine, link, CAPTURE_CHANNEL);
+    };
+
+    timing time;
+    core::size_t cursor = 0;
+    core::uint64_t conversions = 0;
+    for (core::uint64_t tick = 1; conversions < config.samples; ++tick) {
+        const auto until = static_cast<core::uint64_t>(tick * host::replay::conversion_rate_hz / 1000);
+        while (conversions < until && conversions < config.samples) {
+            engine.on_sample(samples[cursor]);
+            if (++cursor == samples.size()) {
+                cursor = 0;
+            }
+            ++conversions;
+        }
+        if (tick % config.period_ms == 0) {
+            transmit();
+        }
+        link.advance(1e-3);
+        time.verifying(verify);
+    }
+    // Let the window being sent out
+    while (engine.ready()) {
+        transmit();
+        link.flush();
+    }
+    time.verifying(verify);
+    time.stop();
+
+    report(Mode == core::output::mode::csv ? "capture csv" : "capture binary", config, conversions, conversions,
+        time, link);
+    std::printf("verify: %llu windows, %llu samples decoded, %llu lost to the transmit queue, %llu mismatches, "
+                "%llu misplaced triggers, %llu link errors\n",
+        static_cast<unsigned long long>(windows), static_cast<unsigned long long>(decoded),
+        static_cast<unsigned long long>(lost), static_cast<unsigned long long>(mismatches),
+        static_cast<unsigned long long>(misplaced_triggers), static_cast<unsigned long long>(link_decoder.errors()));
+    return expected.empty() && mismatches == 0 && misplaced_triggers == 0 && link_decoder.errors() == 0 ? 0 : 1;
+}
+
+template <core::output::mode Mode, core::frame::encoding Encoding>
+int run(const options& config, const host::replay::trace& source)
+{
+    return config.capture ? capture<Mode, Encoding>(config, source) : stream<Mode, Encoding>(config, source);
+}
+
+int usage()
+{
+    std::fputs("usage: replay [trace.cap|trace.csv] [--samples 10000000] [--binary] [--encoding raw16|packed10|delta]\n"
+               "              [--capture] [--period 2] [--baud 9600]\n"
+               "              [--wave square|sine|triangle|sawtooth] [--frequency 1000] [--duty 0.95] [--cutoff 0]\n"
+               "              [--noise 0]\n",
+        stderr);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    options config {};
+    config.samples = std::strtoull(option(argc, argv, "--samples", "10000000"), nullptr, 10);
+    config.period_ms = TRANSMIT_PERIOD_MS;
+    config.baud = LINK_BAUD;
+    if (const char* period = option(argc, argv, "--period", nullptr)) {
+        config.period_ms = static_cast<core::uint32_t>(std::strtoul(period, nullptr, 10));
+    }
+    if (const char* baud = option(argc, argv, "--baud", nullptr)) {
+        config.baud = static_cast<core::uint32_t>(std::strtoul(baud, nullptr, 10));
+    }
+    config.capture = flag(argc, argv, "--capture");
+    if (config.samples == 0 || config.period_ms == 0) {
+        return usage();
+    }
+
+    host::replay::trace source;
+    if (argc > 1 && argv[1][0] != '-') {
+        if (!source.load(argv[1])) {
+            std::fprintf(stderr, "replay: %s: no samples\n", argv[1]);
+            return 1;
+        }
+    } else {
+        host::replay::wavegen wave = host::replay::edo_system;
+        const char* shape = option(argc, argv, "--wave", "square");
+        if (std::strcmp(shape, "sine") == 0) {
+            wave.type = host::replay::shape::sine;
+        } else if (std::strcmp(shape, "triangle") == 0) {
+            wave.type = host::replay::shape::triangle;
+        } else if (std::strcmp(shape, "sawtooth") == 0) {
+            wave.type = host::replay::shape::sawtooth;
+        } else if (std::strcmp(shape, "square") != 0) {
+            return usage();
+        }
+        wave.frequency_hz = std::strtod(option(argc, argv, "--frequency", "1000"), nullptr);
+        wave.duty = std::strtod(option(argc, argv, "--duty", "0.95"), nullptr);
+        wave.cutoff_hz = std::strtod(option(argc, argv, "--cutoff", "0"), nullptr);
+        wave.noise_lsb = static_cast<core::uint16_t>(std::strtoul(option(argc, argv, "--noise", "0"), nullptr, 10));
+
+        // One second of the signal on A0, a slow full-scale triangle on A1
+        const auto length = static_cast<core::size_t>(host::replay::conversion_rate_hz);
+        source.assign(0, host::replay::synthesize(wave, host::replay::conversion_rate_hz, length));
+        source.assign(1,
+            host::replay::synthesize({ host::replay::shape::triangle, 2.0, 0.5, 2.5, 2.5, 0.0, 0 },
+                host::replay::conversion_rate_hz, length));
+    }
+
+    if (!flag(argc, argv, "--binary")) {
+        return run<core::output::mode::csv, core::frame::encoding::raw16>(config, source);
+    }
+    const char* encoding = option(argc, argv, "--encoding", "raw16");
+    if (std::strcmp(encoding, "packed10") == 0) {
+        return run<core::output::mode::binary, core::frame::encoding::packed10>(config, source);
+    }
+    if (std::strcmp(encoding, "delta") == 0) {
+        return run<core::output::mode::binary, core::frame::encoding::delta>(config, source);
+    }
+    if (std::strcmp(encoding, "raw16") == 0) {
+        return run<core::output::mode::binary, core::frame::encoding::raw16>(config, source);
+    }
+    return usage();
+}
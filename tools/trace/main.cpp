@@ -0,0 +1,212 @@
+#include <serial.hpp>
+#include <trace.hpp>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Decoder of core::trace dumps.
+//
+//   trace <log|-> [--names a,b,...] [--mhz 16] [--latency from:to]... [--json trace.json]
+//   trace <device> --request [--baud 9600] [...]
+//
+// Reads a serial log (simavr console output, a raw capture of the link) and decodes every dump in it, or
+// sends the dump request byte to a board and waits for one dump. Prints the duration histogram of every
+// traced region and of the requested from:to latencies (ids or names), and writes the Chrome trace JSON
+// (chrome://tracing, ui.perfetto.dev).
+
+namespace {
+
+constexpr char DUMP_REQUEST = 'T';
+constexpr int REQUEST_TIMEOUT_MS = 2000;
+
+const char* option(int argc, char** argv, const char* name, const char* fallback)
+{
+    for (int i = 0; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return argv[i + 1];
+        }
+    }
+    return fallback;
+}
+
+bool flag(int argc, char** argv, const char* name)
+{
+    for (int i = 0; i < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> split(const std::string& text, char separator)
+{
+    std::vector<std::string> fields;
+    std::string::size_type start = 0;
+    while (start <= text.size()) {
+        const auto end = text.find(separator, start);
+        fields.push_back(text.substr(start, end == std::string::npos ? std::string::npos : end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    return fields;
+}
+
+/// @brief Id of a name or decimal id, -1 if unknown
+int resolve(const std::string& text, const std::vector<std::string>& names)
+{
+    for (std::size_t id = 0; id < names.size(); ++id) {
+        if (names[id] == text) {
+            return static_cast<int>(id);
+        }
+    }
+    char* end = nullptr;
+    const long id = std::strtol(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0' && id >= 0 && id <= core::trace::max_id ? static_cast<int>(id) : -1;
+}
+
+std::string label(int id, const std::vector<std::string>& names)
+{
+    return id < static_cast<int>(names.size()) && !names[id].empty() ? names[id] : "id" + std::to_string(id);
+}
+
+void print(const std::string& title, const std::vector<core::uint64_t>& values, double mhz)
+{
+    const auto stats = host::trace::summarize(values);
+    std::printf("%s: count=%zu min=%llu p50=%llu p99=%llu max=%llu mean=%.1f cycles (mean %.2f us)\n", title.c_str(),
+        stats.count, static_cast<unsigned long long>(stats.min), static_cast<unsigned long long>(stats.p50),
+        static_cast<unsigned long long>(stats.p99), static_cast<unsigned long long>(stats.max), stats.mean,
+        stats.mean / mhz);
+    std::fputs(host::trace::histogram(values, mhz).c_str(), stdout);
+}
+
+int usage()
+{
+    std::fputs("usage:\n"
+               "  trace <log|-> [--names a,b,...] [--mhz 16] [--latency from:to]... [--json trace.json]\n"
+               "  trace <device> --request [--baud 9600] [...]\n",
+        stderr);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        return usage();
+    }
+    const char* input = argv[1];
+    const bool request = flag(argc, argv, "--request");
+    const double mhz = std::strtod(option(argc, argv, "--mhz", "16"), nullptr);
+    const auto names = split(option(argc, argv, "--names", ""), ',');
+    const char* json = option(argc, argv, "--json", nullptr);
+    if (mhz <= 0) {
+        return usage();
+    }
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 2; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--latency") != 0) {
+            continue;
+        }
+        const auto ends = split(argv[i + 1], ':');
+        const int from = ends.size() == 2 ? resolve(ends[0], names) : -1;
+        const int to = ends.size() == 2 ? resolve(ends[1], names) : -1;
+        if (from < 0 || to < 0) {
+            std::fprintf(stderr, "trace: bad latency %s\n", argv[i + 1]);
+            return usage();
+        }
+        pairs.emplace_back(from, to);
+    }
+
+    int fd = 0;
+    if (request) {
+        const auto baud = static_cast<core::uint32_t>(std::strtoul(option(argc, argv, "--baud", "9600"), nullptr, 10));
+        fd = host::serial::open(input, baud, true);
+        const core::uint8_t byte = DUMP_REQUEST;
+        if (fd < 0 || !host::serial::write_all(fd, { &byte, 1 })) {
+            std::fprintf(stderr, "trace: %s: %s\n", input, std::strerror(errno));
+            return 1;
+        }
+    } else if (std::strcmp(input, "-") != 0) {
+        fd = host::serial::open(input, 9600);
+        if (fd < 0) {
+            std::fprintf(stderr, "trace: %s: %s\n", input, std::strerror(errno));
+            return 1;
+        }
+    }
+
+    host::trace::parser parser;
+    std::vector<host::trace::dump> dumps;
+    core::uint8_t buffer[4096];
+    for (;;) {
+        pollfd ready { fd, POLLIN, 0 };
+        if (::poll(&ready, 1, request ? REQUEST_TIMEOUT_MS : -1) == 0) {
+            break; // the board stopped talking
+        }
+        const ssize_t size = ::read(fd, buffer, sizeof(buffer));
+        if (size < 0 && (errno == EAGAIN || errno == EINTR)) {
+            continue;
+        }
+        if (size <= 0) {
+            break;
+        }
+        parser.feed({ buffer, static_cast<core::size_t>(size) },
+            [&dumps](const host::trace::dump& item) { dumps.push_back(item); });
+        if (request && !dumps.empty()) {
+            break;
+        }
+    }
+    if (fd > 0) {
+        ::close(fd);
+    }
+
+    const auto& stats = parser.stats();
+    std::printf("dumps=%zu chunks=%llu crc_errors=%llu incomplete=%llu\n", dumps.size(),
+        static_cast<unsigned long long>(stats.chunks), static_cast<unsigned long long>(stats.crc_errors),
+        static_cast<unsigned long long>(stats.incomplete));
+
+    // Regions and latencies are matched within each dump, the stamps of different dumps are unrelated
+    for (int id = 0; id <= core::trace::max_id; ++id) {
+        std::vector<core::uint64_t> values;
+        for (const auto& item : dumps) {
+            const auto found = host::trace::durations(item.events, static_cast<core::uint8_t>(id));
+            values.insert(values.end(), found.begin(), found.end());
+        }
+        if (!values.empty()) {
+            print(label(id, names), values, mhz);
+        }
+    }
+    for (const auto& [from, to] : pairs) {
+        std::vector<core::uint64_t> values;
+        for (const auto& item : dumps) {
+            const auto found = host::trace::latencies(
+                item.events, static_cast<core::uint8_t>(from), static_cast<core::uint8_t>(to));
+            values.insert(values.end(), found.begin(), found.end());
+        }
+        print(label(from, names) + " -> " + label(to, names), values, mhz);
+    }
+
+    if (json != nullptr) {
+        FILE* out = std::fopen(json, "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "trace: %s: %s\n", json, std::strerror(errno));
+            return 1;
+        }
+        std::fputs(host::trace::chrome_json(dumps, names, mhz).c_str(), out);
+        std::fclose(out);
+        std::printf("Chrome trace written to %s\n", json);
+    }
+    return dumps.empty() ? 1 : 0;
+}